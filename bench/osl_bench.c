@@ -0,0 +1,372 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               osl_bench.c                                **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <osl/macros.h>
+#include <osl/interface.h>
+#include <osl/relation.h>
+#include <osl/relation_list.h>
+#include <osl/scop.h>
+#include <osl/statement.h>
+
+#include "synthetic.h"
+
+#define OSL_BENCH_JSON 0
+#define OSL_BENCH_CSV 1
+
+/**
+ * The osl_bench structure stores the configuration of a benchmark run.
+ */
+struct osl_bench {
+  osl_synthetic synthetic; /**< Synthetic scop description */
+  int nb_repeats;          /**< Number of timed repetitions */
+  int format;              /**< OSL_BENCH_JSON or OSL_BENCH_CSV */
+};
+typedef struct osl_bench osl_bench;
+
+/**
+ * osl_bench_now function:
+ * this function returns a monotonic time in seconds.
+ */
+static double osl_bench_now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+/**
+ * osl_bench_report function:
+ * this function prints the result of one timed operation, as a JSON object
+ * on a single line or as a CSV line.
+ */
+static void osl_bench_report(const osl_bench* const bench,
+                             const char* const operation,
+                             const double* const times, const size_t bytes) {
+  double min = times[0];
+  double total = 0.;
+  for (int r = 0; r < bench->nb_repeats; r++) {
+    if (times[r] < min)
+      min = times[r];
+    total += times[r];
+  }
+  const double mean = total / bench->nb_repeats;
+  const osl_synthetic* const s = &bench->synthetic;
+
+  if (bench->format == OSL_BENCH_CSV) {
+    printf("%s,%s,%d,%d,%d,%d,%d,%d,%s,%d,%zu,%.9f,%.9f\n", operation,
+           osl_synthetic_pattern_string(s->pattern), s->nb_statements,
+           s->depth, s->nb_accesses, s->nb_unions, s->nb_dependences,
+           s->precision, osl_synthetic_extensions_string(s->extensions),
+           bench->nb_repeats, bytes, min, mean);
+  } else {
+    printf("{\"operation\": \"%s\", \"pattern\": \"%s\", "
+           "\"statements\": %d, \"depth\": %d, \"accesses\": %d, "
+           "\"unions\": %d, \"dependences\": %d, \"precision\": %d, "
+           "\"extensions\": \"%s\", \"repeats\": %d, \"bytes\": %zu, "
+           "\"min_seconds\": %.9f, \"mean_seconds\": %.9f}\n",
+           operation, osl_synthetic_pattern_string(s->pattern),
+           s->nb_statements, s->depth, s->nb_accesses, s->nb_unions,
+           s->nb_dependences, s->precision,
+           osl_synthetic_extensions_string(s->extensions), bench->nb_repeats,
+           bytes, min, mean);
+  }
+  fflush(stdout);
+}
+
+/**
+ * osl_bench_set_precision function:
+ * this function converts every relation of the statements of a scop to a
+ * given precision.
+ */
+static void osl_bench_set_precision(const int precision,
+                                    osl_scop* const scop) {
+  osl_relation_set_precision(precision, scop->context);
+  for (osl_statement* s = scop->statement; s; s = s->next) {
+    osl_relation_set_precision(precision, s->domain);
+    osl_relation_set_precision(precision, s->scattering);
+    for (osl_relation_list* l = s->access; l; l = l->next)
+      osl_relation_set_precision(precision, l->elt);
+  }
+}
+
+/**
+ * osl_bench_run function:
+ * this function generates the synthetic scop of a benchmark configuration,
+ * then times and reports each operation.
+ * \return 0 on success, 1 if the generated scop could not be processed.
+ */
+static int osl_bench_run(const osl_bench* const bench) {
+  const int nb_repeats = bench->nb_repeats;
+  double* times = malloc((size_t)nb_repeats * sizeof(double));
+  FILE* const input = tmpfile();
+  FILE* const output = tmpfile();
+  osl_interface* const registry = osl_interface_get_default_registry();
+  osl_scop* scop = NULL;
+  double start;
+
+  if (!times || !input || !output) {
+    fprintf(stderr, "[osl_bench] cannot allocate the benchmark buffers\n");
+    exit(1);
+  }
+
+  osl_synthetic_print(input, &bench->synthetic);
+  const size_t bytes = (size_t)ftell(input);
+
+  // Read.
+  for (int r = 0; r < nb_repeats; r++) {
+    osl_scop_free(scop);
+    rewind(input);
+    start = osl_bench_now();
+    scop = osl_scop_pread(input, registry, bench->synthetic.precision);
+    times[r] = osl_bench_now() - start;
+  }
+  if (!scop) {
+    fprintf(stderr, "[osl_bench] the synthetic scop cannot be read\n");
+    free(times);
+    return 1;
+  }
+  osl_bench_report(bench, "read", times, bytes);
+
+  // Print.
+  size_t printed = 0;
+  for (int r = 0; r < nb_repeats; r++) {
+    rewind(output);
+    start = osl_bench_now();
+    osl_scop_print(output, scop);
+    times[r] = osl_bench_now() - start;
+    printed = (size_t)ftell(output);
+  }
+  osl_bench_report(bench, "print", times, printed);
+
+  // Clone.
+  osl_scop* clone = NULL;
+  for (int r = 0; r < nb_repeats; r++) {
+    osl_scop_free(clone);
+    start = osl_bench_now();
+    clone = osl_scop_clone(scop);
+    times[r] = osl_bench_now() - start;
+  }
+  osl_bench_report(bench, "clone", times, 0);
+
+  // Equal (with a distinct but identical scop, so everything is compared).
+  int equal = 1;
+  for (int r = 0; r < nb_repeats; r++) {
+    start = osl_bench_now();
+    equal = osl_scop_equal(scop, clone);
+    times[r] = osl_bench_now() - start;
+  }
+  osl_bench_report(bench, "equal", times, 0);
+  if (!equal)
+    fprintf(stderr, "[osl_bench] a scop and its clone are not equal\n");
+
+  // Remove unions.
+  for (int r = 0; r < nb_repeats; r++) {
+    start = osl_bench_now();
+    osl_scop* const no_union = osl_scop_remove_unions(scop);
+    times[r] = osl_bench_now() - start;
+    osl_scop_free(no_union);
+  }
+  osl_bench_report(bench, "remove_unions", times, 0);
+
+  // Normalize scattering (on a fresh clone each time).
+  for (int r = 0; r < nb_repeats; r++) {
+    osl_scop* const copy = osl_scop_clone(scop);
+    start = osl_bench_now();
+    osl_scop_normalize_scattering(copy);
+    times[r] = osl_bench_now() - start;
+    osl_scop_free(copy);
+  }
+  osl_bench_report(bench, "normalize_scattering", times, 0);
+
+  // Set precision (on a fresh clone each time).
+  const int target = (bench->synthetic.precision == OSL_PRECISION_DP) ? OSL_PRECISION_SP
+                                                            : OSL_PRECISION_DP;
+  for (int r = 0; r < nb_repeats; r++) {
+    osl_scop* const copy = osl_scop_clone(scop);
+    start = osl_bench_now();
+    osl_bench_set_precision(target, copy);
+    times[r] = osl_bench_now() - start;
+    osl_scop_free(copy);
+  }
+  osl_bench_report(bench, "set_precision", times, 0);
+
+  osl_scop_free(clone);
+  osl_scop_free(scop);
+  osl_interface_free(registry);
+  fclose(input);
+  fclose(output);
+  free(times);
+  return !equal;
+}
+
+/**
+ * osl_bench_usage function:
+ * this function prints the command line options and exits.
+ */
+static void osl_bench_usage(const int status) {
+  FILE* const file = status ? stderr : stdout;
+
+  fprintf(file,
+          "usage: osl_bench [options]\n"
+          "Times the OpenScop Library on synthetic scops. Without scop\n"
+          "options, a default set of configurations is run.\n");
+  osl_synthetic_usage(file);
+  fprintf(file,
+          "  -r, --repeat N       number of timed repetitions (default 3)\n"
+          "  -f, --format F       json (one object per line) or csv\n"
+          "  -h, --help           print this help\n");
+  exit(status);
+}
+
+int main(int argc, char* argv[]) {
+  osl_bench bench;
+  int custom = 0; // 1 if a scop option is given, 0 otherwise.
+  int status = 0;
+
+  osl_synthetic_init(&bench.synthetic);
+  bench.nb_repeats = 3;
+  bench.format = OSL_BENCH_JSON;
+
+  // Process the command line information
+  for (int i = 1; i < argc; i++) {
+    const char* const option = argv[i];
+    const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if (!strcmp(option, "-h") || !strcmp(option, "--help")) {
+      osl_bench_usage(0);
+    } else if (osl_synthetic_option(&bench.synthetic, option, value)) {
+      custom = 1;
+    } else if ((!strcmp(option, "-r") || !strcmp(option, "--repeat")) &&
+               value && (atoi(value) > 0)) {
+      bench.nb_repeats = atoi(value);
+    } else if ((!strcmp(option, "-f") || !strcmp(option, "--format")) &&
+               value && !strcmp(value, "json")) {
+      bench.format = OSL_BENCH_JSON;
+    } else if ((!strcmp(option, "-f") || !strcmp(option, "--format")) &&
+               value && !strcmp(value, "csv")) {
+      bench.format = OSL_BENCH_CSV;
+    } else {
+      osl_bench_usage(1);
+    }
+    i++;
+  }
+
+  if (bench.format == OSL_BENCH_CSV)
+    printf("operation,pattern,statements,depth,accesses,unions,dependences,"
+           "precision,extensions,repeats,bytes,min_seconds,mean_seconds\n");
+
+  if (custom)
+    return osl_bench_run(&bench);
+
+  // Default configurations: scale each parameter from the default scop.
+  const osl_synthetic reference = bench.synthetic;
+  const int statements[] = {10, 100, 1000};
+  const int depths[] = {1, 6};
+  const int accesses[] = {10};
+  const int unions[] = {4};
+  const int extensions[] = {OSL_SYNTHETIC_DEPENDENCE | OSL_SYNTHETIC_SYMBOLS |
+                            OSL_SYNTHETIC_LOOP};
+  const int patterns[] = {OSL_SYNTHETIC_STENCIL, OSL_SYNTHETIC_MATMUL,
+                          OSL_SYNTHETIC_DEEP};
+  const int dependences[] = {1000};
+
+  for (size_t i = 0; i < sizeof(statements) / sizeof(int); i++) {
+    bench.synthetic = reference;
+    bench.synthetic.nb_statements = statements[i];
+    status |= osl_bench_run(&bench);
+  }
+  for (size_t i = 0; i < sizeof(depths) / sizeof(int); i++) {
+    bench.synthetic = reference;
+    bench.synthetic.depth = depths[i];
+    status |= osl_bench_run(&bench);
+  }
+  for (size_t i = 0; i < sizeof(accesses) / sizeof(int); i++) {
+    bench.synthetic = reference;
+    bench.synthetic.nb_accesses = accesses[i];
+    status |= osl_bench_run(&bench);
+  }
+  for (size_t i = 0; i < sizeof(unions) / sizeof(int); i++) {
+    bench.synthetic = reference;
+    bench.synthetic.nb_unions = unions[i];
+    status |= osl_bench_run(&bench);
+  }
+  for (size_t i = 0; i < sizeof(extensions) / sizeof(int); i++) {
+    bench.synthetic = reference;
+    bench.synthetic.extensions = extensions[i];
+    status |= osl_bench_run(&bench);
+  }
+  for (size_t i = 0; i < sizeof(patterns) / sizeof(int); i++) {
+    bench.synthetic = reference;
+    bench.synthetic.pattern = patterns[i];
+    status |= osl_bench_run(&bench);
+  }
+  for (size_t i = 0; i < sizeof(dependences) / sizeof(int); i++) {
+    bench.synthetic = reference;
+    bench.synthetic.nb_dependences = dependences[i];
+    bench.synthetic.extensions = OSL_SYNTHETIC_DEPENDENCE;
+    status |= osl_bench_run(&bench);
+  }
+
+  return status;
+}
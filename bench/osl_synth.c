@@ -0,0 +1,120 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               osl_synth.c                                **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/scop.h>
+
+#include "synthetic.h"
+
+/**
+ * osl_synth_usage function:
+ * this function prints the command line options and exits.
+ */
+static void osl_synth_usage(const int status) {
+  FILE* const file = status ? stderr : stdout;
+
+  fprintf(file,
+          "usage: osl_synth [options]\n"
+          "Generates a synthetic OpenScop file.\n");
+  osl_synthetic_usage(file);
+  fprintf(file,
+          "  -o, --output FILE    output file (default: standard output)\n"
+          "  -h, --help           print this help\n");
+  exit(status);
+}
+
+int main(int argc, char* argv[]) {
+  osl_synthetic synthetic;
+  const char* output = NULL; // Output file name (NULL for stdout).
+
+  osl_synthetic_init(&synthetic);
+
+  // Process the command line information
+  for (int i = 1; i < argc; i++) {
+    const char* const option = argv[i];
+    const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if (!strcmp(option, "-h") || !strcmp(option, "--help"))
+      osl_synth_usage(0);
+    else if ((!strcmp(option, "-o") || !strcmp(option, "--output")) && value)
+      output = value;
+    else if (!osl_synthetic_option(&synthetic, option, value))
+      osl_synth_usage(1);
+    i++;
+  }
+
+  FILE* const file = output ? fopen(output, "w") : stdout;
+  if (!file) {
+    fprintf(stderr, "[osl_synth] cannot open %s\n", output);
+    return 1;
+  }
+
+  fprintf(file, "# Synthetic %s scop: %d statements, depth %d, %d unions\n\n",
+          osl_synthetic_pattern_string(synthetic.pattern),
+          synthetic.nb_statements, synthetic.depth, synthetic.nb_unions);
+  osl_synthetic_print(file, &synthetic);
+
+  if (output)
+    fclose(file);
+  return 0;
+}
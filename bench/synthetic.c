@@ -0,0 +1,837 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               synthetic.c                                **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/body.h>
+#include <osl/extensions/dependence.h>
+#include <osl/extensions/loop.h>
+#include <osl/extensions/null.h>
+#include <osl/extensions/symbols.h>
+#include <osl/generic.h>
+#include <osl/int.h>
+#include <osl/interface.h>
+#include <osl/macros.h>
+#include <osl/relation.h>
+#include <osl/relation_list.h>
+#include <osl/scop.h>
+#include <osl/statement.h>
+#include <osl/strings.h>
+#include <osl/util.h>
+
+#include "synthetic.h"
+
+/**
+ * The osl_synthetic_access structure describes an array access: the
+ * subscript of each array dimension is iterator[i] + offset[i], or
+ * offset[i] alone if iterator[i] is negative.
+ */
+struct osl_synthetic_access {
+  int type;    /**< OSL_TYPE_READ or OSL_TYPE_WRITE */
+  int array;   /**< Array identifier (>= 1) */
+  int nb_dims; /**< Number of array dimensions */
+  int iterator[OSL_SYNTHETIC_MAX_DEPTH];
+  int offset[OSL_SYNTHETIC_MAX_DEPTH];
+};
+typedef struct osl_synthetic_access osl_synthetic_access;
+
+/**
+ * The osl_synthetic_statement structure describes a statement: its loop
+ * depth, the constant dimensions of its 2d+1 scattering and its accesses.
+ */
+struct osl_synthetic_statement {
+  int depth;
+  int beta[OSL_SYNTHETIC_MAX_DEPTH + 1];
+  int nb_accesses;
+  osl_synthetic_access* access;
+};
+typedef struct osl_synthetic_statement osl_synthetic_statement;
+
+/******************************************************************************
+ *                            Description functions                           *
+ ******************************************************************************/
+
+/**
+ * osl_synthetic_init function:
+ * this function sets the fields of a synthetic scop description to their
+ * default values (a small generic scop with no extension).
+ * \param[out] synthetic The description to initialize.
+ */
+void osl_synthetic_init(osl_synthetic* const synthetic) {
+  synthetic->pattern = OSL_SYNTHETIC_GENERIC;
+  synthetic->nb_statements = 10;
+  synthetic->depth = 3;
+  synthetic->nb_accesses = 3;
+  synthetic->nb_unions = 1;
+  synthetic->nb_dependences = 0;
+  synthetic->precision = OSL_PRECISION_DP;
+  synthetic->extensions = 0;
+}
+
+/**
+ * osl_synthetic_pattern_string function:
+ * this function returns the name of a synthetic scop pattern.
+ */
+const char* osl_synthetic_pattern_string(const int pattern) {
+  switch (pattern) {
+    case OSL_SYNTHETIC_STENCIL:
+      return "stencil";
+    case OSL_SYNTHETIC_MATMUL:
+      return "matmul";
+    case OSL_SYNTHETIC_DEEP:
+      return "deep";
+    default:
+      return "generic";
+  }
+}
+
+/**
+ * osl_synthetic_extensions_string function:
+ * this function returns a (static) textual form of extension flags.
+ */
+const char* osl_synthetic_extensions_string(const int extensions) {
+  static const char* const strings[] = {"none",
+                                        "dependence",
+                                        "symbols",
+                                        "dependence+symbols",
+                                        "loop",
+                                        "dependence+loop",
+                                        "symbols+loop",
+                                        "dependence+symbols+loop"};
+  return strings[extensions & 7];
+}
+
+/**
+ * osl_synthetic_int_option function:
+ * this function returns the positive integer value of an option or exits
+ * if the value is invalid.
+ */
+static int osl_synthetic_int_option(const char* const option,
+                                    const char* const value, const int max) {
+  char* end;
+  const long result = value ? strtol(value, &end, 10) : 0;
+
+  if (!value || *end || (result < 1) || (result > max)) {
+    fprintf(stderr, "[osl_synthetic] invalid value for %s (1 to %d)\n",
+            option, max);
+    exit(1);
+  }
+  return (int)result;
+}
+
+/**
+ * osl_synthetic_extensions_option function:
+ * this function returns the extension flags of an extension list ("none",
+ * "all" or a comma-separated list) or exits if the list is invalid.
+ */
+static int osl_synthetic_extensions_option(const char* const value) {
+  if (value && !strcmp(value, "none"))
+    return 0;
+  if (value && !strcmp(value, "all"))
+    return OSL_SYNTHETIC_DEPENDENCE | OSL_SYNTHETIC_SYMBOLS |
+           OSL_SYNTHETIC_LOOP;
+
+  int extensions = 0;
+  const char* name = value ? value : "";
+  do {
+    const size_t length = strcspn(name, ",");
+    if ((length == 10) && !strncmp(name, "dependence", length))
+      extensions |= OSL_SYNTHETIC_DEPENDENCE;
+    else if ((length == 7) && !strncmp(name, "symbols", length))
+      extensions |= OSL_SYNTHETIC_SYMBOLS;
+    else if ((length == 4) && !strncmp(name, "loop", length))
+      extensions |= OSL_SYNTHETIC_LOOP;
+    else {
+      fprintf(stderr, "[osl_synthetic] invalid extension list\n");
+      exit(1);
+    }
+    name += length;
+  } while (*name++ == ',');
+
+  return extensions;
+}
+
+/**
+ * osl_synthetic_option function:
+ * this function updates a synthetic scop description according to a
+ * command line option and its value. It exits if the value is invalid.
+ * \param[in,out] synthetic The description to update.
+ * \param[in]     option    The option.
+ * \param[in]     value     The option value (NULL if there is none).
+ * \return 1 if the option is a synthetic scop option, 0 otherwise.
+ */
+int osl_synthetic_option(osl_synthetic* const synthetic,
+                         const char* const option, const char* const value) {
+  if (!strcmp(option, "-P") || !strcmp(option, "--pattern")) {
+    int pattern = OSL_SYNTHETIC_GENERIC;
+    while (value && strcmp(value, osl_synthetic_pattern_string(pattern)) &&
+           (pattern <= OSL_SYNTHETIC_DEEP))
+      pattern++;
+    if (!value || (pattern > OSL_SYNTHETIC_DEEP)) {
+      fprintf(stderr, "[osl_synthetic] invalid pattern\n");
+      exit(1);
+    }
+    synthetic->pattern = pattern;
+  } else if (!strcmp(option, "-s") || !strcmp(option, "--statements")) {
+    synthetic->nb_statements = osl_synthetic_int_option(option, value,
+                                                        10000000);
+  } else if (!strcmp(option, "-d") || !strcmp(option, "--depth")) {
+    synthetic->depth = osl_synthetic_int_option(option, value,
+                                                OSL_SYNTHETIC_MAX_DEPTH);
+  } else if (!strcmp(option, "-a") || !strcmp(option, "--accesses")) {
+    synthetic->nb_accesses = osl_synthetic_int_option(option, value, 10000);
+  } else if (!strcmp(option, "-u") || !strcmp(option, "--unions")) {
+    synthetic->nb_unions = osl_synthetic_int_option(option, value, 10000);
+  } else if (!strcmp(option, "-D") || !strcmp(option, "--dependences")) {
+    synthetic->nb_dependences = osl_synthetic_int_option(option, value,
+                                                         100000000);
+    synthetic->extensions |= OSL_SYNTHETIC_DEPENDENCE;
+  } else if (!strcmp(option, "-e") || !strcmp(option, "--extensions")) {
+    synthetic->extensions = osl_synthetic_extensions_option(value);
+  } else if (!strcmp(option, "-p") || !strcmp(option, "--precision")) {
+    if (value && !strcmp(value, "32"))
+      synthetic->precision = OSL_PRECISION_SP;
+    else if (value && !strcmp(value, "64"))
+      synthetic->precision = OSL_PRECISION_DP;
+    else if (value && !strcmp(value, "mp"))
+      synthetic->precision = OSL_PRECISION_MP;
+    else {
+      fprintf(stderr, "[osl_synthetic] invalid precision\n");
+      exit(1);
+    }
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * osl_synthetic_usage function:
+ * this function prints the command line options of synthetic scops.
+ */
+void osl_synthetic_usage(FILE* const file) {
+  fprintf(file,
+          "  -P, --pattern P      generic, stencil, matmul or deep\n"
+          "  -s, --statements N   number of statements\n"
+          "  -d, --depth N        maximum loop depth\n"
+          "  -a, --accesses N     number of accesses per statement\n"
+          "  -u, --unions N       number of union parts per domain\n"
+          "  -D, --dependences N  number of dependences (enables them)\n"
+          "  -p, --precision P    32, 64 or mp (default 64)\n"
+          "  -e, --extensions E   none, all or a comma-separated list of\n"
+          "                       dependence, symbols and loop\n");
+}
+
+/**
+ * osl_synthetic_nb_parameters function:
+ * this function returns the number of parameters of a synthetic scop (N,
+ * plus T for the number of time steps of stencils).
+ */
+static int osl_synthetic_nb_parameters(const osl_synthetic* const synthetic) {
+  return (synthetic->pattern == OSL_SYNTHETIC_STENCIL) ? 2 : 1;
+}
+
+/**
+ * osl_synthetic_set_access function:
+ * this function sets an access to array[i_0 + offset][i_1]...[i_{d-1}].
+ */
+static void osl_synthetic_set_access(osl_synthetic_access* const access,
+                                     const int type, const int array,
+                                     const int nb_dims, const int first,
+                                     const int offset) {
+  access->type = type;
+  access->array = array;
+  access->nb_dims = nb_dims;
+  for (int i = 0; i < nb_dims; i++) {
+    access->iterator[i] = first + i;
+    access->offset[i] = (i == 0) ? offset : 0;
+  }
+}
+
+/**
+ * osl_synthetic_describe function:
+ * this function fills the description of the statement number "number"
+ * (starting from 0) of a synthetic scop according to its pattern. The
+ * accesses have to be freed by the caller.
+ */
+static void osl_synthetic_describe(const osl_synthetic* const synthetic,
+                                   const int number,
+                                   osl_synthetic_statement* const statement) {
+  const int depth = synthetic->depth;
+  osl_synthetic_access* access;
+
+  memset(statement->beta, 0, sizeof(statement->beta));
+  switch (synthetic->pattern) {
+    case OSL_SYNTHETIC_STENCIL: {
+      // for (t) { ... A_{k+2}[i] = A_{k+1}[i] + A_{k+1}[i-1] + ... }
+      const int space = (depth > 1) ? depth - 1 : 1;
+      statement->depth = space + 1;
+      statement->beta[1] = number;
+      statement->nb_accesses = 2 + 2 * space;
+      access = malloc((size_t)statement->nb_accesses * sizeof(*access));
+      osl_synthetic_set_access(&access[0], OSL_TYPE_WRITE, number + 2, space,
+                               1, 0);
+      osl_synthetic_set_access(&access[1], OSL_TYPE_READ, number + 1, space,
+                               1, 0);
+      for (int i = 0; i < space; i++) {
+        for (int side = 0; side < 2; side++) {
+          osl_synthetic_access* const neighbor = &access[2 + 2 * i + side];
+          osl_synthetic_set_access(neighbor, OSL_TYPE_READ, number + 1, space,
+                                   1, 0);
+          neighbor->offset[i] = side ? 1 : -1;
+        }
+      }
+      break;
+    }
+    case OSL_SYNTHETIC_MATMUL: {
+      // C[i][j] = 0; then C[i][j] = C[i][j] + A[i][k] * B[k][j];
+      const int c = 3 * (number / 2) + 1;
+      statement->beta[0] = number / 2;
+      if (number % 2 == 0) {
+        statement->depth = 2;
+        statement->nb_accesses = 1;
+      } else {
+        statement->depth = 3;
+        statement->beta[2] = 1;
+        statement->nb_accesses = 4;
+      }
+      access = malloc((size_t)statement->nb_accesses * sizeof(*access));
+      osl_synthetic_set_access(&access[0], OSL_TYPE_WRITE, c, 2, 0, 0);
+      if (number % 2) {
+        osl_synthetic_set_access(&access[1], OSL_TYPE_READ, c, 2, 0, 0);
+        osl_synthetic_set_access(&access[2], OSL_TYPE_READ, c + 1, 2, 0, 0);
+        access[2].iterator[1] = 2;
+        osl_synthetic_set_access(&access[3], OSL_TYPE_READ, c + 2, 2, 0, 0);
+        access[3].iterator[0] = 2;
+      }
+      break;
+    }
+    default: {
+      // Generic: separate nests; deep: one nest, statement k at level k%d.
+      if (synthetic->pattern == OSL_SYNTHETIC_DEEP) {
+        statement->depth = 1 + number % depth;
+        statement->beta[statement->depth] = number;
+      } else {
+        statement->depth = ((depth > 1) && (number % 2)) ? depth - 1 : depth;
+        statement->beta[0] = number;
+      }
+      statement->nb_accesses = synthetic->nb_accesses;
+      access = malloc((size_t)statement->nb_accesses * sizeof(*access));
+      for (int a = 0; a < statement->nb_accesses; a++)
+        osl_synthetic_set_access(&access[a],
+                                 a ? OSL_TYPE_READ : OSL_TYPE_WRITE,
+                                 1 + (number + a) % synthetic->nb_accesses,
+                                 statement->depth, 0, a);
+      break;
+    }
+  }
+
+  if (!access) {
+    fprintf(stderr, "[osl_synthetic] memory overflow\n");
+    exit(1);
+  }
+  statement->access = access;
+}
+
+/******************************************************************************
+ *                          Structure building functions                      *
+ ******************************************************************************/
+
+/**
+ * osl_synthetic_relation function:
+ * this function allocates a relation with all its attributes set.
+ */
+static osl_relation* osl_synthetic_relation(const osl_synthetic* const s,
+                                            const int type, const int nb_rows,
+                                            const int nb_output_dims,
+                                            const int nb_input_dims) {
+  const int nb_parameters = osl_synthetic_nb_parameters(s);
+  osl_relation* const relation = osl_relation_pmalloc(
+      s->precision, nb_rows, nb_output_dims + nb_input_dims + nb_parameters + 2);
+  relation->type = type;
+  relation->nb_output_dims = nb_output_dims;
+  relation->nb_input_dims = nb_input_dims;
+  relation->nb_local_dims = 0;
+  relation->nb_parameters = nb_parameters;
+  return relation;
+}
+
+/**
+ * osl_synthetic_set function:
+ * this function sets an element of a relation.
+ */
+static void osl_synthetic_set(osl_relation* const relation, const int row,
+                              const int column, const int value) {
+  osl_int_set_si(relation->precision, &relation->m[row][column], value);
+}
+
+/**
+ * osl_synthetic_bounds function:
+ * this function sets the bounds of the dimension "dim" in the rows "row"
+ * and "row + 1" of a relation. The dimension goes from its lower bound
+ * (plus shift) to its upper bound (a parameter minus a margin).
+ */
+static void osl_synthetic_bounds(const osl_synthetic* const s,
+                                 osl_relation* const relation, const int row,
+                                 const int column, const int level,
+                                 const int shift) {
+  int lower = 0;
+  int parameter = 0;
+  int margin = 0;
+  if (s->pattern == OSL_SYNTHETIC_STENCIL) {
+    // t in [0, T-1], space dimensions in [1, N-2].
+    lower = (level == 0) ? 0 : 1;
+    parameter = (level == 0) ? 1 : 0;
+    margin = (level == 0) ? 0 : 1;
+  }
+
+  const int first_parameter = relation->nb_columns - 1 - relation->nb_parameters;
+  osl_synthetic_set(relation, row, 0, 1);
+  osl_synthetic_set(relation, row, column, 1);
+  osl_synthetic_set(relation, row, relation->nb_columns - 1, -(lower + shift));
+  osl_synthetic_set(relation, row + 1, 0, 1);
+  osl_synthetic_set(relation, row + 1, column, -1);
+  osl_synthetic_set(relation, row + 1, first_parameter + parameter, 1);
+  osl_synthetic_set(relation, row + 1, relation->nb_columns - 1, -1 - margin);
+}
+
+/**
+ * osl_synthetic_domain function:
+ * this function builds the domain of a statement, with one union part per
+ * shift of the lower bound of the outermost loop.
+ */
+static osl_relation* osl_synthetic_domain(
+    const osl_synthetic* const s, const osl_synthetic_statement* const stmt) {
+  osl_relation* domain = NULL;
+
+  for (int part = s->nb_unions - 1; part >= 0; part--) {
+    osl_relation* const relation = osl_synthetic_relation(
+        s, OSL_TYPE_DOMAIN, 2 * stmt->depth, stmt->depth, 0);
+    for (int l = 0; l < stmt->depth; l++)
+      osl_synthetic_bounds(s, relation, 2 * l, 1 + l, l, (l == 0) ? part : 0);
+    relation->next = domain;
+    domain = relation;
+  }
+  return domain;
+}
+
+/**
+ * osl_synthetic_scattering function:
+ * this function builds the 2d+1 scattering of a statement.
+ */
+static osl_relation* osl_synthetic_scattering(
+    const osl_synthetic* const s, const osl_synthetic_statement* const stmt) {
+  const int nb_output_dims = 2 * stmt->depth + 1;
+  osl_relation* const relation = osl_synthetic_relation(
+      s, OSL_TYPE_SCATTERING, nb_output_dims, nb_output_dims, stmt->depth);
+
+  for (int r = 0; r < nb_output_dims; r++) {
+    osl_synthetic_set(relation, r, 1 + r, -1);
+    if (r % 2)
+      osl_synthetic_set(relation, r, 1 + nb_output_dims + r / 2, 1);
+    else
+      osl_synthetic_set(relation, r, relation->nb_columns - 1,
+                        stmt->beta[r / 2]);
+  }
+  return relation;
+}
+
+/**
+ * osl_synthetic_access_list function:
+ * this function builds the access relation list of a statement.
+ */
+static osl_relation_list* osl_synthetic_access_list(
+    const osl_synthetic* const s, const osl_synthetic_statement* const stmt) {
+  osl_relation_list* list = NULL;
+
+  for (int a = stmt->nb_accesses - 1; a >= 0; a--) {
+    const osl_synthetic_access* const access = &stmt->access[a];
+    osl_relation* const relation =
+        osl_synthetic_relation(s, access->type, access->nb_dims + 1,
+                               access->nb_dims + 1, stmt->depth);
+    osl_synthetic_set(relation, 0, 1, -1);
+    osl_synthetic_set(relation, 0, relation->nb_columns - 1, access->array);
+    for (int i = 0; i < access->nb_dims; i++) {
+      osl_synthetic_set(relation, i + 1, i + 2, -1);
+      if (access->iterator[i] >= 0)
+        osl_synthetic_set(relation, i + 1,
+                          access->nb_dims + 2 + access->iterator[i], 1);
+      osl_synthetic_set(relation, i + 1, relation->nb_columns - 1,
+                        access->offset[i]);
+    }
+
+    osl_relation_list* const node = osl_relation_list_malloc();
+    node->elt = relation;
+    node->next = list;
+    list = node;
+  }
+  return list;
+}
+
+/**
+ * osl_synthetic_body function:
+ * this function builds the body of a statement, consistent with its
+ * accesses: the write access is assigned the sum of the read accesses.
+ */
+static osl_body* osl_synthetic_body(const osl_synthetic_statement* const stmt) {
+  size_t high_water_mark = OSL_MAX_STRING;
+  char buffer[OSL_MAX_STRING];
+  char* expression;
+
+  osl_body* const body = osl_body_malloc();
+  body->iterators = osl_strings_malloc();
+  for (int l = 0; l < stmt->depth; l++) {
+    snprintf(buffer, sizeof(buffer), "i%d", l);
+    osl_strings_add(body->iterators, buffer);
+  }
+
+  OSL_malloc(expression, char*, high_water_mark * sizeof(char));
+  expression[0] = '\0';
+  for (int a = 0; a < stmt->nb_accesses; a++) {
+    const osl_synthetic_access* const access = &stmt->access[a];
+    if (a > 0)
+      osl_util_safe_strcat(&expression, (a == 1) ? " = " : " + ",
+                           &high_water_mark);
+    snprintf(buffer, sizeof(buffer), "A%d", access->array);
+    osl_util_safe_strcat(&expression, buffer, &high_water_mark);
+    for (int i = 0; i < access->nb_dims; i++) {
+      if (access->iterator[i] < 0)
+        snprintf(buffer, sizeof(buffer), "[%d]", access->offset[i]);
+      else if (access->offset[i])
+        snprintf(buffer, sizeof(buffer), "[i%d%+d]", access->iterator[i],
+                 access->offset[i]);
+      else
+        snprintf(buffer, sizeof(buffer), "[i%d]", access->iterator[i]);
+      osl_util_safe_strcat(&expression, buffer, &high_water_mark);
+    }
+  }
+  osl_util_safe_strcat(&expression, (stmt->nb_accesses > 1) ? ";" : " = 0;",
+                       &high_water_mark);
+  body->expression = osl_strings_encapsulate(expression);
+
+  return body;
+}
+
+/**
+ * osl_synthetic_common_depth function:
+ * this function returns the number of loops shared by two statements.
+ */
+static int osl_synthetic_common_depth(const osl_synthetic_statement* const s1,
+                                      const osl_synthetic_statement* const s2) {
+  int depth = 0;
+  while ((depth < s1->depth) && (depth < s2->depth) &&
+         (s1->beta[depth] == s2->beta[depth]))
+    depth++;
+  return depth;
+}
+
+/**
+ * osl_synthetic_dependences function:
+ * this function builds a dependence list cycling over the self dependences
+ * of the statements and the dependences between consecutive statements.
+ * The dependence types change at each cycle.
+ */
+static osl_dependence* osl_synthetic_dependences(
+    const osl_synthetic* const s, const osl_synthetic_statement* const stmts) {
+  static const int types[] = {OSL_DEPENDENCE_RAW, OSL_DEPENDENCE_WAR,
+                              OSL_DEPENDENCE_WAW, OSL_DEPENDENCE_RAR};
+  const int nb_pairs = 2 * s->nb_statements - 1;
+  const int nb_dependences = s->nb_dependences ? s->nb_dependences : nb_pairs;
+  osl_dependence* head = NULL;
+  osl_dependence* tail = NULL;
+
+  for (int d = 0; d < nb_dependences; d++) {
+    const int pair = d % nb_pairs;
+    const int source = pair / 2;
+    const int target = source + pair % 2;
+    const osl_synthetic_statement* const src = &stmts[source];
+    const osl_synthetic_statement* const tgt = &stmts[target];
+    const int depth = osl_synthetic_common_depth(src, tgt);
+
+    osl_dependence* const dependence = osl_dependence_malloc();
+    dependence->type = types[(d / nb_pairs) % 4];
+    dependence->label_source = source + 1;
+    dependence->label_target = target + 1;
+    dependence->depth = depth;
+    dependence->ref_source = 0;
+    dependence->ref_target = (tgt->nb_accesses > 1) ? 1 : 0;
+
+    // Iteration domains of the source and target, same shared iterators.
+    osl_relation* const domain = osl_synthetic_relation(
+        s, OSL_UNDEFINED, 2 * src->depth + 2 * tgt->depth + depth,
+        src->depth, tgt->depth);
+    for (int l = 0; l < src->depth; l++)
+      osl_synthetic_bounds(s, domain, 2 * l, 1 + l, l, 0);
+    for (int l = 0; l < tgt->depth; l++)
+      osl_synthetic_bounds(s, domain, 2 * src->depth + 2 * l,
+                           1 + src->depth + l, l, 0);
+    for (int l = 0; l < depth; l++) {
+      const int row = 2 * src->depth + 2 * tgt->depth + l;
+      osl_synthetic_set(domain, row, 1 + l, -1);
+      osl_synthetic_set(domain, row, 1 + src->depth + l, 1);
+    }
+    dependence->domain = domain;
+
+    if (tail)
+      tail->next = dependence;
+    else
+      head = dependence;
+    tail = dependence;
+  }
+  return head;
+}
+
+/**
+ * osl_synthetic_symbol function:
+ * this function builds one symbol.
+ */
+static osl_symbols* osl_synthetic_symbol(const int type, const int nb_dims,
+                                         const char* const identifier,
+                                         const char* const datatype) {
+  osl_symbols* const symbol = osl_symbols_malloc();
+  symbol->type = type;
+  symbol->generated = 0;
+  symbol->nb_dims = nb_dims;
+  symbol->identifier =
+      osl_generic_shell(osl_strings_encapsulate(osl_util_strdup(identifier)),
+                        osl_strings_interface());
+  symbol->datatype =
+      osl_generic_shell(osl_strings_encapsulate(osl_util_strdup(datatype)),
+                        osl_strings_interface());
+  symbol->scope = osl_generic_shell(osl_null_malloc(), osl_null_interface());
+  symbol->extent = osl_generic_shell(osl_null_malloc(), osl_null_interface());
+  return symbol;
+}
+
+/**
+ * osl_synthetic_symbols function:
+ * this function builds the symbols of a synthetic scop: its parameters,
+ * its iterators and its arrays.
+ */
+static osl_symbols* osl_synthetic_symbols(
+    const osl_synthetic* const s, const osl_synthetic_statement* const stmts) {
+  static const char* const parameters[] = {"N", "T"};
+  char identifier[32];
+  int max_depth = 0;
+  int nb_arrays = 0;
+
+  for (int k = 0; k < s->nb_statements; k++) {
+    if (stmts[k].depth > max_depth)
+      max_depth = stmts[k].depth;
+    for (int a = 0; a < stmts[k].nb_accesses; a++)
+      if (stmts[k].access[a].array > nb_arrays)
+        nb_arrays = stmts[k].access[a].array;
+  }
+
+  int* array_dims = calloc((size_t)nb_arrays + 1, sizeof(int));
+  if (!array_dims) {
+    fprintf(stderr, "[osl_synthetic] memory overflow\n");
+    exit(1);
+  }
+  for (int k = 0; k < s->nb_statements; k++)
+    for (int a = 0; a < stmts[k].nb_accesses; a++)
+      array_dims[stmts[k].access[a].array] = stmts[k].access[a].nb_dims;
+
+  osl_symbols* head = NULL;
+  osl_symbols* tail = NULL;
+  const int nb_parameters = osl_synthetic_nb_parameters(s);
+  const int nb_symbols = nb_parameters + max_depth + nb_arrays;
+  for (int i = 0; i < nb_symbols; i++) {
+    osl_symbols* symbol;
+    if (i < nb_parameters) {
+      symbol = osl_synthetic_symbol(OSL_SYMBOL_TYPE_PARAMETER, 0,
+                                    parameters[i], "int");
+    } else if (i < nb_parameters + max_depth) {
+      snprintf(identifier, sizeof(identifier), "i%d", i - nb_parameters);
+      symbol = osl_synthetic_symbol(OSL_SYMBOL_TYPE_ITERATOR, 0, identifier,
+                                    "int");
+    } else {
+      const int array = i - nb_parameters - max_depth + 1;
+      snprintf(identifier, sizeof(identifier), "A%d", array);
+      symbol = osl_synthetic_symbol(OSL_SYMBOL_TYPE_ARRAY, array_dims[array],
+                                    identifier, "double");
+    }
+    if (tail)
+      tail->next = symbol;
+    else
+      head = symbol;
+    tail = symbol;
+  }
+
+  free(array_dims);
+  return head;
+}
+
+/**
+ * osl_synthetic_loops function:
+ * this function builds the loop extension of a synthetic scop: one loop
+ * per statement and per level, the outermost ones being parallel.
+ */
+static osl_loop* osl_synthetic_loops(const osl_synthetic* const s,
+                                     const osl_synthetic_statement* const
+                                         stmts) {
+  char iterator[32];
+  osl_loop* head = NULL;
+  osl_loop* tail = NULL;
+
+  for (int k = 0; k < s->nb_statements; k++) {
+    for (int l = 0; l < stmts[k].depth; l++) {
+      osl_loop* const loop = osl_loop_malloc();
+      snprintf(iterator, sizeof(iterator), "i%d", l);
+      loop->iter = osl_util_strdup(iterator);
+      loop->nb_stmts = 1;
+      OSL_malloc(loop->stmt_ids, int*, sizeof(int));
+      loop->stmt_ids[0] = k + 1;
+      loop->directive =
+          (l == 0) ? OSL_LOOP_DIRECTIVE_PARALLEL : OSL_LOOP_DIRECTIVE_NONE;
+      if (tail)
+        tail->next = loop;
+      else
+        head = loop;
+      tail = loop;
+    }
+  }
+  return head;
+}
+
+/**
+ * osl_synthetic_scop function:
+ * this function builds a synthetic scop according to its description,
+ * using the OpenScop Library structures only.
+ * \param[in] synthetic The synthetic scop description.
+ * \return The synthetic scop (to be freed with osl_scop_free).
+ */
+osl_scop* osl_synthetic_scop(const osl_synthetic* const synthetic) {
+  static const char* const parameters[] = {"N", "T"};
+  const int nb_parameters = osl_synthetic_nb_parameters(synthetic);
+  osl_synthetic_statement* stmts;
+
+  OSL_malloc(stmts, osl_synthetic_statement*,
+             (size_t)synthetic->nb_statements * sizeof(*stmts));
+  for (int k = 0; k < synthetic->nb_statements; k++)
+    osl_synthetic_describe(synthetic, k, &stmts[k]);
+
+  osl_scop* const scop = osl_scop_malloc();
+  scop->language = osl_util_strdup("C");
+  scop->registry = osl_interface_get_default_registry();
+
+  // Context: every parameter is positive.
+  scop->context = osl_synthetic_relation(synthetic, OSL_TYPE_CONTEXT,
+                                         nb_parameters, 0, 0);
+  osl_strings* const names = osl_strings_malloc();
+  for (int i = 0; i < nb_parameters; i++) {
+    osl_synthetic_set(scop->context, i, 0, 1);
+    osl_synthetic_set(scop->context, i, 1 + i, 1);
+    osl_synthetic_set(scop->context, i, 1 + nb_parameters, -1);
+    osl_strings_add(names, parameters[i]);
+  }
+  scop->parameters = osl_generic_shell(names, osl_strings_interface());
+
+  // Statements.
+  osl_statement* tail = NULL;
+  for (int k = 0; k < synthetic->nb_statements; k++) {
+    osl_statement* const statement = osl_statement_malloc();
+    statement->domain = osl_synthetic_domain(synthetic, &stmts[k]);
+    statement->scattering = osl_synthetic_scattering(synthetic, &stmts[k]);
+    statement->access = osl_synthetic_access_list(synthetic, &stmts[k]);
+    statement->extension = osl_generic_shell(osl_synthetic_body(&stmts[k]),
+                                             osl_body_interface());
+    if (tail)
+      tail->next = statement;
+    else
+      scop->statement = statement;
+    tail = statement;
+  }
+
+  // Extensions.
+  if (synthetic->extensions & OSL_SYNTHETIC_DEPENDENCE)
+    osl_generic_add(&scop->extension,
+                    osl_generic_shell(osl_synthetic_dependences(synthetic, stmts),
+                                      osl_dependence_interface()));
+  if (synthetic->extensions & OSL_SYNTHETIC_SYMBOLS)
+    osl_generic_add(&scop->extension,
+                    osl_generic_shell(osl_synthetic_symbols(synthetic, stmts),
+                                      osl_symbols_interface()));
+  if (synthetic->extensions & OSL_SYNTHETIC_LOOP)
+    osl_generic_add(&scop->extension,
+                    osl_generic_shell(osl_synthetic_loops(synthetic, stmts),
+                                      osl_loop_interface()));
+
+  for (int k = 0; k < synthetic->nb_statements; k++)
+    free(stmts[k].access);
+  free(stmts);
+  return scop;
+}
+
+/**
+ * osl_synthetic_print function:
+ * this function prints a synthetic scop in the OpenScop textual format
+ * according to its description.
+ * \param[in] file      The file where to print the scop.
+ * \param[in] synthetic The synthetic scop description.
+ */
+void osl_synthetic_print(FILE* const file,
+                         const osl_synthetic* const synthetic) {
+  osl_scop* const scop = osl_synthetic_scop(synthetic);
+  osl_scop_print(file, scop);
+  osl_scop_free(scop);
+}
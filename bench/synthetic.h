@@ -0,0 +1,117 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               synthetic.h                                **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef OSL_BENCH_SYNTHETIC_H
+#define OSL_BENCH_SYNTHETIC_H
+
+#include <stdio.h>
+
+#include <osl/scop.h>
+
+#define OSL_SYNTHETIC_GENERIC 0
+#define OSL_SYNTHETIC_STENCIL 1
+#define OSL_SYNTHETIC_MATMUL 2
+#define OSL_SYNTHETIC_DEEP 3
+
+#define OSL_SYNTHETIC_DEPENDENCE 1
+#define OSL_SYNTHETIC_SYMBOLS 2
+#define OSL_SYNTHETIC_LOOP 4
+
+#define OSL_SYNTHETIC_MAX_DEPTH 64
+
+/**
+ * The osl_synthetic structure describes a synthetic scop to generate. The
+ * pattern gives the shape of the statements:
+ * - OSL_SYNTHETIC_GENERIC: independent nests, every other statement being
+ *   one level shallower than depth, with one write and nb_accesses - 1
+ *   shifted reads,
+ * - OSL_SYNTHETIC_STENCIL: Jacobi-like stencils of depth - 1 space
+ *   dimensions sharing a time loop, each statement reading the array
+ *   written by the previous one,
+ * - OSL_SYNTHETIC_MATMUL: pairs of matrix multiplication statements
+ *   (initialization and update), as in test_matmult.scop,
+ * - OSL_SYNTHETIC_DEEP: a single imperfect nest where statements are placed
+ *   at every level up to depth.
+ * Each domain has nb_unions union parts. The extensions field is a
+ * combination of the OSL_SYNTHETIC_* extension flags; nb_dependences is
+ * the number of dependences of the dependence extension (0 for two per
+ * statement).
+ */
+struct osl_synthetic {
+  int pattern;        /**< OSL_SYNTHETIC_* pattern */
+  int nb_statements;  /**< Number of statements */
+  int depth;          /**< Maximum loop depth */
+  int nb_accesses;    /**< Number of accesses per statement (generic, deep) */
+  int nb_unions;      /**< Number of union parts of each domain (>= 1) */
+  int nb_dependences; /**< Number of dependences (0 for the default) */
+  int precision;      /**< Precision of the relations */
+  int extensions;     /**< OSL_SYNTHETIC_* extension flags */
+};
+typedef struct osl_synthetic osl_synthetic;
+
+void osl_synthetic_init(osl_synthetic*);
+int osl_synthetic_option(osl_synthetic*, const char*, const char*);
+void osl_synthetic_usage(FILE*);
+const char* osl_synthetic_pattern_string(int);
+const char* osl_synthetic_extensions_string(int);
+osl_scop* osl_synthetic_scop(const osl_synthetic*);
+void osl_synthetic_print(FILE*, const osl_synthetic*);
+
+#endif /* define OSL_BENCH_SYNTHETIC_H */
@@ -0,0 +1,107 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               allocator.h                                **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef OSL_ALLOCATOR_H
+#define OSL_ALLOCATOR_H
+
+#include <stddef.h>
+
+#include <osl/attributes.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * Allocator functions mirror malloc, realloc and free, with the user pointer
+ * of the allocator as last argument (see osl_allocator_set).
+ */
+typedef void* (*osl_allocator_malloc_f)(size_t, void*);
+typedef void* (*osl_allocator_realloc_f)(void*, size_t, void*);
+typedef void (*osl_allocator_free_f)(void*, void*);
+
+/**
+ * The osl_allocator structure is the table of functions the library uses
+ * for every allocation it makes, including the GMP integers when the
+ * library is built with GMP.
+ */
+struct osl_allocator {
+  osl_allocator_malloc_f malloc;   /**< Allocates a block */
+  osl_allocator_realloc_f realloc; /**< Resizes a block (NULL: new block) */
+  osl_allocator_free_f free;       /**< Frees a block (NULL: nothing) */
+  void* user;                      /**< User pointer passed to the above */
+};
+typedef struct osl_allocator osl_allocator;
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+void osl_allocator_set(const osl_allocator*);
+void osl_allocator_get(osl_allocator*) OSL_NONNULL;
+void* osl_allocator_malloc(size_t) OSL_WARN_UNUSED_RESULT;
+void* osl_allocator_realloc(void*, size_t) OSL_WARN_UNUSED_RESULT;
+void osl_allocator_free(void*);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* define OSL_ALLOCATOR_H */
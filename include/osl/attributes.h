@@ -97,4 +97,10 @@
 #define OSL_WARN_UNUSED_RESULT
 #endif
 
+#if __GNUC__ > 2 || (__GNUC__ == 2 && __GNUC_MINOR__ >= 5)
+#define OSL_NORETURN __attribute__((__noreturn__))
+#else
+#define OSL_NORETURN
+#endif
+
 #endif
@@ -94,6 +94,24 @@ typedef struct osl_body* const osl_body_const_p OSL_DEPRECATED;
 typedef struct osl_body const* osl_const_body_p OSL_DEPRECATED;
 typedef struct osl_body const* const osl_const_body_const_p OSL_DEPRECATED;
 
+/**
+ * The osl_body_template structure stores a compiled form of a statement body
+ * expression where the original iterators have been replaced with "@i@"
+ * references (see osl_util_identifier_substitution). The expression is split
+ * into nb_references + 1 literal parts, stored one after the other in the
+ * text field, interleaved with the references. It may be instantiated with
+ * new iterator expressions as many times as necessary without scanning the
+ * original expression again.
+ */
+struct osl_body_template {
+  int nb_references;   /**< Number of iterator references */
+  int nb_identifiers;  /**< Number of identifiers (max. reference + 1) */
+  int* references;     /**< Ranks of the referenced identifiers */
+  size_t* literal_end; /**< End of each literal part in text */
+  char* text;          /**< Concatenated literal parts */
+};
+typedef struct osl_body_template osl_body_template;
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -122,8 +140,18 @@ void osl_body_free(osl_body*);
  ******************************************************************************/
 osl_body* osl_body_clone(const osl_body*) OSL_WARN_UNUSED_RESULT;
 bool osl_body_equal(const osl_body*, const osl_body*);
+void osl_body_memory_usage(const osl_body*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_body_interface(void) OSL_WARN_UNUSED_RESULT;
 
+osl_body_template* osl_body_template_sread(const char*)
+    OSL_WARN_UNUSED_RESULT;
+osl_body_template* osl_body_template_compile(const osl_body*)
+    OSL_WARN_UNUSED_RESULT;
+char* osl_body_template_instantiate(const osl_body_template*, char**)
+    OSL_WARN_UNUSED_RESULT;
+void osl_body_template_free(osl_body_template*);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,206 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                 delta.h                                  **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef OSL_DELTA_H
+#define OSL_DELTA_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <osl/attributes.h>
+#include <osl/generic.h>
+#include <osl/interface.h>
+#include <osl/relation.h>
+#include <osl/scop.h>
+#include <osl/statement.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define OSL_URI_SCOP_DELTA "OpenScop-delta"
+
+/**
+ * The osl_relation_delta structure describes a relation union (the target)
+ * from another one (the source), see osl_relation_diff. Each node describes
+ * a union part of the target. Each row of this part is either a row of a
+ * source part whose columns are picked according to the column map (a
+ * column without source is 0), or a literal row. The literal relation holds
+ * the literal rows, in order, as well as the type and the attributes of the
+ * target part. A NULL delta describes a NULL target relation.
+ */
+struct osl_relation_delta {
+  int part;                   /**< Source union part (-1 if none) */
+  int nb_rows;                /**< Number of rows of the target part */
+  int* row;                   /**< Source row of each row (-1 if literal) */
+  int* column;                /**< Source column of each column (-1 if 0) */
+  osl_relation* literal;      /**< Target attributes and literal rows */
+  struct osl_relation_delta* next; /**< Delta of the next union part */
+};
+typedef struct osl_relation_delta osl_relation_delta;
+
+/**
+ * The osl_relation_list_delta structure describes a relation list from
+ * another one: each node describes an element of the target list, either
+ * equal to an element of the source list or given by a relation delta.
+ */
+struct osl_relation_list_delta {
+  int source;                 /**< Source element (-1 if none) */
+  bool changed;               /**< True if different from the source */
+  osl_relation_delta* delta;  /**< Delta from the source, if changed */
+  struct osl_relation_list_delta* next; /**< Delta of the next element */
+};
+typedef struct osl_relation_list_delta osl_relation_list_delta;
+
+/**
+ * The osl_generic_delta structure describes a generic list from another
+ * one: each generic of the target list is either equal to a generic of the
+ * source list or a new generic.
+ */
+struct osl_generic_delta {
+  int nb_generics;    /**< Number of generics of the target list */
+  int* source;        /**< Source of each generic (-1 if new) */
+  osl_generic* added; /**< The new generics, in order */
+};
+typedef struct osl_generic_delta osl_generic_delta;
+
+/**
+ * The osl_statement_delta structure describes a statement list from
+ * another one: each node describes a statement of the target list by the
+ * changes of its parts with respect to a source statement. A NULL delta
+ * means that the part is unchanged (except for the relations, which have a
+ * flag since a NULL relation delta means a NULL relation).
+ */
+struct osl_statement_delta {
+  int source;                        /**< Source statement (-1 if none) */
+  bool domain_changed;               /**< True if the domain changed */
+  osl_relation_delta* domain;        /**< Delta of the domain */
+  bool scattering_changed;           /**< True if the scattering changed */
+  osl_relation_delta* scattering;    /**< Delta of the scattering */
+  bool access_changed;               /**< True if the accesses changed */
+  osl_relation_list_delta* access;   /**< Delta of the accesses */
+  osl_generic_delta* extension;      /**< Delta of the extensions */
+  struct osl_statement_delta* next;  /**< Delta of the next statement */
+};
+typedef struct osl_statement_delta osl_statement_delta;
+
+/**
+ * The osl_scop_delta structure describes a scop list (the target) from
+ * another one (the source), see osl_scop_diff and osl_scop_patch. Each node
+ * describes a scop of the target list from the scop at the same position
+ * in the source list (if any). The NULL fields are unchanged, except the
+ * language and the context which are unchanged unless their flag is set.
+ */
+struct osl_scop_delta {
+  int version;                     /**< Version of the target scop */
+  bool language_changed;           /**< True if the language changed */
+  char* language;                  /**< Target language (may be NULL) */
+  bool context_changed;            /**< True if the context changed */
+  osl_relation_delta* context;     /**< Delta of the context */
+  osl_generic_delta* parameters;   /**< Delta of the parameters */
+  osl_statement_delta* statement;  /**< Delta of each target statement */
+  osl_interface* registry;         /**< Target registry */
+  osl_generic_delta* extension;    /**< Delta of the extensions */
+  struct osl_scop_delta* next;     /**< Delta of the next scop */
+};
+typedef struct osl_scop_delta osl_scop_delta;
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+char* osl_scop_delta_sprint(const osl_scop_delta*);
+void osl_scop_delta_print(FILE*, const osl_scop_delta*) OSL_NONNULL_ARGS(1);
+
+/******************************************************************************
+ *                              Reading function                              *
+ ******************************************************************************/
+
+osl_scop_delta* osl_scop_delta_psread(char**, osl_interface*, int)
+    OSL_NONNULL_ARGS(1);
+osl_scop_delta* osl_scop_delta_pread(FILE*, osl_interface*, int)
+    OSL_NONNULL_ARGS(1);
+osl_scop_delta* osl_scop_delta_read(FILE*) OSL_NONNULL_ARGS(1);
+
+/******************************************************************************
+ *                   Memory allocation/deallocation function                  *
+ ******************************************************************************/
+
+void osl_relation_delta_free(osl_relation_delta*);
+void osl_scop_delta_free(osl_scop_delta*);
+
+/******************************************************************************
+ *                           Processing functions                             *
+ ******************************************************************************/
+
+osl_relation_delta* osl_relation_diff(const osl_relation*, const osl_relation*)
+    OSL_WARN_UNUSED_RESULT;
+osl_relation* osl_relation_patch(const osl_relation*, const osl_relation_delta*)
+    OSL_WARN_UNUSED_RESULT;
+osl_scop_delta* osl_scop_diff(const osl_scop*, const osl_scop*)
+    OSL_WARN_UNUSED_RESULT;
+osl_scop* osl_scop_patch(const osl_scop*, const osl_scop_delta*)
+    OSL_WARN_UNUSED_RESULT;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* define OSL_DELTA_H */
@@ -133,6 +133,8 @@ osl_annotation* osl_annotation_clone(const osl_annotation* annotation)
     OSL_WARN_UNUSED_RESULT;
 
 bool osl_annotation_equal(const osl_annotation* a1, const osl_annotation* a2);
+void osl_annotation_memory_usage(const osl_annotation*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 
 osl_interface* osl_annotation_interface(void) OSL_WARN_UNUSED_RESULT;
 
@@ -73,6 +73,24 @@ extern "C" {
 
 #define OSL_URI_ARRAYS "arrays"
 
+/**
+ * The osl_arrays_index structure is a hash index over the identifiers and
+ * the names of an osl_arrays structure, built on the first lookup (see
+ * osl_arrays_get_index_from_id). It maps each identifier and each name to
+ * its first position and keeps track of the capacity of the arrays so that
+ * osl_arrays_add runs in amortized constant time.
+ */
+struct osl_arrays_index {
+  int* id;           /**< Indexed identifier array, to detect replacements */
+  char** names;      /**< Indexed name array, to detect replacements */
+  int nb_names;      /**< Number of indexed names */
+  int capacity;      /**< Number of allocated slots in id and names */
+  size_t nb_buckets; /**< Number of buckets (a power of two) */
+  int* by_id;        /**< Position of an identifier plus one, 0 if empty */
+  int* by_name;      /**< Position of a name plus one, 0 if empty */
+};
+typedef struct osl_arrays_index osl_arrays_index;
+
 /**
  * The osl_arrays structure stores a set of array textual names in
  * the extension part of the OpenScop representation. Each name has a
@@ -80,9 +98,10 @@ extern "C" {
  * and identifier id[i].
  */
 struct osl_arrays {
-  int nb_names; /**< Number of names. */
-  int* id;      /**< Array of nb_names identifiers. */
-  char** names; /**< Array of nb_names names. */
+  int nb_names;            /**< Number of names. */
+  int* id;                 /**< Array of nb_names identifiers. */
+  char** names;            /**< Array of nb_names names. */
+  osl_arrays_index* index; /**< Lookup index, built on demand */
 };
 typedef struct osl_arrays osl_arrays;
 
@@ -117,10 +136,13 @@ void osl_arrays_free(osl_arrays*);
 
 osl_arrays* osl_arrays_clone(const osl_arrays*) OSL_WARN_UNUSED_RESULT;
 bool osl_arrays_equal(const osl_arrays*, const osl_arrays*);
+void osl_arrays_memory_usage(const osl_arrays*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_strings* osl_arrays_to_strings(const osl_arrays*) OSL_WARN_UNUSED_RESULT;
 int osl_arrays_add(osl_arrays*, int, const char*);
 size_t osl_arrays_get_index_from_id(const osl_arrays*, int);
 size_t osl_arrays_get_index_from_name(const osl_arrays*, const char*);
+void osl_arrays_invalidate(osl_arrays*) OSL_NONNULL;
 osl_interface* osl_arrays_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
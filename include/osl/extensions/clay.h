@@ -112,6 +112,8 @@ void osl_clay_free(osl_clay*);
 
 osl_clay* osl_clay_clone(const osl_clay*) OSL_WARN_UNUSED_RESULT;
 bool osl_clay_equal(const osl_clay*, const osl_clay*);
+void osl_clay_memory_usage(const osl_clay*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_clay_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
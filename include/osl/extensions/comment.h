@@ -111,6 +111,8 @@ void osl_comment_free(osl_comment*);
 
 osl_comment* osl_comment_clone(const osl_comment*) OSL_WARN_UNUSED_RESULT;
 bool osl_comment_equal(const osl_comment*, const osl_comment*);
+void osl_comment_memory_usage(const osl_comment*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_comment_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
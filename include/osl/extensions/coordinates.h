@@ -121,6 +121,8 @@ void osl_coordinates_free(osl_coordinates*);
 osl_coordinates* osl_coordinates_clone(const osl_coordinates*)
     OSL_WARN_UNUSED_RESULT;
 bool osl_coordinates_equal(const osl_coordinates*, const osl_coordinates*);
+void osl_coordinates_memory_usage(const osl_coordinates*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_coordinates_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
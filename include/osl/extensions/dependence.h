@@ -66,6 +66,7 @@
 #include <osl/attributes.h>
 #include <osl/interface.h>
 #include <osl/relation.h>
+#include <osl/scop.h>
 #include <osl/statement.h>
 
 #if defined(__cplusplus)
@@ -90,6 +91,19 @@ extern "C" {
 #define OSL_DEPENDENCE_M_REDUCTION 3
 #define OSL_DEPENDENCE_T_REDUCTION 4
 
+/**
+ * The osl_dependence_shared_domain structure is a dependence domain shared
+ * by several dependences of a list which have identical domains (see
+ * osl_dependence_share_domains). A shared domain must not be modified: a
+ * dependence gets its own copy with osl_dependence_unshare_domain. It is
+ * freed with its last dependence.
+ */
+struct osl_dependence_shared_domain {
+  osl_relation* domain; /**< Shared dependence polyhedron */
+  int nb_references;    /**< Number of dependences sharing it */
+};
+typedef struct osl_dependence_shared_domain osl_dependence_shared_domain;
+
 /* clang-format off */
 /**
  * \struct osl_dependence
@@ -158,8 +172,8 @@ struct osl_dependence {
                                   convenience. */
   struct osl_dependence* next; /**< Pointer to next dependence */
 
-  /* These attributes are not filled by osl
-   * You can use the function candl_dependence_init_fields of CandL
+  /* These attributes are not filled when reading, use
+   * osl_dependence_resolve or osl_scop_resolve_dependences
    */
 
   osl_relation* ref_source_access_ptr; /**< Pointer to the source access. */
@@ -167,6 +181,10 @@ struct osl_dependence {
 
   osl_statement* stmt_source_ptr; /**< Pointer to source statement. */
   osl_statement* stmt_target_ptr; /**< Pointer to target statement. */
+
+  osl_dependence_shared_domain* shared_domain; /**< Domain shared with other
+                                                    dependences (NULL if the
+                                                    domain is owned) */
 };
 typedef struct osl_dependence osl_dependence;
 
@@ -174,6 +192,74 @@ typedef struct osl_dependence osl_dependence;
 typedef struct osl_dependence osl_dependence_t OSL_DEPRECATED;
 typedef struct osl_dependence* osl_dependence_p OSL_DEPRECATED;
 
+/**
+ * The osl_dependence_bucket structure sorts the dependences of a list by
+ * an integer key, in compressed sparse row (CSR) form: the dependences with
+ * the slot k are edge[start[k]] to edge[start[k + 1] - 1], in the order of
+ * the list. The slot of a key is the key itself when the keys are small
+ * with respect to the number of dependences, otherwise it is the position
+ * of the key in the sorted array of the keys in use. The dependences with
+ * a negative key are not in the bucket.
+ */
+struct osl_dependence_bucket {
+  int size;                    /**< Number of slots */
+  int* key;                    /**< Key of each slot (NULL: the slot) */
+  int* start;                  /**< First edge of each slot (size + 1) */
+  const osl_dependence** edge; /**< Dependences sorted by key */
+};
+typedef struct osl_dependence_bucket osl_dependence_bucket;
+
+/**
+ * The osl_dependence_graph structure is an index of a dependence list to
+ * enumerate the dependences from or to a given statement, of a given type
+ * or at a given depth without scanning the whole list (see
+ * osl_dependence_graph_build and osl_dependence_iterator_init). A graph is
+ * a snapshot of the list it has been built from: it must be built again
+ * when the list is modified.
+ */
+struct osl_dependence_graph {
+  const osl_dependence* list;        /**< Indexed dependence list */
+  int nb_dependences;                /**< Number of dependences */
+  const osl_dependence** dependence; /**< Dependences in list order */
+  osl_dependence_bucket source;      /**< Dependences by label_source */
+  osl_dependence_bucket target;      /**< Dependences by label_target */
+  osl_dependence_bucket type;        /**< Dependences by type */
+  osl_dependence_bucket depth;       /**< Dependences by depth */
+};
+typedef struct osl_dependence_graph osl_dependence_graph;
+
+/**
+ * The osl_dependence_iterator structure enumerates the dependences of a
+ * graph which match some criteria (OSL_UNDEFINED for any value), in the
+ * order of the list. It walks the smallest bucket among the criteria.
+ */
+struct osl_dependence_iterator {
+  const osl_dependence* const* next; /**< Next candidate dependence */
+  const osl_dependence* const* end;  /**< End of the candidates */
+  int label_source;                  /**< Required source statement */
+  int label_target;                  /**< Required target statement */
+  int type;                          /**< Required dependence type */
+  int depth;                         /**< Required dependence depth */
+};
+typedef struct osl_dependence_iterator osl_dependence_iterator;
+
+/**
+ * The osl_dependence_cursor structure reads the dependences of a textual
+ * dependence extension one at a time, keeping only those which match some
+ * criteria (OSL_UNDEFINED for any value) and skipping the domains of the
+ * others without decoding them (see osl_dependence_cursor_init).
+ */
+struct osl_dependence_cursor {
+  char* input;      /**< Position in the textual dependences */
+  int nb_remaining; /**< Number of dependences left in the input */
+  int precision;    /**< Precision of the domains to read */
+  int label_source; /**< Required source statement */
+  int label_target; /**< Required target statement */
+  int type;         /**< Required dependence type */
+  int depth;        /**< Required dependence depth */
+};
+typedef struct osl_dependence_cursor osl_dependence_cursor;
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -188,6 +274,10 @@ void osl_dependence_print(FILE*, const osl_dependence*) OSL_NONNULL_ARGS(1);
  ******************************************************************************/
 osl_dependence* osl_dependence_sread(char**) OSL_WARN_UNUSED_RESULT;
 osl_dependence* osl_dependence_psread(char**, int) OSL_WARN_UNUSED_RESULT;
+void osl_dependence_cursor_init(osl_dependence_cursor*, char*, int, int, int,
+                                int) OSL_NONNULL_ARGS(1);
+osl_dependence* osl_dependence_cursor_next(osl_dependence_cursor*)
+    OSL_NONNULL OSL_WARN_UNUSED_RESULT;
 
 /******************************************************************************
  *                    Memory allocation/deallocation function                 *
@@ -195,6 +285,9 @@ osl_dependence* osl_dependence_psread(char**, int) OSL_WARN_UNUSED_RESULT;
 
 osl_dependence* osl_dependence_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_dependence_free(osl_dependence*);
+osl_dependence_graph* osl_dependence_graph_build(const osl_dependence*)
+    OSL_WARN_UNUSED_RESULT;
+void osl_dependence_graph_free(osl_dependence_graph*);
 
 /******************************************************************************
  *                            Processing functions                            *
@@ -202,9 +295,27 @@ void osl_dependence_free(osl_dependence*);
 
 osl_dependence* osl_dependence_clone(const osl_dependence*) OSL_WARN_UNUSED_RESULT;
 bool osl_dependence_equal(const osl_dependence*, const osl_dependence*);
+void osl_dependence_memory_usage(const osl_dependence*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 void osl_dependence_add(osl_dependence**, osl_dependence**,
                         osl_dependence*);
 int osl_nb_dependences(const osl_dependence*);
+const osl_dependence* const* osl_dependence_graph_from(
+    const osl_dependence_graph*, int, int*) OSL_NONNULL_ARGS(1, 3);
+const osl_dependence* const* osl_dependence_graph_to(
+    const osl_dependence_graph*, int, int*) OSL_NONNULL_ARGS(1, 3);
+const osl_dependence* const* osl_dependence_graph_of_type(
+    const osl_dependence_graph*, int, int*) OSL_NONNULL_ARGS(1, 3);
+const osl_dependence* const* osl_dependence_graph_at_depth(
+    const osl_dependence_graph*, int, int*) OSL_NONNULL_ARGS(1, 3);
+void osl_dependence_iterator_init(osl_dependence_iterator*,
+                                  const osl_dependence_graph*, int, int, int,
+                                  int) OSL_NONNULL_ARGS(1, 2);
+const osl_dependence* osl_dependence_iterator_next(osl_dependence_iterator*)
+    OSL_NONNULL;
+int osl_dependence_resolve(osl_dependence*, osl_scop*) OSL_NONNULL_ARGS(2);
+void osl_dependence_share_domains(osl_dependence*);
+void osl_dependence_unshare_domain(osl_dependence*) OSL_NONNULL;
 osl_interface* osl_dependence_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
@@ -121,6 +121,8 @@ void osl_extbody_free(osl_extbody*);
 
 osl_extbody* osl_extbody_clone(const osl_extbody*) OSL_WARN_UNUSED_RESULT;
 bool osl_extbody_equal(const osl_extbody*, const osl_extbody*);
+void osl_extbody_memory_usage(const osl_extbody*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_extbody_interface(void) OSL_WARN_UNUSED_RESULT;
 void osl_extbody_add(osl_extbody*, int, int);
 
@@ -134,6 +134,8 @@ void osl_irregular_free(osl_irregular*);
 
 osl_irregular* osl_irregular_clone(const osl_irregular*) OSL_WARN_UNUSED_RESULT;
 bool osl_irregular_equal(const osl_irregular*, const osl_irregular*);
+void osl_irregular_memory_usage(const osl_irregular*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_irregular* osl_irregular_add_control(const osl_irregular*, char**, int,
                                          const char*) OSL_WARN_UNUSED_RESULT;
 osl_irregular* osl_irregular_add_exit(const osl_irregular*, char**, int,
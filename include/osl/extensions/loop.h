@@ -131,6 +131,8 @@ osl_loop* osl_loop_clone_one(const osl_loop*) OSL_WARN_UNUSED_RESULT;
 osl_loop* osl_loop_clone(const osl_loop*) OSL_WARN_UNUSED_RESULT;
 bool osl_loop_equal_one(const osl_loop*, const osl_loop*);
 bool osl_loop_equal(const osl_loop*, const osl_loop*);
+void osl_loop_memory_usage(const osl_loop*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_strings* osl_loop_to_strings(const osl_loop*) OSL_WARN_UNUSED_RESULT;
 osl_interface* osl_loop_interface(void) OSL_WARN_UNUSED_RESULT;
 
@@ -111,6 +111,8 @@ void osl_null_free(osl_null*);
  ******************************************************************************/
 osl_null* osl_null_clone(const osl_null*) OSL_WARN_UNUSED_RESULT;
 bool osl_null_equal(const osl_null*, const osl_null*);
+void osl_null_memory_usage(const osl_null*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_null_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
@@ -120,6 +120,8 @@ osl_pluto_unroll* osl_pluto_unroll_clone(const osl_pluto_unroll*);
 bool osl_pluto_unroll_equal_one(const osl_pluto_unroll*,
                                 const osl_pluto_unroll*);
 bool osl_pluto_unroll_equal(const osl_pluto_unroll*, const osl_pluto_unroll*);
+void osl_pluto_unroll_memory_usage(const osl_pluto_unroll*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_strings* osl_pluto_unroll_to_strings(const osl_pluto_unroll*);
 osl_interface* osl_pluto_unroll_interface(void);
 
@@ -124,6 +124,8 @@ osl_region* osl_region_clone(const osl_region* region) OSL_WARN_UNUSED_RESULT;
 
 bool osl_region_equal_one(const osl_region* a1, const osl_region* a2);
 bool osl_region_equal(const osl_region* a1, const osl_region* a2);
+void osl_region_memory_usage(const osl_region*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 size_t osl_region_count(const osl_region* ll);
 
 osl_interface* osl_region_interface(void) OSL_WARN_UNUSED_RESULT;
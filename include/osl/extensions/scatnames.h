@@ -116,6 +116,8 @@ void osl_scatnames_free(osl_scatnames*);
 
 osl_scatnames* osl_scatnames_clone(const osl_scatnames*) OSL_WARN_UNUSED_RESULT;
 bool osl_scatnames_equal(const osl_scatnames*, const osl_scatnames*);
+void osl_scatnames_memory_usage(const osl_scatnames*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_scatnames_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
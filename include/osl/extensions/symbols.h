@@ -74,6 +74,21 @@ extern "C" {
 
 #define OSL_URI_SYMBOLS "symbols"
 
+/**
+ * The osl_symbols_index structure is a hash index over the identifiers of
+ * a symbols list, attached to its first node and built on the first lookup
+ * (see osl_symbols_lookup). It maps each identifier to its first symbol.
+ */
+struct osl_symbols_index {
+  struct osl_symbols* head;    /**< First node of the indexed list */
+  struct osl_symbols* last;    /**< Last indexed node */
+  size_t nb_symbols;           /**< Number of indexed symbols */
+  size_t nb_buckets;           /**< Number of buckets (a power of two) */
+  size_t* hash;                /**< Identifier hash of each bucket */
+  struct osl_symbols** symbol; /**< Symbol of each bucket (or NULL) */
+};
+typedef struct osl_symbols_index osl_symbols_index;
+
 /**
  * The osl_symbols structure stores information regarding the symbols.
  */
@@ -87,6 +102,7 @@ struct osl_symbols {
   osl_generic* extent;     /**< Limits of dimensions in Symbol */
 
   void* usr; /**< A user defined field */
+  osl_symbols_index* index; /**< Lookup index (first node only) */
   struct osl_symbols* next;
 };
 typedef struct osl_symbols osl_symbols;
@@ -124,11 +140,14 @@ void osl_symbols_add(osl_symbols**, osl_symbols*);
 osl_symbols* osl_symbols_nclone(const osl_symbols*, int) OSL_WARN_UNUSED_RESULT;
 osl_symbols* osl_symbols_clone(const osl_symbols*) OSL_WARN_UNUSED_RESULT;
 bool osl_symbols_equal(const osl_symbols*, const osl_symbols*);
+void osl_symbols_memory_usage(const osl_symbols*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_symbols* osl_symbols_lookup(osl_symbols*,
                                 osl_generic*) OSL_WARN_UNUSED_RESULT;
 osl_symbols* osl_symbols_remove(osl_symbols**,
                                 osl_symbols*) OSL_WARN_UNUSED_RESULT;
 int osl_symbols_get_nb_symbols(const osl_symbols*);
+void osl_symbols_invalidate(osl_symbols*) OSL_NONNULL;
 osl_interface* osl_symbols_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
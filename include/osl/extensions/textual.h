@@ -113,6 +113,8 @@ void osl_textual_free(osl_textual*);
 
 osl_textual* osl_textual_clone(const osl_textual*) OSL_WARN_UNUSED_RESULT;
 bool osl_textual_equal(const osl_textual*, const osl_textual*);
+void osl_textual_memory_usage(const osl_textual*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_textual_interface(void) OSL_WARN_UNUSED_RESULT;
 
 #if defined(__cplusplus)
@@ -80,6 +80,10 @@ extern "C" {
 struct osl_generic {
   void* data;               /**< Pointer to the data. */
   osl_interface* interface; /**< Interface to work with the data. */
+  size_t generation;        /**< Allocation counter, see
+                                 osl_util_generation. */
+  size_t list_generation;   /**< Last change of the list this generic
+                                 heads (osl_generic_add/remove). */
   struct osl_generic* next; /**< Pointer to the next generic. */
 };
 typedef struct osl_generic osl_generic;
@@ -93,6 +97,22 @@ typedef struct osl_generic const* osl_const_generic_p OSL_DEPRECATED;
 typedef struct osl_generic const* const osl_const_generic_const_p
     OSL_DEPRECATED;
 
+/**
+ * The osl_generic_index structure is a lookup table over a generic list.
+ * Each generic whose URI belongs to the default registry is stored in the
+ * slot of this URI (see osl_interface_URI_slot) so it can be found in
+ * constant time. An index is a snapshot of the list it has been built
+ * from: it has to be rebuilt when this list is modified. An index is never
+ * modified once built, hence it may be shared between threads.
+ */
+struct osl_generic_index {
+  const osl_generic* list;                /**< Indexed generic list */
+  size_t generation;                      /**< list_generation of the list */
+  osl_generic* slot[OSL_INTERFACE_SLOTS]; /**< Generic of each default URI */
+  bool others;                            /**< True if other URIs exist */
+};
+typedef struct osl_generic_index osl_generic_index;
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -120,6 +140,9 @@ void osl_generic_remove_node(osl_generic**, osl_generic*) OSL_NONNULL_ARGS(1);
 void osl_generic_remove(osl_generic**, const char*) OSL_NONNULL_ARGS(1);
 osl_generic* osl_generic_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_generic_free(osl_generic*);
+osl_generic_index* osl_generic_index_build(const osl_generic*)
+    OSL_WARN_UNUSED_RESULT;
+void osl_generic_index_free(osl_generic_index*);
 
 /******************************************************************************
  *                            Processing functions                            *
@@ -128,8 +151,14 @@ int osl_generic_number(const osl_generic*);
 osl_generic* osl_generic_clone(const osl_generic*) OSL_WARN_UNUSED_RESULT;
 osl_generic* osl_generic_nclone(const osl_generic*, int) OSL_WARN_UNUSED_RESULT;
 bool osl_generic_equal(const osl_generic*, const osl_generic*);
+void osl_generic_memory_usage(const osl_generic*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 bool osl_generic_has_URI(const osl_generic*, char const* const);
 void* osl_generic_lookup(const osl_generic*, char const* const);
+void* osl_generic_index_lookup(const osl_generic_index*, char const* const)
+    OSL_NONNULL_ARGS(1);
+void* osl_generic_index_cached_lookup(osl_generic_index**, const osl_generic*,
+                                     char const* const) OSL_NONNULL_ARGS(1);
 osl_generic* osl_generic_shell(void*, osl_interface*) OSL_WARN_UNUSED_RESULT;
 int osl_generic_count(const osl_generic*);
 
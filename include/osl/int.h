@@ -70,6 +70,7 @@
 #endif
 
 #include <osl/attributes.h>
+#include <osl/memory.h>
 
 #if defined(__cplusplus)
 extern "C" {
@@ -114,6 +115,8 @@ void osl_int_init_set_si(int, osl_int*, int);
 void osl_int_swap(int, osl_int*, osl_int*);
 void osl_int_clear(int, osl_int*);
 void osl_int_free(int, osl_int*);
+void osl_int_memory_usage(int, const osl_int, osl_memory_usage*)
+    OSL_NONNULL_ARGS(3);
 void osl_int_print(FILE*, int, const osl_int);
 void osl_int_sprint(char*, int, const osl_int);
 void osl_int_sprint_txt(char*, int, const osl_int);
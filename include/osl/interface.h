@@ -65,11 +65,18 @@
 #include <stdio.h>
 
 #include <osl/attributes.h>
+#include <osl/memory.h>
 
 #if defined(__cplusplus)
 extern "C" {
 #endif
 
+/**
+ * Maximum number of interfaces in the default registry. Each of them is
+ * identified by a slot, from 0 to OSL_INTERFACE_SLOTS - 1.
+ */
+#define OSL_INTERFACE_SLOTS 32
+
 typedef void (*osl_idump_f)(FILE*, void*, int);
 typedef char* (*osl_sprint_f)(void*);
 typedef void* (*osl_sread_f)(char**);
@@ -77,6 +84,7 @@ typedef void* (*osl_malloc_f)(void);
 typedef void (*osl_free_f)(void*);
 typedef void* (*osl_clone_f)(void*);
 typedef bool (*osl_equal_f)(void*, void*);
+typedef void (*osl_size_f)(void*, osl_memory_usage*);
 
 /**
  * The osl_interface structure stores the URI and base
@@ -92,6 +100,7 @@ struct osl_interface {
   osl_free_f free;            /**< Pointer to free function */
   osl_clone_f clone;          /**< Pointer to clone function */
   osl_equal_f equal;          /**< Pointer to equal function */
+  osl_size_f size;            /**< Pointer to memory usage function */
   struct osl_interface* next; /**< Next interface in the list */
 };
 typedef struct osl_interface osl_interface;
@@ -121,10 +130,15 @@ void osl_interface_free(osl_interface*);
  *                            Processing functions                            *
  ******************************************************************************/
 int osl_interface_number(const osl_interface*);
+bool osl_interface_is_shared(const osl_interface*);
+int osl_interface_slot(const osl_interface*);
+int osl_interface_URI_slot(const char*);
 osl_interface* osl_interface_nclone(const osl_interface*,
                                     int) OSL_WARN_UNUSED_RESULT;
 osl_interface* osl_interface_clone(const osl_interface*) OSL_WARN_UNUSED_RESULT;
 bool osl_interface_equal(const osl_interface*, const osl_interface*);
+void osl_interface_memory_usage(const osl_interface*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_interface* osl_interface_lookup(osl_interface*, const char*);
 osl_interface* osl_interface_get_default_registry(void) OSL_WARN_UNUSED_RESULT;
 
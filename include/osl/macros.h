@@ -61,8 +61,16 @@
 #ifndef OSL_MACROS_H
 #define OSL_MACROS_H
 
+#include "allocator.h"
+#include "error.h"
+#include "perf.h"
 #include "util.h"
 
+#ifdef OSL_SDT_IS_HERE
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+#endif
+
 #define OSL_DEBUG 0  // 1 for debug mode, 0 otherwise.
 
 #define OSL_URI_SCOP "OpenScop"
@@ -89,6 +97,8 @@
 #define OSL_MAX_STRING 2048
 #define OSL_MIN_STRING 100
 #define OSL_MAX_ARRAYS 128
+#define OSL_STATEMENT_PRINT_BATCH 1024
+#define OSL_STATEMENT_MAX_THREADS 256
 
 #define OSL_TYPE_GENERIC 0
 #define OSL_TYPE_STRING 1
@@ -141,24 +151,23 @@
     fprintf(stderr, "[osl] Warning: " msg " (%s).\n", __func__); \
   } while (0)
 
-#define OSL_error(msg)                                         \
-  do {                                                         \
-    fprintf(stderr, "[osl] Error: " msg " (%s).\n", __func__); \
-    exit(1);                                                   \
+#define OSL_error(msg)              \
+  do {                              \
+    osl_error_raise(msg, __func__); \
   } while (0)
 
 #define OSL_overflow(msg) OSL_error(msg)
 
-#define OSL_malloc(ptr, type, size)           \
-  do {                                        \
-    if (((ptr) = (type)malloc(size)) == NULL) \
-      OSL_error("memory overflow");           \
+#define OSL_malloc(ptr, type, size)                         \
+  do {                                                      \
+    if (((ptr) = (type)osl_allocator_malloc(size)) == NULL) \
+      OSL_error("memory overflow");                         \
   } while (0)
 
-#define OSL_realloc(ptr, type, size)                \
-  do {                                              \
-    if (((ptr) = (type)realloc(ptr, size)) == NULL) \
-      OSL_error("memory overflow");                 \
+#define OSL_realloc(ptr, type, size)                              \
+  do {                                                            \
+    if (((ptr) = (type)osl_allocator_realloc(ptr, size)) == NULL) \
+      OSL_error("memory overflow");                               \
   } while (0)
 
 #define OSL_strdup(destination, source)                      \
@@ -172,6 +181,67 @@
     }                                                        \
   } while (0)
 
+#define OSL_perf_begin(mark)                                \
+  do {                                                      \
+    (mark)->active = false;                                 \
+    if (__atomic_load_n(&osl_perf_state, __ATOMIC_RELAXED)) \
+      osl_perf_begin(mark);                                 \
+  } while (0)
+
+#define OSL_perf_end(phase, mark)    \
+  do {                               \
+    if ((mark)->active)              \
+      osl_perf_end((phase), (mark)); \
+  } while (0)
+
+// Static tracing probes (provider "osl"), e.g., "osl:relation__read__done"
+// for perf or bpftrace. Each probe has a semaphore, which the tracers make
+// non-zero while they trace it: the arguments are evaluated only then. They
+// are empty (and do not evaluate their arguments) when the library is built
+// without <sys/sdt.h>.
+#define OSL_PROBES(X)                                                       \
+  X(scop__read__start) X(scop__read__done) X(statement__read__start)        \
+  X(statement__read__done) X(relation__read__start) X(relation__read__done) \
+  X(generic__read__start) X(generic__read__done) X(scop__print__start)      \
+  X(scop__print__done) X(statement__print__start)                           \
+  X(statement__print__done) X(relation__print__start)                       \
+  X(relation__print__done) X(generic__print__start)                         \
+  X(generic__print__done)
+
+#ifdef OSL_SDT_IS_HERE
+#define OSL_PROBE_SEMAPHORE(name) extern unsigned short osl_##name##_semaphore;
+OSL_PROBES(OSL_PROBE_SEMAPHORE)
+
+#define OSL_probe_enabled(name) __builtin_expect(osl_##name##_semaphore != 0, 0)
+#define OSL_probe(name)                \
+  do {                                 \
+    if (OSL_probe_enabled(name))       \
+      DTRACE_PROBE(osl, name);         \
+  } while (0)
+#define OSL_probe1(name, a1)           \
+  do {                                 \
+    if (OSL_probe_enabled(name))       \
+      DTRACE_PROBE1(osl, name, a1);    \
+  } while (0)
+#define OSL_probe2(name, a1, a2)        \
+  do {                                  \
+    if (OSL_probe_enabled(name))        \
+      DTRACE_PROBE2(osl, name, a1, a2); \
+  } while (0)
+#define OSL_probe3(name, a1, a2, a3)        \
+  do {                                      \
+    if (OSL_probe_enabled(name))            \
+      DTRACE_PROBE3(osl, name, a1, a2, a3); \
+  } while (0)
+#else
+#define OSL_probe_enabled(name) 0
+#define OSL_probe(name) ((void)0)
+#define OSL_probe1(name, a1) ((void)sizeof(a1))
+#define OSL_probe2(name, a1, a2) ((void)sizeof(a1), (void)sizeof(a2))
+#define OSL_probe3(name, a1, a2, a3) \
+  ((void)sizeof(a1), (void)sizeof(a2), (void)sizeof(a3))
+#endif
+
 #define OSL_max(x, y) ((x) > (y) ? (x) : (y))
 
 #define OSL_min(x, y) ((x) < (y) ? (x) : (y))
@@ -70,6 +70,39 @@
 extern "C" {
 #endif
 
+#define OSL_NAMES_CACHE_BUCKETS 256
+
+/**
+ * The osl_names_columns structure stores the column names of the relations
+ * of a given kind and shape, and the corresponding column header comment, as
+ * used by the relation pretty-printer. Its kind, shape and column names are
+ * the key of the names column cache.
+ */
+struct osl_names_columns {
+  size_t hash;                    /**< Hash of the key */
+  int kind;                       /**< Relation kind (access...) */
+  int nb_columns;                 /**< Number of columns */
+  int nb_output_dims;             /**< Number of output dimensions */
+  int nb_input_dims;              /**< Number of input dimensions */
+  int nb_local_dims;              /**< Number of local dimensions */
+  int nb_parameters;              /**< Number of parameters */
+  char** strings;                 /**< NULL-terminated column names */
+  char* header;                   /**< Column header comment */
+  struct osl_names_columns* next; /**< Next columns of the same bucket */
+};
+typedef struct osl_names_columns osl_names_columns;
+
+/**
+ * The osl_names_cache structure is the column cache of a names structure
+ * (see osl_names_enable_cache), a hash table of osl_names_columns. Its
+ * entries are never modified once added (bucket heads are updated
+ * atomically), hence it may be used concurrently by several threads.
+ */
+struct osl_names_cache {
+  osl_names_columns* bucket[OSL_NAMES_CACHE_BUCKETS]; /**< Hash buckets */
+};
+typedef struct osl_names_cache osl_names_cache;
+
 /**
  * The osl_names structure stores the various names (names of iterators,
  * parameters...) necessary to generate a code from the OpenScop data
@@ -81,6 +114,7 @@ struct osl_names {
   osl_strings* scatt_dims; /**< Scattering dimension names */
   osl_strings* local_dims; /**< Local dimension names */
   osl_strings* arrays;     /**< Array names */
+  osl_names_cache* cache;  /**< Column cache for printing (may be NULL) */
 };
 typedef struct osl_names osl_names;
 
@@ -103,6 +137,7 @@ void osl_names_dump(FILE*, const osl_names*) OSL_NONNULL_ARGS(1);
  ******************************************************************************/
 osl_names* osl_names_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_names_free(osl_names*);
+void osl_names_columns_free(osl_names_columns*);
 
 /******************************************************************************
  *                            Processing functions                            *
@@ -111,6 +146,7 @@ osl_names* osl_names_clone(const osl_names*) OSL_WARN_UNUSED_RESULT;
 osl_names* osl_names_generate(const char*, int, const char*, int, const char*,
                               int, const char*, int, const char*,
                               int) OSL_WARN_UNUSED_RESULT OSL_NONNULL;
+void osl_names_enable_cache(osl_names*) OSL_NONNULL;
 #if defined(__cplusplus)
 }
 #endif
@@ -75,6 +75,7 @@
  * - irregular
  * - null
  * - openscop
+ * - OpenScop-delta
  * - relation
  * - relation_list
  * - scatnames
@@ -86,10 +87,14 @@
  * - vector
  */
 
+#include <osl/allocator.h>
 #include <osl/body.h>
+#include <osl/error.h>
 #include <osl/int.h>
 #include <osl/interface.h>
 #include <osl/macros.h>
+#include <osl/memory.h>
+#include <osl/perf.h>
 #include <osl/relation.h>
 #include <osl/relation_list.h>
 #include <osl/strings.h>
@@ -110,6 +115,7 @@
 #include <osl/extensions/symbols.h>
 #include <osl/extensions/textual.h>
 
+#include <osl/delta.h>
 #include <osl/generic.h>
 #include <osl/scop.h>
 #include <osl/statement.h>
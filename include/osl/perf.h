@@ -0,0 +1,145 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                  perf.h                                  **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef OSL_PERF_H
+#define OSL_PERF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <osl/attributes.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Phases of the library measured by the performance counters. The times of
+ * a phase include the ones of the phases it calls (e.g., the statement read
+ * includes the read of its relations). Calls interrupted by an error, and
+ * generic reads which find no generic, are not counted.
+ */
+#define OSL_PERF_RELATION_READ 0
+#define OSL_PERF_GENERIC_READ 1
+#define OSL_PERF_STATEMENT_READ 2
+#define OSL_PERF_SCOP_READ 3
+#define OSL_PERF_RELATION_PRINT 4
+#define OSL_PERF_SCOP_PRINT 5
+#define OSL_PERF_RELATION_CLONE 6
+#define OSL_PERF_SCOP_CLONE 7
+#define OSL_PERF_RELATION_EQUAL 8
+#define OSL_PERF_SCOP_EQUAL 9
+#define OSL_PERF_PRECISION 10
+#define OSL_PERF_NB_PHASES 11
+
+/**
+ * The osl_perf_counter structure stores what has been measured for a phase
+ * since the counters have been enabled or reset.
+ */
+struct osl_perf_counter {
+  unsigned long long calls;           /**< Number of completed calls */
+  unsigned long long bytes_requested; /**< Bytes asked to the allocator */
+  unsigned long long nanoseconds;     /**< Cumulative (wall-clock) time */
+};
+typedef struct osl_perf_counter osl_perf_counter;
+
+/**
+ * The osl_perf_mark structure is the state of a measured call, from
+ * OSL_perf_begin to OSL_perf_end.
+ */
+struct osl_perf_mark {
+  bool active;                        /**< True if the call is measured */
+  unsigned long long start;           /**< Time at the beginning (ns) */
+  unsigned long long bytes_requested; /**< Bytes requested by the thread */
+};
+typedef struct osl_perf_mark osl_perf_mark;
+
+/**
+ * State of the counters: 1 if enabled, 0 if disabled, -1 if the
+ * environment has not been checked yet. It is tested by OSL_perf_begin so
+ * that the disabled counters cost a single test.
+ */
+extern int osl_perf_state;
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+char* osl_perf_sprint_json(void) OSL_WARN_UNUSED_RESULT;
+void osl_perf_print_json(FILE*) OSL_NONNULL;
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+void osl_perf_enable(bool);
+bool osl_perf_is_enabled(void);
+void osl_perf_reset(void);
+void osl_perf_get(int, osl_perf_counter*) OSL_NONNULL;
+const char* osl_perf_phase_name(int);
+void osl_perf_begin(osl_perf_mark*) OSL_NONNULL;
+void osl_perf_end(int, const osl_perf_mark*) OSL_NONNULL;
+void osl_perf_allocated(size_t);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* define OSL_PERF_H */
@@ -112,6 +112,9 @@ struct osl_relation {
   int nb_parameters;         /**< Number of parameters */
   osl_int** m;               /**< An array of pointers to the beginning
                                     of each row of the relation matrix */
+  size_t generation;         /**< Modification counter, renewed by the
+                                  functions modifying the relation part
+                                  (see osl_relation_touch) */
   void* usr;                 /**< User-managed field, untouched by osl */
   struct osl_relation* next; /**< Pointer to the next relation in the
                                   union of relations (NULL if none) */
@@ -128,6 +131,7 @@ typedef struct osl_relation* osl_relation_p OSL_DEPRECATED;
 
 void osl_relation_idump(FILE*, const osl_relation*, int) OSL_NONNULL_ARGS(1);
 void osl_relation_dump(FILE*, const osl_relation*) OSL_NONNULL_ARGS(1);
+char* osl_relation_sprint_type(const osl_relation*);
 char* osl_relation_expression(const osl_relation*, int row,
                               char** names) OSL_NONNULL;
 char* osl_relation_spprint_polylib(const osl_relation*, const osl_names*);
@@ -158,6 +162,9 @@ osl_relation* osl_relation_psread_polylib(char**, int)
 osl_relation* osl_relation_sread(char**) OSL_NONNULL OSL_WARN_UNUSED_RESULT;
 osl_relation* osl_relation_sread_polylib(char**)
     OSL_NONNULL OSL_WARN_UNUSED_RESULT;
+bool osl_relation_pread_try(FILE*, int, osl_relation**) OSL_NONNULL;
+bool osl_relation_psread_try(char**, int, osl_relation**) OSL_NONNULL;
+void osl_relation_sskip(char**) OSL_NONNULL;
 
 /******************************************************************************
  *                    Memory allocation/deallocation function                 *
@@ -203,16 +210,20 @@ osl_relation* osl_relation_concat_constraints(
     const osl_relation*, const osl_relation*) OSL_WARN_UNUSED_RESULT;
 bool osl_relation_part_equal(const osl_relation*, const osl_relation*);
 bool osl_relation_equal(const osl_relation*, const osl_relation*);
+void osl_relation_memory_usage(const osl_relation*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 bool osl_relation_integrity_check(const osl_relation*, int, int, int, int);
 void osl_relation_set_attributes_one(osl_relation*, int, int, int, int);
 void osl_relation_set_attributes(osl_relation*, int, int, int, int);
 void osl_relation_set_type(osl_relation*, int);
+void osl_relation_touch(osl_relation*);
 int osl_relation_get_array_id(const osl_relation*);
 bool osl_relation_is_access(const osl_relation*);
 void osl_relation_get_attributes(const osl_relation*, int*, int*, int*, int*,
                                  int*);
 osl_relation* osl_relation_extend_output(const osl_relation*,
                                          int) OSL_WARN_UNUSED_RESULT;
+void osl_relation_extend_output_inplace(osl_relation*, int);
 osl_interface* osl_relation_interface(void) OSL_WARN_UNUSED_RESULT;
 void osl_relation_set_precision(int const, osl_relation*);
 void osl_relation_set_same_precision(osl_relation*, osl_relation*);
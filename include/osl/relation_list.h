@@ -95,6 +95,8 @@ void osl_relation_list_dump(FILE*, const osl_relation_list*)
     OSL_NONNULL_ARGS(1);
 void osl_relation_list_pprint_elts(FILE*, const osl_relation_list*,
                                    const osl_names*) OSL_NONNULL_ARGS(1);
+char* osl_relation_list_spprint_elts(const osl_relation_list*,
+                                     const osl_names*) OSL_WARN_UNUSED_RESULT;
 void osl_relation_list_pprint(FILE*, const osl_relation_list*, const osl_names*)
     OSL_NONNULL_ARGS(1);
 void osl_relation_list_print(FILE*, const osl_relation_list*)
@@ -141,6 +143,8 @@ void osl_relation_list_drop(osl_relation_list**);
 void osl_relation_list_destroy(osl_relation_list**);
 bool osl_relation_list_equal(const osl_relation_list*,
                              const osl_relation_list*);
+void osl_relation_list_memory_usage(const osl_relation_list*,
+                                    osl_memory_usage*) OSL_NONNULL_ARGS(2);
 bool osl_relation_list_integrity_check(const osl_relation_list*, int, int, int,
                                        int);
 void osl_relation_list_set_type(osl_relation_list*, int);
@@ -77,6 +77,20 @@
 extern "C" {
 #endif
 
+/**
+ * The osl_statement_print_cache structure stores the OpenScop text of a
+ * statement together with what this text depends on, so that printing the
+ * statement again reuses the text while the statement is unchanged (see
+ * osl_statement_enable_print_cache).
+ */
+struct osl_statement_print_cache {
+  char* text;   /**< OpenScop text of the statement (NULL if none) */
+  int number;   /**< Number of the statement in the text */
+  size_t names; /**< Stamp of the column names used for the text */
+  size_t stamp; /**< Stamp of the statement parts used for the text */
+};
+typedef struct osl_statement_print_cache osl_statement_print_cache;
+
 /**
  * The osl_statement structure stores a list of statement. Each node
  * contains the useful informations for a given statement to process it
@@ -88,6 +102,12 @@ struct osl_statement {
   osl_relation* scattering;   /**< Scattering relation of the statement*/
   osl_relation_list* access;  /**< Access information */
   osl_generic* extension;     /**< A list of statement extensions */
+  osl_generic_index* extension_index; /**< Lookup index over extension */
+  size_t generation;          /**< Modification counter, see
+                                   osl_statement_touch */
+  size_t list_generation;     /**< Last change of the list this statement
+                                   heads (osl_statement_add) */
+  osl_statement_print_cache* print_cache; /**< Print cache (may be NULL) */
   void* usr;                  /**< A user-defined field, not touched
                                    AT ALL by the OpenScop Library. */
   struct osl_statement* next; /**< Next statement in the linked list */
@@ -98,6 +118,42 @@ typedef struct osl_statement osl_statement;
 typedef struct osl_statement osl_statement_t OSL_DEPRECATED;
 typedef struct osl_statement* osl_statement_p OSL_DEPRECATED;
 
+/**
+ * The osl_statement_index structure is an array of the statements of a
+ * statement list, to access the statement at a given position (from 0) in
+ * constant time. An index is a snapshot of the list it has been built from:
+ * it is outdated when the list is modified, except by the appends through
+ * osl_statement_index_add (see osl_statement_index_is_valid).
+ */
+struct osl_statement_index {
+  const osl_statement* list; /**< Indexed statement list */
+  size_t generation;         /**< list_generation of the list */
+  osl_statement** statement; /**< Statement at each position */
+  size_t size;               /**< Number of indexed statements */
+  size_t capacity;           /**< Number of slots of the statement array */
+};
+typedef struct osl_statement_index osl_statement_index;
+
+/**
+ * The osl_statement_union_iterator structure enumerates the union-free
+ * instances of a statement list: one per combination of a domain part and a
+ * scattering part of each statement, in the order of
+ * osl_statement_remove_unions. Each instance is a read-only view which shares
+ * the relation rows, the access list and the extensions with the original
+ * statement, hence nothing is allocated. The iterator must not be copied
+ * while in use (the view points inside it).
+ */
+struct osl_statement_union_iterator {
+  const osl_statement* origin;    /**< Statement of the current view */
+  const osl_statement* statement; /**< Statement of the next view */
+  const osl_relation* domain;     /**< Domain part of the next view */
+  const osl_relation* scattering; /**< Scattering part of the next view */
+  osl_relation domain_part;       /**< Current domain part, alone */
+  osl_relation scattering_part;   /**< Current scattering part, alone */
+  osl_statement view;             /**< Current union-free statement */
+};
+typedef struct osl_statement_union_iterator osl_statement_union_iterator;
+
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -106,6 +162,8 @@ void osl_statement_idump(FILE*, const osl_statement*, int) OSL_NONNULL_ARGS(1);
 void osl_statement_dump(FILE*, const osl_statement*) OSL_NONNULL_ARGS(1);
 void osl_statement_pprint(FILE*, const osl_statement*, const osl_names*)
     OSL_NONNULL_ARGS(1);
+void osl_statement_pprint_parallel(FILE*, const osl_statement*,
+                                   const osl_names*, int) OSL_NONNULL_ARGS(1);
 void osl_statement_print(FILE*, const osl_statement*) OSL_NONNULL_ARGS(1);
 
 // SCoPLib Compatibility
@@ -118,6 +176,8 @@ void osl_statement_pprint_scoplib(FILE*, const osl_statement*, const osl_names*)
 
 osl_statement* osl_statement_pread(FILE*, osl_interface*, int);
 osl_statement* osl_statement_read(FILE*) OSL_NONNULL_ARGS(1);
+bool osl_statement_pread_try(FILE*, osl_interface*, int, osl_statement**)
+    OSL_NONNULL_ARGS(4);
 
 /******************************************************************************
  *                   Memory allocation/deallocation function                  *
@@ -125,25 +185,50 @@ osl_statement* osl_statement_read(FILE*) OSL_NONNULL_ARGS(1);
 
 osl_statement* osl_statement_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_statement_free(osl_statement*);
+osl_statement_index* osl_statement_index_build(const osl_statement*)
+    OSL_WARN_UNUSED_RESULT;
+void osl_statement_index_free(osl_statement_index*);
 
 /******************************************************************************
  *                           Processing functions                             *
  ******************************************************************************/
 
 void osl_statement_add(osl_statement**, osl_statement*);
+void osl_statement_touch(osl_statement*);
+void osl_statement_enable_print_cache(osl_statement*);
+void osl_statement_index_add(osl_statement_index*, osl_statement*)
+    OSL_NONNULL_ARGS(1);
+bool osl_statement_index_is_valid(const osl_statement_index*,
+                                  const osl_statement*) OSL_NONNULL_ARGS(1);
+osl_statement* osl_statement_index_get(const osl_statement_index*, int)
+    OSL_NONNULL_ARGS(1);
 void osl_statement_compact(osl_statement*, int);
 int osl_statement_number(const osl_statement*);
 osl_statement* osl_statement_nclone(const osl_statement*,
                                     int) OSL_WARN_UNUSED_RESULT;
 osl_statement* osl_statement_clone(const osl_statement*) OSL_WARN_UNUSED_RESULT;
+osl_statement* osl_statement_clone_parallel(const osl_statement*,
+                                            int) OSL_WARN_UNUSED_RESULT;
 osl_statement* osl_statement_remove_unions(const osl_statement*)
     OSL_WARN_UNUSED_RESULT;
+void osl_statement_union_iterator_init(osl_statement_union_iterator*,
+                                       const osl_statement*)
+    OSL_NONNULL_ARGS(1);
+const osl_statement* osl_statement_union_iterator_next(
+    osl_statement_union_iterator*) OSL_NONNULL;
 bool osl_statement_equal(const osl_statement*, const osl_statement*);
+bool osl_statement_equal_parallel(const osl_statement*, const osl_statement*,
+                                  int);
+void osl_statement_memory_usage(const osl_statement*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 bool osl_statement_integrity_check(const osl_statement*, int);
 int osl_statement_get_nb_iterators(const osl_statement*);
 void osl_statement_get_attributes(const osl_statement*, int*, int*, int*, int*,
                                   int*);
 osl_body* osl_statement_get_body(const osl_statement*);
+void* osl_statement_extension_lookup(osl_statement*, const char*)
+    OSL_NONNULL_ARGS(1);
+void osl_statement_extension_invalidate(osl_statement*) OSL_NONNULL_ARGS(1);
 #if defined(__cplusplus)
 }
 #endif
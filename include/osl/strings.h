@@ -72,12 +72,32 @@ extern "C" {
 
 #define OSL_URI_STRINGS "strings"
 
+/**
+ * The osl_strings_index structure is an optional hash index over the array
+ * of an osl_strings structure (see osl_strings_build_index). It maps each
+ * string to its position in the array and keeps track of the array capacity
+ * so that osl_strings_find and osl_strings_add run in (amortized) constant
+ * time.
+ */
+struct osl_strings_index {
+  char** string;     /**< Indexed array, to detect replaced arrays */
+  size_t generation; /**< generation of the strings when indexed */
+  size_t size;       /**< Number of strings in the array */
+  size_t capacity;   /**< Number of allocated slots in the array */
+  size_t nb_buckets; /**< Number of buckets (a power of two) */
+  size_t* bucket;    /**< Position of a string plus one, 0 if empty */
+};
+typedef struct osl_strings_index osl_strings_index;
+
 /* The "strings" type is simply a NULL-terminated array of C character
  * strings, i.e. a char **. It is encapsulated into a structure to allow
  * its manipulation through a generic type.
  */
 struct osl_strings {
-  char** string; /**< NULL-terminated array of character strings */
+  char** string;            /**< NULL-terminated array of character strings */
+  osl_strings_index* index; /**< Optional hash index over string */
+  size_t generation;        /**< Modification counter, see
+                                 osl_strings_touch */
 };
 typedef struct osl_strings osl_strings;
 
@@ -112,6 +132,8 @@ osl_strings* osl_strings_read(FILE*) OSL_WARN_UNUSED_RESULT OSL_NONNULL;
 
 osl_strings* osl_strings_malloc(void) OSL_WARN_UNUSED_RESULT;
 void osl_strings_free(osl_strings*);
+void osl_strings_build_index(osl_strings*) OSL_NONNULL;
+void osl_strings_free_index(osl_strings*) OSL_NONNULL;
 
 /******************************************************************************
  *                            Processing functions                            *
@@ -119,9 +141,12 @@ void osl_strings_free(osl_strings*);
 
 osl_strings* osl_strings_clone(const osl_strings*) OSL_WARN_UNUSED_RESULT;
 void osl_strings_add(osl_strings*, char const* const) OSL_NONNULL;
+void osl_strings_touch(osl_strings*) OSL_NONNULL;
 size_t osl_strings_find(const osl_strings*, char const* const) OSL_NONNULL;
 bool osl_strings_equal(const osl_strings*, const osl_strings*);
 size_t osl_strings_size(const osl_strings*);
+void osl_strings_memory_usage(const osl_strings*, osl_memory_usage*)
+    OSL_NONNULL_ARGS(2);
 osl_strings* osl_strings_encapsulate(char*) OSL_WARN_UNUSED_RESULT;
 osl_interface* osl_strings_interface(void) OSL_WARN_UNUSED_RESULT;
 osl_strings* osl_strings_generate(const char*,
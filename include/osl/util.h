@@ -84,6 +84,8 @@ char* osl_util_read_uptoendtag(FILE*, char**, const char*);
 char* osl_util_tag_content(const char*, const char*);
 void osl_util_safe_strcat(char**, const char*, size_t*);
 char* osl_util_strdup(char const*);
+size_t osl_util_hash(char const*);
+size_t osl_util_generation(void);
 int osl_util_get_precision(void);
 void osl_util_print_provided(FILE*, bool, const char*);
 char* osl_util_identifier_substitution(const char*, char**);
@@ -0,0 +1,263 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                               allocator.c                                **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef OSL_GMP_IS_HERE
+#include <gmp.h>
+#endif
+
+#include <osl/allocator.h>
+#include <osl/macros.h>
+
+static void* osl_allocator_libc_malloc(size_t, void*);
+static void* osl_allocator_libc_realloc(void*, size_t, void*);
+static void osl_allocator_libc_free(void*, void*);
+
+/**
+ * Allocator of the library. It is shared by all threads: it must be set
+ * before the library allocates anything (see osl_allocator_set).
+ */
+static osl_allocator osl_allocator_current = {
+    osl_allocator_libc_malloc, osl_allocator_libc_realloc,
+    osl_allocator_libc_free, NULL};
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_allocator_libc_malloc, osl_allocator_libc_realloc and
+ * osl_allocator_libc_free functions:
+ * these functions are the default allocator, they call the C library.
+ */
+static void* osl_allocator_libc_malloc(size_t size, void* user) {
+  (void)user;
+  return malloc(size);
+}
+
+static void* osl_allocator_libc_realloc(void* ptr, size_t size, void* user) {
+  (void)user;
+  return realloc(ptr, size);
+}
+
+static void osl_allocator_libc_free(void* ptr, void* user) {
+  (void)user;
+  free(ptr);
+}
+
+#ifdef OSL_GMP_IS_HERE
+/**
+ * osl_allocator_gmp_malloc, osl_allocator_gmp_realloc and
+ * osl_allocator_gmp_free functions:
+ * these functions adapt the allocator of the library to the memory
+ * functions of GMP (see mp_set_memory_functions).
+ */
+static void* osl_allocator_gmp_malloc(size_t size) {
+  void* ptr = osl_allocator_malloc(size);
+  if (ptr == NULL)
+    OSL_error("memory overflow");
+  return ptr;
+}
+
+static void* osl_allocator_gmp_realloc(void* ptr, size_t old_size,
+                                       size_t new_size) {
+  (void)old_size;
+  ptr = osl_allocator_realloc(ptr, new_size);
+  if (ptr == NULL)
+    OSL_error("memory overflow");
+  return ptr;
+}
+
+static void osl_allocator_gmp_free(void* ptr, size_t size) {
+  (void)size;
+  osl_allocator_free(ptr);
+}
+
+/**
+ * Memory functions of GMP before the library installed its own ones, to
+ * restore when the C library allocator is set back.
+ */
+static struct {
+  void* (*malloc)(size_t);
+  void* (*realloc)(void*, size_t, size_t);
+  void (*free)(void*, size_t);
+  bool installed; /**< true if the library installed its GMP functions */
+} osl_allocator_gmp_previous;
+
+/**
+ * osl_allocator_gmp_install function (internal function):
+ * this function makes GMP use the allocator of the library, and saves the
+ * GMP memory functions it replaces the first time.
+ */
+static void osl_allocator_gmp_install(void) {
+  if (!osl_allocator_gmp_previous.installed) {
+    mp_get_memory_functions(&osl_allocator_gmp_previous.malloc,
+                            &osl_allocator_gmp_previous.realloc,
+                            &osl_allocator_gmp_previous.free);
+    osl_allocator_gmp_previous.installed = true;
+  }
+  mp_set_memory_functions(osl_allocator_gmp_malloc, osl_allocator_gmp_realloc,
+                          osl_allocator_gmp_free);
+}
+
+/**
+ * osl_allocator_gmp_restore function (internal function):
+ * this function restores the GMP memory functions saved by
+ * osl_allocator_gmp_install, if the library installed its own ones and
+ * nobody replaced them since.
+ */
+static void osl_allocator_gmp_restore(void) {
+  if (!osl_allocator_gmp_previous.installed)
+    return;
+
+  void* (*current)(size_t);
+  mp_get_memory_functions(&current, NULL, NULL);
+  if (current == osl_allocator_gmp_malloc)
+    mp_set_memory_functions(osl_allocator_gmp_previous.malloc,
+                            osl_allocator_gmp_previous.realloc,
+                            osl_allocator_gmp_previous.free);
+  osl_allocator_gmp_previous.installed = false;
+}
+#endif
+
+/**
+ * osl_allocator_set function:
+ * this function sets the functions the library uses to allocate, resize and
+ * free memory, for its own structures and for the GMP integers when it is
+ * built with GMP (GMP is set for the whole process, and its previous memory
+ * functions are restored when the allocator is set back to NULL). The
+ * allocator is shared by all threads and the blocks allocated by one
+ * allocator must be freed by the same allocator: it has to be set before
+ * any other call to the library, and the strings and structures exchanged
+ * with the library (e.g., the results of the sprint functions) must be
+ * allocated and freed with osl_allocator_malloc and osl_allocator_free.
+ * \param[in] allocator The allocator to use (NULL for the C library one).
+ */
+void osl_allocator_set(const osl_allocator* const allocator) {
+  if (allocator == NULL) {
+    osl_allocator_current.malloc = osl_allocator_libc_malloc;
+    osl_allocator_current.realloc = osl_allocator_libc_realloc;
+    osl_allocator_current.free = osl_allocator_libc_free;
+    osl_allocator_current.user = NULL;
+#ifdef OSL_GMP_IS_HERE
+    osl_allocator_gmp_restore();
+#endif
+    return;
+  }
+
+  if (!allocator->malloc || !allocator->realloc || !allocator->free)
+    OSL_error("incomplete allocator");
+
+  osl_allocator_current = *allocator;
+#ifdef OSL_GMP_IS_HERE
+  osl_allocator_gmp_install();
+#endif
+}
+
+/**
+ * osl_allocator_get function:
+ * this function copies the allocator the library currently uses.
+ * \param[out] allocator Where to copy the current allocator.
+ */
+void osl_allocator_get(osl_allocator* const allocator) {
+  *allocator = osl_allocator_current;
+}
+
+/**
+ * osl_allocator_malloc function:
+ * this function allocates a block of size bytes with the allocator of the
+ * library (it is the function behind OSL_malloc).
+ * \param[in] size The size of the block.
+ * \return The new block (NULL if the allocation failed).
+ */
+void* osl_allocator_malloc(const size_t size) {
+  if (__atomic_load_n(&osl_perf_state, __ATOMIC_RELAXED) > 0)
+    osl_perf_allocated(size);
+  return osl_allocator_current.malloc(size, osl_allocator_current.user);
+}
+
+/**
+ * osl_allocator_realloc function:
+ * this function resizes to size bytes a block of the allocator of the
+ * library, or allocates a new one if ptr is NULL (it is the function behind
+ * OSL_realloc). The performance counters count the whole new size (see
+ * osl_perf_allocated).
+ * \param[in] ptr  The block to resize (NULL for a new block).
+ * \param[in] size The new size of the block.
+ * \return The resized block (NULL if the allocation failed).
+ */
+void* osl_allocator_realloc(void* const ptr, const size_t size) {
+  if (__atomic_load_n(&osl_perf_state, __ATOMIC_RELAXED) > 0)
+    osl_perf_allocated(size);
+  return osl_allocator_current.realloc(ptr, size, osl_allocator_current.user);
+}
+
+/**
+ * osl_allocator_free function:
+ * this function frees a block of the allocator of the library (nothing is
+ * done if ptr is NULL).
+ * \param[in] ptr The block to free.
+ */
+void osl_allocator_free(void* const ptr) {
+  if (ptr != NULL)
+    osl_allocator_current.free(ptr, osl_allocator_current.user);
+}
@@ -59,6 +59,7 @@
  ******************************************************************************/
 
 #include <ctype.h>
+#include <limits.h>
 #include <osl/body.h>
 #include <osl/interface.h>
 #include <osl/macros.h>
@@ -189,14 +190,14 @@ char* osl_body_sprint(const osl_body* const body) {
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
       char* const iterators = osl_strings_sprint(body->iterators);
       osl_util_safe_strcat(&string, iterators, &high_water_mark);
-      free(iterators);
+      osl_allocator_free(iterators);
     }
 
     sprintf(buffer, "# Statement body expression\n");
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     char* const expression = osl_strings_sprint(body->expression);
     osl_util_safe_strcat(&string, expression, &high_water_mark);
-    free(expression);
+    osl_allocator_free(expression);
   } else {
     sprintf(buffer, "# NULL body\n");
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
@@ -226,6 +227,7 @@ osl_body* osl_body_sread(char** const input) {
     return NULL;
 
   osl_body* const body = osl_body_malloc();
+  osl_error_protect(body, (osl_error_cleanup_f)osl_body_free);
 
   // Read the number of iterators.
   const int nb_iterators = osl_util_read_int(NULL, input);
@@ -243,6 +245,7 @@ osl_body* osl_body_sread(char** const input) {
   // Insert the body.
   body->expression = osl_strings_encapsulate(expression);
 
+  osl_error_unprotect(body);
   return body;
 }
 
@@ -277,7 +280,7 @@ void osl_body_free(osl_body* const body) {
   if (body) {
     osl_strings_free(body->iterators);
     osl_strings_free(body->expression);
-    free(body);
+    osl_allocator_free(body);
   }
 }
 
@@ -335,6 +338,23 @@ bool osl_body_equal(const osl_body* const b1, const osl_body* const b2) {
   return true;
 }
 
+/**
+ * osl_body_memory_usage function:
+ * this function adds the memory footprint of an osl_body structure (its
+ * iterators and expression) to a memory usage.
+ * \param[in]     body  The body structure.
+ * \param[in,out] usage The memory usage to update.
+ */
+void osl_body_memory_usage(const osl_body* const body,
+                           osl_memory_usage* const usage) {
+  if (!body)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_body));
+  osl_strings_memory_usage(body->iterators, usage);
+  osl_strings_memory_usage(body->expression, usage);
+}
+
 /**
  * osl_body_interface function:
  * this function creates an interface structure corresponding to the body
@@ -352,6 +372,163 @@ osl_interface* osl_body_interface(void) {
   interface->free = (osl_free_f)osl_body_free;
   interface->clone = (osl_clone_f)osl_body_clone;
   interface->equal = (osl_equal_f)osl_body_equal;
+  interface->size = (osl_size_f)osl_body_memory_usage;
 
   return interface;
 }
+
+/**
+ * osl_body_template_sread function:
+ * this function compiles a body template string where iterator references
+ * are written "@i@", i being the rank of the iterator (as returned by
+ * osl_util_identifier_substitution), into an osl_body_template structure.
+ * Any '@' character which does not start such a reference is kept as is.
+ * \param[in] string The template string to compile.
+ * \return The compiled template (to be freed with osl_body_template_free).
+ */
+osl_body_template* osl_body_template_sread(const char* const string) {
+  if (!string)
+    return NULL;
+
+  // Count the '@' characters to bound the number of references.
+  const size_t length = strlen(string);
+  size_t max_references = 0;
+  for (size_t i = 0; i < length; i++)
+    if (string[i] == '@')
+      max_references++;
+  max_references /= 2;
+
+  osl_body_template* template;
+  OSL_malloc(template, osl_body_template*, sizeof(osl_body_template));
+  template->nb_references = 0;
+  template->nb_identifiers = 0;
+  OSL_malloc(template->references, int*, (max_references + 1) * sizeof(int));
+  OSL_malloc(template->literal_end, size_t*,
+             (max_references + 1) * sizeof(size_t));
+  OSL_malloc(template->text, char*, (length + 1) * sizeof(char));
+
+  size_t text_length = 0;
+  size_t i = 0;
+  while (i < length) {
+    // Check for a "@i@" reference.
+    if (string[i] == '@') {
+      size_t end = i + 1;
+      int rank = 0;
+      while (isdigit((unsigned char)string[end]) && (rank < INT_MAX / 10 - 1)) {
+        rank = rank * 10 + (string[end] - '0');
+        end++;
+      }
+      if ((end > i + 1) && (string[end] == '@')) {
+        template->literal_end[template->nb_references] = text_length;
+        template->references[template->nb_references] = rank;
+        template->nb_references++;
+        if (rank >= template->nb_identifiers)
+          template->nb_identifiers = rank + 1;
+        i = end + 1;
+        continue;
+      }
+    }
+    template->text[text_length++] = string[i++];
+  }
+  template->literal_end[template->nb_references] = text_length;
+  template->text[text_length] = '\0';
+
+  return template;
+}
+
+/**
+ * osl_body_template_compile function:
+ * this function compiles the expression of a body into an osl_body_template
+ * structure where the original iterators of the body are references to be
+ * replaced at instantiation time. Parentheses are kept around references
+ * when they may be necessary (see osl_util_identifier_substitution).
+ * \param[in] body The body to compile.
+ * \return The compiled template (to be freed with osl_body_template_free).
+ */
+osl_body_template* osl_body_template_compile(const osl_body* const body) {
+  if (!body || !body->expression || !body->expression->string[0])
+    return NULL;
+
+  if (!body->iterators)
+    return osl_body_template_sread(body->expression->string[0]);
+
+  char* const string = osl_util_identifier_substitution(
+      body->expression->string[0], body->iterators->string);
+  osl_body_template* const template = osl_body_template_sread(string);
+  osl_allocator_free(string);
+
+  return template;
+}
+
+/**
+ * osl_body_template_instantiate function:
+ * this function builds a new body expression from a compiled template by
+ * replacing the ith reference with the ith string of the NULL-terminated
+ * names array. References with no corresponding name are printed back as
+ * "@i@".
+ * \param[in] template The compiled template to instantiate.
+ * \param[in] names    NULL-terminated array of the iterator expressions.
+ * \return A new string with the instantiated body expression.
+ */
+char* osl_body_template_instantiate(const osl_body_template* const template,
+                                    char** const names) {
+  if (!template)
+    return NULL;
+
+  int nb_names = 0;
+  while (names && names[nb_names] && (nb_names < template->nb_identifiers))
+    nb_names++;
+
+  // Compute the exact length of the result.
+  char buffer[OSL_MIN_STRING];
+  size_t length = template->literal_end[template->nb_references];
+  for (int i = 0; i < template->nb_references; i++) {
+    const int rank = template->references[i];
+    if (rank < nb_names)
+      length += strlen(names[rank]);
+    else
+      length += (size_t)sprintf(buffer, "@%d@", rank);
+  }
+
+  char* string;
+  OSL_malloc(string, char*, (length + 1) * sizeof(char));
+
+  size_t start = 0;
+  size_t position = 0;
+  for (int i = 0; i <= template->nb_references; i++) {
+    const size_t end = template->literal_end[i];
+    memcpy(string + position, template->text + start, end - start);
+    position += end - start;
+    start = end;
+
+    if (i == template->nb_references)
+      break;
+
+    const int rank = template->references[i];
+    if (rank < nb_names) {
+      const size_t name_length = strlen(names[rank]);
+      memcpy(string + position, names[rank], name_length);
+      position += name_length;
+    } else {
+      position += (size_t)sprintf(string + position, "@%d@", rank);
+    }
+  }
+  string[position] = '\0';
+
+  return string;
+}
+
+/**
+ * osl_body_template_free function:
+ * this function frees the allocated memory for an osl_body_template
+ * structure.
+ * \param[in,out] template The pointer to the template we want to free.
+ */
+void osl_body_template_free(osl_body_template* const template) {
+  if (template) {
+    osl_allocator_free(template->references);
+    osl_allocator_free(template->literal_end);
+    osl_allocator_free(template->text);
+    osl_allocator_free(template);
+  }
+}
@@ -0,0 +1,1469 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                 delta.c                                  **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/delta.h>
+#include <osl/generic.h>
+#include <osl/int.h>
+#include <osl/interface.h>
+#include <osl/macros.h>
+#include <osl/relation.h>
+#include <osl/relation_list.h>
+#include <osl/scop.h>
+#include <osl/statement.h>
+#include <osl/util.h>
+
+static void osl_generic_delta_free(osl_generic_delta*);
+static void osl_statement_delta_free(osl_statement_delta*);
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+/**
+ * osl_delta_sprint_ints internal function:
+ * this function appends a comment line then an array of integers on a
+ * single line to a string.
+ * \param[in,out] string          The string to append to.
+ * \param[in,out] high_water_mark The allocated size of the string.
+ * \param[in]     comment         The comment line to print first.
+ * \param[in]     size            The number of integers.
+ * \param[in]     array           The integers to print.
+ */
+static void osl_delta_sprint_ints(char** const string,
+                                  size_t* const high_water_mark,
+                                  const char* const comment, const int size,
+                                  const int* const array) {
+  char buffer[OSL_MAX_STRING];
+
+  snprintf(buffer, OSL_MAX_STRING, "# %s\n", comment);
+  osl_util_safe_strcat(string, buffer, high_water_mark);
+  for (int i = 0; i < size; i++) {
+    snprintf(buffer, OSL_MAX_STRING, (i == 0) ? "%d" : " %d", array[i]);
+    osl_util_safe_strcat(string, buffer, high_water_mark);
+  }
+  osl_util_safe_strcat(string, "\n", high_water_mark);
+}
+
+/**
+ * osl_relation_delta_sprint_literal internal function:
+ * this function appends the literal relation of a relation delta to a
+ * string in the OpenScop format, without comments. The literal rows are
+ * only a part of a relation, e.g., an access relation may have no array
+ * identifier row, hence there is no way to name its columns.
+ * \param[in,out] string          The string to append to.
+ * \param[in,out] high_water_mark The allocated size of the string.
+ * \param[in]     literal         The literal relation to print.
+ */
+static void osl_relation_delta_sprint_literal(
+    char** const string, size_t* const high_water_mark,
+    const osl_relation* const literal) {
+  char buffer[OSL_MAX_STRING];
+
+  char* const type = osl_relation_sprint_type(literal);
+  osl_util_safe_strcat(string, type, high_water_mark);
+  osl_allocator_free(type);
+  snprintf(buffer, OSL_MAX_STRING, "\n%d %d %d %d %d %d\n", literal->nb_rows,
+           literal->nb_columns, literal->nb_output_dims,
+           literal->nb_input_dims, literal->nb_local_dims,
+           literal->nb_parameters);
+  osl_util_safe_strcat(string, buffer, high_water_mark);
+
+  for (int i = 0; i < literal->nb_rows; i++) {
+    for (int j = 0; j < literal->nb_columns; j++) {
+      osl_int_sprint(buffer, literal->precision, literal->m[i][j]);
+      osl_util_safe_strcat(string, buffer, high_water_mark);
+      osl_util_safe_strcat(string, " ", high_water_mark);
+    }
+    osl_util_safe_strcat(string, "\n", high_water_mark);
+  }
+}
+
+/**
+ * osl_relation_delta_sprint internal function:
+ * this function appends a relation delta to a string, according to the
+ * format read by osl_relation_delta_psread.
+ * \param[in,out] string          The string to append to.
+ * \param[in,out] high_water_mark The allocated size of the string.
+ * \param[in]     delta           The relation delta to print.
+ */
+static void osl_relation_delta_sprint(char** const string,
+                                      size_t* const high_water_mark,
+                                      const osl_relation_delta* delta) {
+  char buffer[OSL_MAX_STRING];
+  int nb_parts = 0;
+
+  for (const osl_relation_delta* part = delta; part; part = part->next)
+    nb_parts++;
+  snprintf(buffer, OSL_MAX_STRING, "# Number of union parts\n%d\n", nb_parts);
+  osl_util_safe_strcat(string, buffer, high_water_mark);
+
+  for (; delta; delta = delta->next) {
+    snprintf(buffer, OSL_MAX_STRING,
+             "# Source union part, number of rows and columns\n%d %d %d\n",
+             delta->part, delta->nb_rows, delta->literal->nb_columns);
+    osl_util_safe_strcat(string, buffer, high_water_mark);
+    osl_delta_sprint_ints(string, high_water_mark, "Source rows",
+                          delta->nb_rows, delta->row);
+    osl_delta_sprint_ints(string, high_water_mark, "Source columns",
+                          delta->literal->nb_columns, delta->column);
+
+    osl_util_safe_strcat(string, "# Literal rows\n", high_water_mark);
+    osl_relation_delta_sprint_literal(string, high_water_mark, delta->literal);
+  }
+}
+
+/**
+ * osl_generic_delta_sprint internal function:
+ * this function appends a generic delta to a string, according to the
+ * format read by osl_generic_delta_psread. An unchanged generic list is
+ * printed as -1.
+ * \param[in,out] string          The string to append to.
+ * \param[in,out] high_water_mark The allocated size of the string.
+ * \param[in]     comment         The name of the generic list.
+ * \param[in]     delta           The generic delta to print.
+ */
+static void osl_generic_delta_sprint(char** const string,
+                                     size_t* const high_water_mark,
+                                     const char* const comment,
+                                     const osl_generic_delta* const delta) {
+  char buffer[OSL_MAX_STRING];
+
+  snprintf(buffer, OSL_MAX_STRING, "# %s (-1 if unchanged)\n%d\n", comment,
+           delta ? delta->nb_generics : -1);
+  osl_util_safe_strcat(string, buffer, high_water_mark);
+  if (delta) {
+    osl_delta_sprint_ints(string, high_water_mark, "Source generics",
+                          delta->nb_generics, delta->source);
+    char* const added = osl_generic_sprint(delta->added);
+    osl_util_safe_strcat(string, added, high_water_mark);
+    osl_allocator_free(added);
+  }
+}
+
+/**
+ * osl_statement_delta_sprint internal function:
+ * this function appends a statement delta list to a string, according to
+ * the format read by osl_statement_delta_psread.
+ * \param[in,out] string          The string to append to.
+ * \param[in,out] high_water_mark The allocated size of the string.
+ * \param[in]     delta           The statement delta list to print.
+ */
+static void osl_statement_delta_sprint(char** const string,
+                                       size_t* const high_water_mark,
+                                       const osl_statement_delta* delta) {
+  char buffer[OSL_MAX_STRING];
+  int nb_statements = 0;
+
+  for (const osl_statement_delta* s = delta; s; s = s->next)
+    nb_statements++;
+  snprintf(buffer, OSL_MAX_STRING, "# Number of statements\n%d\n",
+           nb_statements);
+  osl_util_safe_strcat(string, buffer, high_water_mark);
+
+  for (int i = 1; delta; delta = delta->next, i++) {
+    snprintf(buffer, OSL_MAX_STRING,
+             "\n# =============================================== "
+             "Statement %d\n# Source statement\n%d\n",
+             i, delta->source);
+    osl_util_safe_strcat(string, buffer, high_water_mark);
+
+    snprintf(buffer, OSL_MAX_STRING, "# Domain changed\n%d\n",
+             delta->domain_changed);
+    osl_util_safe_strcat(string, buffer, high_water_mark);
+    if (delta->domain_changed)
+      osl_relation_delta_sprint(string, high_water_mark, delta->domain);
+
+    snprintf(buffer, OSL_MAX_STRING, "# Scattering changed\n%d\n",
+             delta->scattering_changed);
+    osl_util_safe_strcat(string, buffer, high_water_mark);
+    if (delta->scattering_changed)
+      osl_relation_delta_sprint(string, high_water_mark, delta->scattering);
+
+    snprintf(buffer, OSL_MAX_STRING, "# Access changed\n%d\n",
+             delta->access_changed);
+    osl_util_safe_strcat(string, buffer, high_water_mark);
+    if (delta->access_changed) {
+      int nb_accesses = 0;
+      for (const osl_relation_list_delta* a = delta->access; a; a = a->next)
+        nb_accesses++;
+      snprintf(buffer, OSL_MAX_STRING, "# Number of accesses\n%d\n",
+               nb_accesses);
+      osl_util_safe_strcat(string, buffer, high_water_mark);
+      for (const osl_relation_list_delta* a = delta->access; a; a = a->next) {
+        snprintf(buffer, OSL_MAX_STRING,
+                 "# Source access and access changed\n%d %d\n", a->source,
+                 a->changed);
+        osl_util_safe_strcat(string, buffer, high_water_mark);
+        if (a->changed)
+          osl_relation_delta_sprint(string, high_water_mark, a->delta);
+      }
+    }
+
+    osl_generic_delta_sprint(string, high_water_mark, "Statement extensions",
+                             delta->extension);
+  }
+}
+
+/**
+ * osl_interface_delta_sprint internal function:
+ * this function appends the URIs of a target registry to a string,
+ * according to the format read by osl_interface_delta_psread. An unchanged
+ * registry (NULL) is printed as -1.
+ * \param[in,out] string          The string to append to.
+ * \param[in,out] high_water_mark The allocated size of the string.
+ * \param[in]     registry        The target registry to print.
+ */
+static void osl_interface_delta_sprint(char** const string,
+                                       size_t* const high_water_mark,
+                                       const osl_interface* registry) {
+  char buffer[OSL_MAX_STRING];
+
+  snprintf(buffer, OSL_MAX_STRING, "# Registry (-1 if unchanged)\n%d\n",
+           registry ? osl_interface_number(registry) : -1);
+  osl_util_safe_strcat(string, buffer, high_water_mark);
+  for (; registry; registry = registry->next) {
+    osl_util_safe_strcat(string, registry->URI, high_water_mark);
+    osl_util_safe_strcat(string, "\n", high_water_mark);
+  }
+}
+
+/**
+ * osl_scop_delta_sprint function:
+ * this function prints the content of an osl_scop_delta structure (list)
+ * into a string (returned), one <OpenScop-delta> block per node. The
+ * target registry is printed as the list of its URIs.
+ * \param[in] delta The scop delta to print.
+ * \return A string containing the textual form of the delta.
+ */
+char* osl_scop_delta_sprint(const osl_scop_delta* delta) {
+  size_t high_water_mark = OSL_MAX_STRING;
+  char* string = NULL;
+  char buffer[OSL_MAX_STRING];
+
+  OSL_malloc(string, char*, high_water_mark * sizeof(char));
+  string[0] = '\0';
+
+  for (; delta; delta = delta->next) {
+    snprintf(buffer, OSL_MAX_STRING, "<%s>\n\n# Version\n%d\n",
+             OSL_URI_SCOP_DELTA, delta->version);
+    osl_util_safe_strcat(&string, buffer, &high_water_mark);
+
+    snprintf(buffer, OSL_MAX_STRING,
+             "# Language (-1 if unchanged, 0 if none)\n%d\n",
+             delta->language_changed ? (delta->language != NULL) : -1);
+    osl_util_safe_strcat(&string, buffer, &high_water_mark);
+    if (delta->language) {
+      osl_util_safe_strcat(&string, delta->language, &high_water_mark);
+      osl_util_safe_strcat(&string, "\n", &high_water_mark);
+    }
+
+    snprintf(buffer, OSL_MAX_STRING, "# Context changed\n%d\n",
+             delta->context_changed);
+    osl_util_safe_strcat(&string, buffer, &high_water_mark);
+    if (delta->context_changed)
+      osl_relation_delta_sprint(&string, &high_water_mark, delta->context);
+
+    osl_generic_delta_sprint(&string, &high_water_mark, "Parameters",
+                             delta->parameters);
+    osl_statement_delta_sprint(&string, &high_water_mark, delta->statement);
+    osl_util_safe_strcat(&string, "\n", &high_water_mark);
+    osl_interface_delta_sprint(&string, &high_water_mark, delta->registry);
+    osl_generic_delta_sprint(&string, &high_water_mark, "Extensions",
+                             delta->extension);
+
+    snprintf(buffer, OSL_MAX_STRING, "</%s>\n", OSL_URI_SCOP_DELTA);
+    osl_util_safe_strcat(&string, buffer, &high_water_mark);
+    if (delta->next)
+      osl_util_safe_strcat(&string, "\n", &high_water_mark);
+  }
+
+  return string;
+}
+
+/**
+ * osl_scop_delta_print function:
+ * this function prints the content of an osl_scop_delta structure (list)
+ * into a file (file, possibly stdout), see osl_scop_delta_sprint.
+ * \param[in] file  File where the information has to be printed.
+ * \param[in] delta The scop delta to print.
+ */
+void osl_scop_delta_print(FILE* const file,
+                          const osl_scop_delta* const delta) {
+  char* const string = osl_scop_delta_sprint(delta);
+  fprintf(file, "%s", string);
+  osl_allocator_free(string);
+}
+
+/******************************************************************************
+ *                              Reading function                              *
+ ******************************************************************************/
+
+/**
+ * osl_delta_sread_ints internal function:
+ * this function reads an array of integers from a string.
+ * \param[in,out] input The input string, updated after what has been read.
+ * \param[in]     size  The number of integers to read.
+ * \return A freshly allocated array of integers (NULL if size is 0).
+ */
+static int* osl_delta_sread_ints(char** const input, const int size) {
+  int* array = NULL;
+
+  if (size < 0)
+    OSL_error("negative size in delta");
+  if (size > 0) {
+    OSL_malloc(array, int*, (size_t)size * sizeof(int));
+    osl_error_protect(array, osl_allocator_free);
+    for (int i = 0; i < size; i++)
+      array[i] = osl_util_read_int(NULL, input);
+    osl_error_unprotect(array);
+  }
+
+  return array;
+}
+
+/**
+ * osl_relation_delta_psread internal function:
+ * this function reads a relation delta from a string complying to the
+ * format printed by osl_relation_delta_sprint.
+ * \param[in,out] input     The input string, updated after what has been read.
+ * \param[in]     precision The precision of the literal rows.
+ * \return A pointer to the relation delta that has been read.
+ */
+static osl_relation_delta* osl_relation_delta_psread(char** const input,
+                                                     const int precision) {
+  osl_relation_delta* head = NULL;
+  osl_relation_delta** last = &head;
+  const int nb_parts = osl_util_read_int(NULL, input);
+
+  for (int i = 0; i < nb_parts; i++) {
+    osl_relation_delta* delta;
+    OSL_malloc(delta, osl_relation_delta*, sizeof(osl_relation_delta));
+    delta->row = NULL;
+    delta->column = NULL;
+    delta->literal = NULL;
+    delta->next = NULL;
+    if (!head)
+      osl_error_protect(delta, (osl_error_cleanup_f)osl_relation_delta_free);
+    *last = delta;
+    last = &delta->next;
+
+    delta->part = osl_util_read_int(NULL, input);
+    delta->nb_rows = osl_util_read_int(NULL, input);
+    const int nb_columns = osl_util_read_int(NULL, input);
+    delta->row = osl_delta_sread_ints(input, delta->nb_rows);
+    delta->column = osl_delta_sread_ints(input, nb_columns);
+    delta->literal = osl_relation_psread(input, precision);
+    if (delta->literal->nb_columns != nb_columns)
+      OSL_error("inconsistent number of columns in delta");
+  }
+
+  osl_error_unprotect(head);
+  return head;
+}
+
+/**
+ * osl_generic_delta_psread internal function:
+ * this function reads a generic delta from a string complying to the
+ * format printed by osl_generic_delta_sprint.
+ * \param[in,out] input    The input string, updated after what has been read.
+ * \param[in]     registry The list of known interfaces.
+ * \return A pointer to the generic delta that has been read (NULL if the
+ *         generic list is unchanged).
+ */
+static osl_generic_delta* osl_generic_delta_psread(
+    char** const input, osl_interface* const registry) {
+  const int nb_generics = osl_util_read_int(NULL, input);
+  if (nb_generics < 0)
+    return NULL;
+
+  osl_generic_delta* delta;
+  OSL_malloc(delta, osl_generic_delta*, sizeof(osl_generic_delta));
+  delta->nb_generics = nb_generics;
+  delta->source = NULL;
+  delta->added = NULL;
+  osl_error_protect(delta, (osl_error_cleanup_f)osl_generic_delta_free);
+  delta->source = osl_delta_sread_ints(input, nb_generics);
+  for (int i = 0; i < nb_generics; i++) {
+    if (delta->source[i] < 0) {
+      osl_generic* const generic = osl_generic_sread_one(input, registry);
+      if (!generic)
+        OSL_error("unsupported generic in delta");
+      osl_generic_add(&delta->added, generic);
+    }
+  }
+
+  osl_error_unprotect(delta);
+  return delta;
+}
+
+/**
+ * osl_statement_delta_psread internal function:
+ * this function reads a statement delta list from a string complying to
+ * the format printed by osl_statement_delta_sprint.
+ * \param[in,out] input     The input string, updated after what has been
+ *                          read.
+ * \param[in]     registry  The list of known interfaces.
+ * \param[in]     precision The precision of the literal rows.
+ * \return A pointer to the statement delta list that has been read.
+ */
+static osl_statement_delta* osl_statement_delta_psread(
+    char** const input, osl_interface* const registry, const int precision) {
+  osl_statement_delta* head = NULL;
+  osl_statement_delta** last = &head;
+  const int nb_statements = osl_util_read_int(NULL, input);
+
+  for (int i = 0; i < nb_statements; i++) {
+    osl_statement_delta* delta;
+    OSL_malloc(delta, osl_statement_delta*, sizeof(osl_statement_delta));
+    delta->domain = NULL;
+    delta->scattering = NULL;
+    delta->access = NULL;
+    delta->extension = NULL;
+    delta->next = NULL;
+    if (!head)
+      osl_error_protect(delta, (osl_error_cleanup_f)osl_statement_delta_free);
+    *last = delta;
+    last = &delta->next;
+
+    delta->source = osl_util_read_int(NULL, input);
+    delta->domain_changed = osl_util_read_int(NULL, input);
+    if (delta->domain_changed)
+      delta->domain = osl_relation_delta_psread(input, precision);
+
+    delta->scattering_changed = osl_util_read_int(NULL, input);
+    if (delta->scattering_changed)
+      delta->scattering = osl_relation_delta_psread(input, precision);
+
+    delta->access_changed = osl_util_read_int(NULL, input);
+    if (delta->access_changed) {
+      osl_relation_list_delta** last_access = &delta->access;
+      const int nb_accesses = osl_util_read_int(NULL, input);
+      for (int j = 0; j < nb_accesses; j++) {
+        osl_relation_list_delta* access;
+        OSL_malloc(access, osl_relation_list_delta*,
+                   sizeof(osl_relation_list_delta));
+        access->changed = false;
+        access->delta = NULL;
+        access->next = NULL;
+        *last_access = access;
+        last_access = &access->next;
+        access->source = osl_util_read_int(NULL, input);
+        access->changed = osl_util_read_int(NULL, input);
+        if (access->changed)
+          access->delta = osl_relation_delta_psread(input, precision);
+      }
+    }
+
+    delta->extension = osl_generic_delta_psread(input, registry);
+  }
+
+  osl_error_unprotect(head);
+  return head;
+}
+
+/**
+ * osl_interface_delta_psread internal function:
+ * this function reads a target registry from a string complying to the
+ * format printed by osl_interface_delta_sprint. The interfaces are taken
+ * from the list of known interfaces, the unknown URIs are ignored.
+ * \param[in,out] input    The input string, updated after what has been read.
+ * \param[in]     registry The list of known interfaces.
+ * \return The target registry that has been read (NULL if unchanged).
+ */
+static osl_interface* osl_interface_delta_psread(
+    char** const input, osl_interface* const registry) {
+  osl_interface* target = NULL;
+  const int nb_interfaces = osl_util_read_int(NULL, input);
+
+  for (int i = 0; i < nb_interfaces; i++) {
+    char* const URI = osl_util_read_line(NULL, input);
+    osl_interface* const interface = osl_interface_lookup(registry, URI);
+    if (interface && !target) {
+      target = osl_interface_nclone(interface, 1);
+      osl_error_protect(target, (osl_error_cleanup_f)osl_interface_free);
+    } else if (interface) {
+      osl_interface_add(&target, osl_interface_nclone(interface, 1));
+    } else {
+      OSL_warning("unknown interface in delta registry, ignored");
+    }
+    osl_allocator_free(URI);
+  }
+
+  osl_error_unprotect(target);
+  return target;
+}
+
+/**
+ * osl_scop_delta_psread function ("precision read"):
+ * this function reads a list of scop deltas from a string complying to the
+ * format printed by osl_scop_delta_sprint and returns a pointer to this
+ * list. The input parameter is updated to the position in the input string
+ * this function reach right after reading the deltas.
+ * \param[in,out] input     The input string where to find the deltas.
+ *                          Updated to the position after what has been read.
+ * \param[in]     registry  The list of known interfaces (others are ignored).
+ * \param[in]     precision The precision of the literal rows.
+ * \return A pointer to the scop delta list that has been read.
+ */
+osl_scop_delta* osl_scop_delta_psread(char** const input,
+                                      osl_interface* const registry,
+                                      const int precision) {
+  osl_scop_delta* head = NULL;
+  osl_scop_delta** last = &head;
+  char* content;
+
+  while (*input && (content = osl_util_read_uptotag(NULL, input,
+                                                    OSL_URI_SCOP_DELTA))) {
+    osl_allocator_free(content);
+    content = osl_util_read_uptoendtag(NULL, input, OSL_URI_SCOP_DELTA);
+    if (!content)
+      OSL_error("delta end tag not found");
+
+    osl_error_protect(content, osl_allocator_free);
+    char* temp = content;
+    osl_scop_delta* delta;
+    OSL_malloc(delta, osl_scop_delta*, sizeof(osl_scop_delta));
+    delta->language_changed = false;
+    delta->language = NULL;
+    delta->context_changed = false;
+    delta->context = NULL;
+    delta->parameters = NULL;
+    delta->statement = NULL;
+    delta->registry = NULL;
+    delta->extension = NULL;
+    delta->next = NULL;
+    if (!head)
+      osl_error_protect(delta, (osl_error_cleanup_f)osl_scop_delta_free);
+    *last = delta;
+    last = &delta->next;
+
+    delta->version = osl_util_read_int(NULL, &temp);
+    const int nb_languages = osl_util_read_int(NULL, &temp);
+    delta->language_changed = (nb_languages >= 0);
+    if (nb_languages > 0)
+      delta->language = osl_util_read_line(NULL, &temp);
+    delta->context_changed = osl_util_read_int(NULL, &temp);
+    if (delta->context_changed)
+      delta->context = osl_relation_delta_psread(&temp, precision);
+    delta->parameters = osl_generic_delta_psread(&temp, registry);
+    delta->statement = osl_statement_delta_psread(&temp, registry, precision);
+    delta->registry = osl_interface_delta_psread(&temp, registry);
+    delta->extension = osl_generic_delta_psread(&temp, registry);
+    osl_error_unprotect(content);
+    osl_allocator_free(content);
+  }
+
+  osl_error_unprotect(head);
+  return head;
+}
+
+/**
+ * osl_scop_delta_pread function ("precision read"):
+ * this function reads a list of scop deltas from a file (possibly stdin),
+ * see osl_scop_delta_psread.
+ * \param[in] file      The file where to read the deltas.
+ * \param[in] registry  The list of known interfaces (others are ignored).
+ * \param[in] precision The precision of the literal rows.
+ * \return A pointer to the scop delta list that has been read.
+ */
+osl_scop_delta* osl_scop_delta_pread(FILE* const file,
+                                     osl_interface* const registry,
+                                     const int precision) {
+  osl_scop_delta* head = NULL;
+  osl_scop_delta** last = &head;
+  char* content;
+  char buffer[OSL_MAX_STRING];
+
+  while ((content = osl_util_read_uptotag(file, NULL, OSL_URI_SCOP_DELTA))) {
+    osl_allocator_free(content);
+    content = osl_util_read_uptoendtag(file, NULL, OSL_URI_SCOP_DELTA);
+    if (!content)
+      OSL_error("delta end tag not found");
+
+    // Rebuild a complete delta for the string reader.
+    size_t high_water_mark = OSL_MAX_STRING;
+    char* string;
+    OSL_malloc(string, char*, high_water_mark * sizeof(char));
+    snprintf(buffer, OSL_MAX_STRING, "<%s>", OSL_URI_SCOP_DELTA);
+    strcpy(string, buffer);
+    osl_util_safe_strcat(&string, content, &high_water_mark);
+    snprintf(buffer, OSL_MAX_STRING, "</%s>", OSL_URI_SCOP_DELTA);
+    osl_util_safe_strcat(&string, buffer, &high_water_mark);
+    osl_allocator_free(content);
+
+    char* temp = string;
+    osl_error_protect(string, osl_allocator_free);
+    *last = osl_scop_delta_psread(&temp, registry, precision);
+    osl_error_unprotect(string);
+    osl_allocator_free(string);
+    if (*last && (last == &head))
+      osl_error_protect(head, (osl_error_cleanup_f)osl_scop_delta_free);
+    while (*last)
+      last = &(*last)->next;
+  }
+
+  osl_error_unprotect(head);
+  return head;
+}
+
+/**
+ * osl_scop_delta_read function:
+ * this function reads a list of scop deltas from a file (possibly stdin)
+ * with the default registry and precision.
+ * \param[in] file The file where to read the deltas.
+ * \return A pointer to the scop delta list that has been read.
+ */
+osl_scop_delta* osl_scop_delta_read(FILE* const file) {
+  const int precision = osl_util_get_precision();
+  osl_interface* const registry = osl_interface_get_default_registry();
+  osl_scop_delta* const delta = osl_scop_delta_pread(file, registry, precision);
+
+  osl_interface_free(registry);
+  return delta;
+}
+
+/******************************************************************************
+ *                   Memory allocation/deallocation function                  *
+ ******************************************************************************/
+
+/**
+ * osl_relation_delta_free function:
+ * this function frees the allocated memory for an osl_relation_delta
+ * structure (list).
+ * \param[in] delta The pointer to the relation delta we want to free.
+ */
+void osl_relation_delta_free(osl_relation_delta* delta) {
+  while (delta) {
+    osl_relation_delta* const next = delta->next;
+    osl_allocator_free(delta->row);
+    osl_allocator_free(delta->column);
+    osl_relation_free(delta->literal);
+    osl_allocator_free(delta);
+    delta = next;
+  }
+}
+
+/**
+ * osl_relation_list_delta_free internal function:
+ * this function frees the allocated memory for an osl_relation_list_delta
+ * structure (list).
+ * \param[in] delta The pointer to the relation list delta to free.
+ */
+static void osl_relation_list_delta_free(osl_relation_list_delta* delta) {
+  while (delta) {
+    osl_relation_list_delta* const next = delta->next;
+    osl_relation_delta_free(delta->delta);
+    osl_allocator_free(delta);
+    delta = next;
+  }
+}
+
+/**
+ * osl_generic_delta_free internal function:
+ * this function frees the allocated memory for an osl_generic_delta
+ * structure.
+ * \param[in] delta The pointer to the generic delta to free.
+ */
+static void osl_generic_delta_free(osl_generic_delta* const delta) {
+  if (delta) {
+    osl_allocator_free(delta->source);
+    osl_generic_free(delta->added);
+    osl_allocator_free(delta);
+  }
+}
+
+/**
+ * osl_statement_delta_free internal function:
+ * this function frees the allocated memory for an osl_statement_delta
+ * structure (list).
+ * \param[in] delta The pointer to the statement delta to free.
+ */
+static void osl_statement_delta_free(osl_statement_delta* delta) {
+  while (delta) {
+    osl_statement_delta* const next = delta->next;
+    osl_relation_delta_free(delta->domain);
+    osl_relation_delta_free(delta->scattering);
+    osl_relation_list_delta_free(delta->access);
+    osl_generic_delta_free(delta->extension);
+    osl_allocator_free(delta);
+    delta = next;
+  }
+}
+
+/**
+ * osl_scop_delta_free function:
+ * this function frees the allocated memory for an osl_scop_delta
+ * structure (list).
+ * \param[in] delta The pointer to the scop delta we want to free.
+ */
+void osl_scop_delta_free(osl_scop_delta* delta) {
+  while (delta) {
+    osl_scop_delta* const next = delta->next;
+    osl_allocator_free(delta->language);
+    osl_relation_delta_free(delta->context);
+    osl_generic_delta_free(delta->parameters);
+    osl_statement_delta_free(delta->statement);
+    osl_interface_free(delta->registry);
+    osl_generic_delta_free(delta->extension);
+    osl_allocator_free(delta);
+    delta = next;
+  }
+}
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_relation_delta_consistent internal function:
+ * this function returns true if the attributes of a relation describe its
+ * columns (the dimension segments are known and fill the matrix).
+ * \param[in] relation The relation to check.
+ * \return True if the column segments of the relation are known.
+ */
+static bool osl_relation_delta_consistent(const osl_relation* const relation) {
+  return (relation->nb_output_dims >= 0) && (relation->nb_input_dims >= 0) &&
+         (relation->nb_local_dims >= 0) && (relation->nb_parameters >= 0) &&
+         (relation->nb_output_dims + relation->nb_input_dims +
+              relation->nb_local_dims + relation->nb_parameters + 2 ==
+          relation->nb_columns);
+}
+
+/**
+ * osl_relation_delta_segment internal function:
+ * this function maps a segment of target columns to the same segment of
+ * source columns, as far as the source segment goes.
+ * \param[in,out] column The column map to update.
+ * \param[in]     source The first column of the source segment.
+ * \param[in]     target The first column of the target segment.
+ * \param[in]     size   The size of the source segment.
+ * \param[in]     limit  The size of the target segment.
+ */
+static void osl_relation_delta_segment(int* const column, const int source,
+                                       const int target, const int size,
+                                       const int limit) {
+  for (int i = 0; (i < size) && (i < limit); i++)
+    column[target + i] = source + i;
+}
+
+/**
+ * osl_relation_delta_columns internal function:
+ * this function builds the column map from a source relation to a target
+ * relation: the source column of each target column (-1 if none). Columns
+ * are matched by position when the attributes are the same, or segment by
+ * segment (output, input, local dimensions then parameters) when the
+ * dimensions changed, so that adding or removing a dimension keeps the
+ * other columns.
+ * \param[in] source The source relation (may be NULL).
+ * \param[in] target The target relation.
+ * \return A freshly allocated column map of target->nb_columns integers.
+ */
+static int* osl_relation_delta_columns(const osl_relation* const source,
+                                       const osl_relation* const target) {
+  int* column = NULL;
+
+  if (target->nb_columns > 0)
+    OSL_malloc(column, int*, (size_t)target->nb_columns * sizeof(int));
+  for (int i = 0; i < target->nb_columns; i++)
+    column[i] = -1;
+
+  if (!source || (source->precision != target->precision)) {
+    return column;
+  } else if ((source->nb_columns == target->nb_columns) &&
+             (source->nb_output_dims == target->nb_output_dims) &&
+             (source->nb_input_dims == target->nb_input_dims) &&
+             (source->nb_local_dims == target->nb_local_dims) &&
+             (source->nb_parameters == target->nb_parameters)) {
+    for (int i = 0; i < target->nb_columns; i++)
+      column[i] = i;
+  } else if (osl_relation_delta_consistent(source) &&
+             osl_relation_delta_consistent(target)) {
+    int s = 1;
+    int t = 1;
+    column[0] = 0;
+    osl_relation_delta_segment(column, s, t, source->nb_output_dims,
+                               target->nb_output_dims);
+    s += source->nb_output_dims;
+    t += target->nb_output_dims;
+    osl_relation_delta_segment(column, s, t, source->nb_input_dims,
+                               target->nb_input_dims);
+    s += source->nb_input_dims;
+    t += target->nb_input_dims;
+    osl_relation_delta_segment(column, s, t, source->nb_local_dims,
+                               target->nb_local_dims);
+    s += source->nb_local_dims;
+    t += target->nb_local_dims;
+    osl_relation_delta_segment(column, s, t, source->nb_parameters,
+                               target->nb_parameters);
+    column[target->nb_columns - 1] = source->nb_columns - 1;
+  }
+
+  return column;
+}
+
+/**
+ * osl_relation_delta_row_equal internal function:
+ * this function returns true if a target row is the projection of a source
+ * row through a column map (target columns without source are 0).
+ * \param[in] source     The source relation.
+ * \param[in] source_row The source row.
+ * \param[in] target     The target relation.
+ * \param[in] target_row The target row.
+ * \param[in] column     The column map from the source to the target.
+ * \return True if the target row comes from the source row.
+ */
+static bool osl_relation_delta_row_equal(const osl_relation* const source,
+                                         const int source_row,
+                                         const osl_relation* const target,
+                                         const int target_row,
+                                         const int* const column) {
+  const int precision = target->precision;
+
+  for (int j = 0; j < target->nb_columns; j++) {
+    if (column[j] >= 0) {
+      if (osl_int_ne(precision, source->m[source_row][column[j]],
+                     target->m[target_row][j]))
+        return false;
+    } else if (!osl_int_zero(precision, target->m[target_row][j])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * osl_relation_delta_part internal function:
+ * this function builds the delta of a single target union part from a
+ * single source union part (possibly NULL).
+ * \param[in] source The source union part (may be NULL).
+ * \param[in] part   The position of the source part (-1 if none).
+ * \param[in] target The target union part.
+ * \return The delta of the target union part.
+ */
+static osl_relation_delta* osl_relation_delta_part(
+    const osl_relation* const source, const int part,
+    const osl_relation* const target) {
+  osl_relation_delta* delta;
+  int nb_literals = 0;
+
+  OSL_malloc(delta, osl_relation_delta*, sizeof(osl_relation_delta));
+  delta->part = (source && (source->precision == target->precision)) ? part
+                                                                     : -1;
+  delta->nb_rows = target->nb_rows;
+  delta->row = NULL;
+  delta->column = osl_relation_delta_columns(source, target);
+  delta->literal = NULL;
+  delta->next = NULL;
+
+  if (target->nb_rows > 0)
+    OSL_malloc(delta->row, int*, (size_t)target->nb_rows * sizeof(int));
+  for (int i = 0; i < target->nb_rows; i++) {
+    delta->row[i] = -1;
+    if (delta->part >= 0) {
+      // Try the row at the same position first, then any other one.
+      if ((i < source->nb_rows) &&
+          osl_relation_delta_row_equal(source, i, target, i, delta->column)) {
+        delta->row[i] = i;
+      } else {
+        for (int k = 0; k < source->nb_rows; k++) {
+          if (osl_relation_delta_row_equal(source, k, target, i,
+                                           delta->column)) {
+            delta->row[i] = k;
+            break;
+          }
+        }
+      }
+    }
+    if (delta->row[i] < 0)
+      nb_literals++;
+  }
+
+  delta->literal = osl_relation_pmalloc(target->precision, nb_literals,
+                                        target->nb_columns);
+  delta->literal->type = target->type;
+  delta->literal->nb_output_dims = target->nb_output_dims;
+  delta->literal->nb_input_dims = target->nb_input_dims;
+  delta->literal->nb_local_dims = target->nb_local_dims;
+  delta->literal->nb_parameters = target->nb_parameters;
+  for (int i = 0, k = 0; i < target->nb_rows; i++) {
+    if (delta->row[i] < 0) {
+      for (int j = 0; j < target->nb_columns; j++)
+        osl_int_assign(target->precision, &delta->literal->m[k][j],
+                       target->m[i][j]);
+      k++;
+    }
+  }
+
+  return delta;
+}
+
+/**
+ * osl_relation_diff function:
+ * this function builds the delta describing a target relation union from a
+ * source relation union (see the osl_relation_delta structure). Each target
+ * union part is described from the source part at the same position, as
+ * kept rows (possibly with inserted or removed columns) and literal rows.
+ * \param[in] source The source relation union (may be NULL).
+ * \param[in] target The target relation union (may be NULL).
+ * \return The delta from the source to the target (NULL for a NULL target).
+ */
+osl_relation_delta* osl_relation_diff(const osl_relation* source,
+                                      const osl_relation* target) {
+  osl_relation_delta* head = NULL;
+  osl_relation_delta** last = &head;
+
+  for (int part = 0; target; target = target->next, part++) {
+    *last = osl_relation_delta_part(source, part, target);
+    last = &(*last)->next;
+    if (source)
+      source = source->next;
+  }
+
+  return head;
+}
+
+/**
+ * osl_relation_patch function:
+ * this function builds the target relation union described by a delta
+ * from its source relation union (see osl_relation_diff). It reports an
+ * error if the delta does not match the source.
+ * \param[in] source The source relation union (may be NULL).
+ * \param[in] delta  The delta from the source to the target.
+ * \return A freshly allocated target relation union.
+ */
+osl_relation* osl_relation_patch(const osl_relation* const source,
+                                 const osl_relation_delta* delta) {
+  osl_relation* head = NULL;
+  osl_relation* last = NULL;
+
+  for (; delta; delta = delta->next) {
+    const osl_relation* const literal = delta->literal;
+    const int precision = literal->precision;
+    const osl_relation* part = source;
+    for (int i = 0; part && (i < delta->part); i++)
+      part = part->next;
+    if ((delta->part >= 0) && !part)
+      OSL_error("delta does not match the source relation");
+
+    osl_relation* const relation =
+        osl_relation_pmalloc(precision, delta->nb_rows, literal->nb_columns);
+    relation->type = literal->type;
+    relation->nb_output_dims = literal->nb_output_dims;
+    relation->nb_input_dims = literal->nb_input_dims;
+    relation->nb_local_dims = literal->nb_local_dims;
+    relation->nb_parameters = literal->nb_parameters;
+    if (last)
+      last->next = relation;
+    else
+      head = relation;
+    last = relation;
+
+    for (int i = 0, k = 0; i < delta->nb_rows; i++) {
+      const int row = delta->row[i];
+      if (row < 0) {
+        if (k >= literal->nb_rows)
+          OSL_error("delta does not match the source relation");
+        for (int j = 0; j < literal->nb_columns; j++)
+          osl_int_assign(precision, &relation->m[i][j], literal->m[k][j]);
+        k++;
+        continue;
+      }
+
+      if (!part || (row >= part->nb_rows))
+        OSL_error("delta does not match the source relation");
+      for (int j = 0; j < literal->nb_columns; j++) {
+        const int column = delta->column[j];
+        if (column < 0)
+          continue;
+        if (column >= part->nb_columns)
+          OSL_error("delta does not match the source relation");
+        osl_int value;
+        osl_int_init_set(part->precision, &value, part->m[row][column]);
+        osl_int_set_precision(part->precision, precision, &value);
+        osl_int_assign(precision, &relation->m[i][j], value);
+        osl_int_clear(precision, &value);
+      }
+    }
+  }
+
+  return head;
+}
+
+/**
+ * osl_relation_list_diff internal function:
+ * this function builds the delta describing a target relation list from a
+ * source relation list. Elements are paired by position.
+ * \param[in] source The source relation list.
+ * \param[in] target The target relation list.
+ * \return The delta from the source to the target.
+ */
+static osl_relation_list_delta* osl_relation_list_diff(
+    const osl_relation_list* source, const osl_relation_list* target) {
+  osl_relation_list_delta* head = NULL;
+  osl_relation_list_delta** last = &head;
+
+  for (int i = 0; target; target = target->next, i++) {
+    osl_relation_list_delta* delta;
+    OSL_malloc(delta, osl_relation_list_delta*,
+               sizeof(osl_relation_list_delta));
+    delta->source = source ? i : -1;
+    delta->changed = !source || !osl_relation_equal(source->elt, target->elt);
+    delta->delta = NULL;
+    delta->next = NULL;
+    if (delta->changed)
+      delta->delta = osl_relation_diff(source ? source->elt : NULL,
+                                       target->elt);
+    *last = delta;
+    last = &delta->next;
+    if (source)
+      source = source->next;
+  }
+
+  return head;
+}
+
+/**
+ * osl_relation_list_patch internal function:
+ * this function builds the target relation list described by a delta from
+ * its source relation list.
+ * \param[in] source The source relation list.
+ * \param[in] delta  The delta from the source to the target.
+ * \return A freshly allocated target relation list.
+ */
+static osl_relation_list* osl_relation_list_patch(
+    const osl_relation_list* const source,
+    const osl_relation_list_delta* delta) {
+  osl_relation_list* head = NULL;
+  osl_relation_list* last = NULL;
+
+  for (; delta; delta = delta->next) {
+    const osl_relation_list* element = NULL;
+    if (delta->source >= 0) {
+      element = source;
+      for (int i = 0; element && (i < delta->source); i++)
+        element = element->next;
+      if (!element)
+        OSL_error("delta does not match the source access list");
+    } else if (!delta->changed) {
+      OSL_error("delta does not match the source access list");
+    }
+
+    osl_relation_list* const node = osl_relation_list_malloc();
+    if (delta->changed)
+      node->elt = osl_relation_patch(element ? element->elt : NULL,
+                                     delta->delta);
+    else
+      node->elt = osl_relation_clone(element->elt);
+    if (last)
+      last->next = node;
+    else
+      head = node;
+    last = node;
+  }
+
+  return head;
+}
+
+/**
+ * osl_generic_delta_equal_one internal function:
+ * this function returns true if two generic nodes (and not the lists they
+ * start) have the same interface and the same content.
+ * \param[in] x1 The first generic node.
+ * \param[in] x2 The second generic node.
+ * \return True if both generic nodes are equal.
+ */
+static bool osl_generic_delta_equal_one(const osl_generic* const x1,
+                                        const osl_generic* const x2) {
+  return x1->interface && x2->interface &&
+         osl_interface_equal(x1->interface, x2->interface) &&
+         x1->interface->equal(x1->data, x2->data);
+}
+
+/**
+ * osl_generic_delta_nodes internal function:
+ * this function returns an array of the generic nodes of a list which have
+ * an interface (the other ones cannot be compared nor printed).
+ * \param[in]  list The generic list.
+ * \param[out] size The number of nodes in the array.
+ * \return A freshly allocated array of generic nodes (NULL if none).
+ */
+static const osl_generic** osl_generic_delta_nodes(const osl_generic* list,
+                                                   int* const size) {
+  const osl_generic** nodes = NULL;
+
+  *size = 0;
+  for (const osl_generic* x = list; x; x = x->next)
+    if (x->interface)
+      (*size)++;
+
+  if (*size > 0) {
+    OSL_malloc(nodes, const osl_generic**,
+               (size_t)*size * sizeof(osl_generic*));
+    for (int i = 0; list; list = list->next)
+      if (list->interface)
+        nodes[i++] = list;
+  }
+
+  return nodes;
+}
+
+/**
+ * osl_generic_diff internal function:
+ * this function builds the delta describing a target generic list from a
+ * source generic list: each target generic is paired with an equal source
+ * generic (at the same position first) or is new.
+ * \param[in] source The source generic list.
+ * \param[in] target The target generic list.
+ * \return The delta from the source to the target (NULL if unchanged).
+ */
+static osl_generic_delta* osl_generic_diff(const osl_generic* const source,
+                                           const osl_generic* const target) {
+  if (osl_generic_equal(source, target))
+    return NULL;
+
+  int nb_sources;
+  const osl_generic** const sources =
+      osl_generic_delta_nodes(source, &nb_sources);
+  int nb_targets;
+  const osl_generic** const targets =
+      osl_generic_delta_nodes(target, &nb_targets);
+  osl_generic_delta* delta;
+
+  OSL_malloc(delta, osl_generic_delta*, sizeof(osl_generic_delta));
+  delta->nb_generics = nb_targets;
+  delta->source = NULL;
+  delta->added = NULL;
+  if (nb_targets > 0)
+    OSL_malloc(delta->source, int*, (size_t)nb_targets * sizeof(int));
+
+  for (int i = 0; i < nb_targets; i++) {
+    delta->source[i] = -1;
+    if ((i < nb_sources) &&
+        osl_generic_delta_equal_one(sources[i], targets[i])) {
+      delta->source[i] = i;
+    } else {
+      for (int k = 0; k < nb_sources; k++) {
+        if (osl_generic_delta_equal_one(sources[k], targets[i])) {
+          delta->source[i] = k;
+          break;
+        }
+      }
+    }
+    if (delta->source[i] < 0)
+      osl_generic_add(&delta->added, osl_generic_nclone(targets[i], 1));
+  }
+
+  osl_allocator_free(sources);
+  osl_allocator_free(targets);
+  return delta;
+}
+
+/**
+ * osl_generic_patch internal function:
+ * this function builds the target generic list described by a delta from
+ * its source generic list.
+ * \param[in] source The source generic list.
+ * \param[in] delta  The delta from the source to the target (NULL if
+ *                   unchanged).
+ * \return A freshly allocated target generic list.
+ */
+static osl_generic* osl_generic_patch(const osl_generic* const source,
+                                      const osl_generic_delta* const delta) {
+  if (!delta)
+    return osl_generic_clone(source);
+
+  int nb_sources;
+  const osl_generic** const sources =
+      osl_generic_delta_nodes(source, &nb_sources);
+  const osl_generic* added = delta->added;
+  osl_generic* head = NULL;
+
+  for (int i = 0; i < delta->nb_generics; i++) {
+    const osl_generic* node = NULL;
+    if (delta->source[i] < 0) {
+      node = added;
+      if (added)
+        added = added->next;
+    } else if (delta->source[i] < nb_sources) {
+      node = sources[delta->source[i]];
+    }
+    if (!node)
+      OSL_error("delta does not match the source generics");
+    osl_generic_add(&head, osl_generic_nclone(node, 1));
+  }
+
+  osl_allocator_free(sources);
+  return head;
+}
+
+/**
+ * osl_statement_diff internal function:
+ * this function builds the delta describing a target statement list from a
+ * source statement list. Statements are paired by position and each part
+ * of a statement is described only when it changed.
+ * \param[in] source The source statement list.
+ * \param[in] target The target statement list.
+ * \return The delta from the source to the target.
+ */
+static osl_statement_delta* osl_statement_diff(const osl_statement* source,
+                                               const osl_statement* target) {
+  osl_statement_delta* head = NULL;
+  osl_statement_delta** last = &head;
+
+  for (int i = 0; target; target = target->next, i++) {
+    osl_statement_delta* delta;
+    OSL_malloc(delta, osl_statement_delta*, sizeof(osl_statement_delta));
+    delta->source = source ? i : -1;
+    delta->domain = NULL;
+    delta->scattering = NULL;
+    delta->access = NULL;
+    delta->next = NULL;
+
+    delta->domain_changed =
+        !source || !osl_relation_equal(source->domain, target->domain);
+    if (delta->domain_changed)
+      delta->domain =
+          osl_relation_diff(source ? source->domain : NULL, target->domain);
+
+    delta->scattering_changed =
+        !source || !osl_relation_equal(source->scattering, target->scattering);
+    if (delta->scattering_changed)
+      delta->scattering = osl_relation_diff(
+          source ? source->scattering : NULL, target->scattering);
+
+    delta->access_changed =
+        !source || !osl_relation_list_equal(source->access, target->access);
+    if (delta->access_changed)
+      delta->access = osl_relation_list_diff(source ? source->access : NULL,
+                                             target->access);
+
+    delta->extension = osl_generic_diff(source ? source->extension : NULL,
+                                        target->extension);
+
+    *last = delta;
+    last = &delta->next;
+    if (source)
+      source = source->next;
+  }
+
+  return head;
+}
+
+/**
+ * osl_statement_patch internal function:
+ * this function builds the target statement list described by a delta
+ * from its source statement list.
+ * \param[in] source The source statement list.
+ * \param[in] delta  The delta from the source to the target.
+ * \return A freshly allocated target statement list.
+ */
+static osl_statement* osl_statement_patch(const osl_statement* const source,
+                                          const osl_statement_delta* delta) {
+  osl_statement_index* const index = osl_statement_index_build(source);
+  osl_statement* head = NULL;
+  osl_statement* last = NULL;
+
+  for (; delta; delta = delta->next) {
+    const osl_statement* s = NULL;
+    if (delta->source >= 0) {
+      s = osl_statement_index_get(index, delta->source);
+      if (!s)
+        OSL_error("delta does not match the source statements");
+    } else if (!delta->domain_changed || !delta->scattering_changed ||
+               !delta->access_changed) {
+      OSL_error("delta does not match the source statements");
+    }
+
+    osl_statement* const statement = osl_statement_malloc();
+    statement->domain = delta->domain_changed
+                            ? osl_relation_patch(s ? s->domain : NULL,
+                                                 delta->domain)
+                            : osl_relation_clone(s->domain);
+    statement->scattering = delta->scattering_changed
+                                ? osl_relation_patch(s ? s->scattering : NULL,
+                                                     delta->scattering)
+                                : osl_relation_clone(s->scattering);
+    statement->access = delta->access_changed
+                            ? osl_relation_list_patch(s ? s->access : NULL,
+                                                      delta->access)
+                            : osl_relation_list_clone(s->access);
+    statement->extension =
+        osl_generic_patch(s ? s->extension : NULL, delta->extension);
+    if (last)
+      last->next = statement;
+    else
+      head = statement;
+    last = statement;
+  }
+
+  osl_statement_index_free(index);
+  return head;
+}
+
+/**
+ * osl_scop_diff function:
+ * this function builds the delta describing a target scop list from a
+ * source scop list (see the osl_scop_delta structure). Scops and their
+ * statements are paired by position. Only the changed parts are described,
+ * down to the rows and columns of the changed relations, so that the delta
+ * may be stored instead of the target (e.g., in a compilation cache) and
+ * the target rebuilt with osl_scop_patch.
+ * \param[in] source The source scop list.
+ * \param[in] target The target scop list.
+ * \return The delta from the source to the target.
+ */
+osl_scop_delta* osl_scop_diff(const osl_scop* source, const osl_scop* target) {
+  osl_scop_delta* head = NULL;
+  osl_scop_delta** last = &head;
+
+  for (; target; target = target->next) {
+    osl_scop_delta* delta;
+    OSL_malloc(delta, osl_scop_delta*, sizeof(osl_scop_delta));
+    delta->version = target->version;
+    delta->language = NULL;
+    delta->context = NULL;
+    delta->registry = NULL;
+    delta->next = NULL;
+
+    delta->language_changed =
+        !source || (!source->language != !target->language) ||
+        (source->language && strcmp(source->language, target->language));
+    if (delta->language_changed && target->language)
+      OSL_strdup(delta->language, target->language);
+
+    delta->context_changed =
+        !source || !osl_relation_equal(source->context, target->context);
+    if (delta->context_changed)
+      delta->context =
+          osl_relation_diff(source ? source->context : NULL, target->context);
+
+    delta->parameters = osl_generic_diff(source ? source->parameters : NULL,
+                                         target->parameters);
+    delta->statement = osl_statement_diff(source ? source->statement : NULL,
+                                          target->statement);
+    if (!source || !osl_interface_equal(source->registry, target->registry))
+      delta->registry = osl_interface_clone(target->registry);
+    delta->extension = osl_generic_diff(source ? source->extension : NULL,
+                                        target->extension);
+
+    *last = delta;
+    last = &delta->next;
+    if (source)
+      source = source->next;
+  }
+
+  return head;
+}
+
+/**
+ * osl_scop_patch function:
+ * this function builds the target scop list described by a delta from its
+ * source scop list (see osl_scop_diff). It reports an error if the delta
+ * does not match the source.
+ * \param[in] source The source scop list.
+ * \param[in] delta  The delta from the source to the target.
+ * \return A freshly allocated target scop list.
+ */
+osl_scop* osl_scop_patch(const osl_scop* source,
+                         const osl_scop_delta* delta) {
+  osl_scop* head = NULL;
+  osl_scop* last = NULL;
+
+  for (; delta; delta = delta->next) {
+    osl_scop* const scop = osl_scop_malloc();
+    scop->version = delta->version;
+    const char* const language =
+        delta->language_changed ? delta->language
+                                : (source ? source->language : NULL);
+    if (language)
+      OSL_strdup(scop->language, language);
+    if (delta->context_changed)
+      scop->context =
+          osl_relation_patch(source ? source->context : NULL, delta->context);
+    else if (source)
+      scop->context = osl_relation_clone(source->context);
+    scop->parameters =
+        osl_generic_patch(source ? source->parameters : NULL,
+                          delta->parameters);
+    scop->statement = osl_statement_patch(source ? source->statement : NULL,
+                                          delta->statement);
+    if (delta->registry)
+      scop->registry = osl_interface_clone(delta->registry);
+    else if (source)
+      scop->registry = osl_interface_clone(source->registry);
+    scop->extension =
+        osl_generic_patch(source ? source->extension : NULL, delta->extension);
+
+    if (last)
+      last->next = scop;
+    else
+      head = scop;
+    last = scop;
+    if (source)
+      source = source->next;
+  }
+
+  return head;
+}
@@ -0,0 +1,264 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                 error.c                                  **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <osl/error.h>
+#include <osl/macros.h>
+
+/**
+ * An osl_error_context is the state of a pending osl_error_try: where to
+ * jump back when an error is raised, and which part of the cleanup stack
+ * belongs to the operation it runs.
+ */
+struct osl_error_context {
+  jmp_buf env;                       /**< Where to resume on error */
+  size_t nb_cleanups;                /**< Cleanup stack size on entry */
+  struct osl_error_context* previous; /**< Enclosing pending try */
+};
+
+/**
+ * An osl_error_cleanup is an object of the partial state of the running
+ * operation, with the function to free it if that operation fails.
+ */
+struct osl_error_cleanup {
+  void* object;                /**< Object to free on error */
+  osl_error_cleanup_f cleanup; /**< Function to free the object */
+};
+
+/**
+ * Error state. It is thread-local: each thread has its own handler, pending
+ * tries and cleanup stack.
+ */
+static _Thread_local struct {
+  osl_error_handler_f handler;       /**< User handler (NULL for default) */
+  void* user;                        /**< User data for the handler */
+  struct osl_error_context* context; /**< Innermost pending try */
+  struct osl_error_cleanup* cleanup; /**< Cleanup stack */
+  size_t nb_cleanups;                /**< Number of objects in the stack */
+  size_t max_cleanups;               /**< Capacity of the stack */
+  char message[OSL_MAX_STRING];      /**< Last error message */
+} osl_error_state;
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_error_release function:
+ * this function frees the cleanup stack of the calling thread once no try
+ * is pending any more.
+ */
+static void osl_error_release(void) {
+  if (!osl_error_state.context) {
+    osl_allocator_free(osl_error_state.cleanup);
+    osl_error_state.cleanup = NULL;
+    osl_error_state.nb_cleanups = 0;
+    osl_error_state.max_cleanups = 0;
+  }
+}
+
+/**
+ * osl_error_set_handler function:
+ * this function sets the function called each time the library reports an
+ * error in the calling thread (with the error message, the name of the
+ * function where the error occurred and the user pointer). The default
+ * handler (handler set to NULL) prints the message on the standard error
+ * output. If the handler returns, the pending osl_error_try (if any) fails,
+ * otherwise the program exits.
+ * \param[in] handler The error handler (NULL for the default one).
+ * \param[in] user    A user pointer passed to the handler.
+ */
+void osl_error_set_handler(const osl_error_handler_f handler,
+                           void* const user) {
+  osl_error_state.handler = handler;
+  osl_error_state.user = user;
+}
+
+/**
+ * osl_error_raise function:
+ * this function reports an error (it is the function behind OSL_error).
+ * It calls the error handler, then, if an osl_error_try is pending, it frees
+ * the objects protected since this try started and makes it fail. Otherwise
+ * it exits the program.
+ * \param[in] message  The error message.
+ * \param[in] function The name of the function where the error occurred.
+ */
+void osl_error_raise(const char* const message, const char* const function) {
+  snprintf(osl_error_state.message, OSL_MAX_STRING, "%s (%s)", message,
+           function);
+
+  if (osl_error_state.handler)
+    osl_error_state.handler(message, function, osl_error_state.user);
+  else
+    fprintf(stderr, "[osl] Error: %s.\n", osl_error_state.message);
+
+  struct osl_error_context* const context = osl_error_state.context;
+  if (!context)
+    exit(1);
+
+  // Unwind: free the partial state, most recent objects first.
+  while (osl_error_state.nb_cleanups > context->nb_cleanups) {
+    const struct osl_error_cleanup cleanup =
+        osl_error_state.cleanup[--osl_error_state.nb_cleanups];
+    cleanup.cleanup(cleanup.object);
+  }
+
+  osl_error_state.context = context->previous;
+  longjmp(context->env, 1);
+}
+
+/**
+ * osl_error_try function:
+ * this function runs an operation (body) such that errors reported during
+ * this operation make it stop instead of exiting the program. In that case
+ * the objects protected by the operation (see osl_error_protect) are freed
+ * and the error message is available through osl_error_message. Tries may
+ * be nested.
+ * \param[in] body The operation to run.
+ * \param[in] data The argument of the operation.
+ * \return true if the operation succeeded, false if an error occurred.
+ */
+bool osl_error_try(const osl_error_body_f body, void* const data) {
+  struct osl_error_context context;
+
+  context.nb_cleanups = osl_error_state.nb_cleanups;
+  context.previous = osl_error_state.context;
+  osl_error_state.context = &context;
+
+  if (setjmp(context.env)) {
+    osl_error_release();
+    return false;
+  }
+
+  body(data);
+
+  // Objects left protected belong to the result of the operation.
+  osl_error_state.nb_cleanups = context.nb_cleanups;
+  osl_error_state.context = context.previous;
+  osl_error_release();
+  return true;
+}
+
+/**
+ * osl_error_message function:
+ * this function returns the message of the last error reported in the
+ * calling thread.
+ * \return The last error message (an empty string if none).
+ */
+const char* osl_error_message(void) {
+  return osl_error_state.message;
+}
+
+/**
+ * osl_error_protect function:
+ * this function registers an object of the partial state of the running
+ * operation: if an error interrupts this operation, the cleanup function
+ * is called on the object. Outside of osl_error_try, it does nothing.
+ * \param[in] object  The object to free on error (nothing is done if NULL).
+ * \param[in] cleanup The function to free the object.
+ */
+void osl_error_protect(void* const object, const osl_error_cleanup_f cleanup) {
+  if (!osl_error_state.context || !object)
+    return;
+
+  if (osl_error_state.nb_cleanups == osl_error_state.max_cleanups) {
+    const size_t max = OSL_max(2 * osl_error_state.max_cleanups, 16);
+    struct osl_error_cleanup* const stack = osl_allocator_realloc(
+        osl_error_state.cleanup, max * sizeof(struct osl_error_cleanup));
+    if (!stack) {
+      // The object would leak: free it before reporting the error.
+      cleanup(object);
+      OSL_error("memory overflow");
+    }
+    osl_error_state.cleanup = stack;
+    osl_error_state.max_cleanups = max;
+  }
+
+  osl_error_state.cleanup[osl_error_state.nb_cleanups].object = object;
+  osl_error_state.cleanup[osl_error_state.nb_cleanups].cleanup = cleanup;
+  osl_error_state.nb_cleanups++;
+}
+
+/**
+ * osl_error_unprotect function:
+ * this function unregisters an object (see osl_error_protect), typically
+ * because it has been freed or because its ownership has been transferred
+ * to another (protected) object.
+ * \param[in] object The object not to free on error any more.
+ */
+void osl_error_unprotect(const void* const object) {
+  const struct osl_error_context* const context = osl_error_state.context;
+  if (!context || !object)
+    return;
+
+  size_t i = osl_error_state.nb_cleanups;
+  while (i > context->nb_cleanups) {
+    i--;
+    if (osl_error_state.cleanup[i].object == object) {
+      for (; i + 1 < osl_error_state.nb_cleanups; i++)
+        osl_error_state.cleanup[i] = osl_error_state.cleanup[i + 1];
+      osl_error_state.nb_cleanups--;
+      return;
+    }
+  }
+}
@@ -93,11 +93,12 @@ int osl_annotation_text_append(osl_annotation_text* const text,
                                const int line_type, char* const line) {
   const size_t count = text->count + 1;
 
-  char** const lines = realloc(text->lines, count * sizeof *lines);
+  char** const lines =
+      osl_allocator_realloc(text->lines, count * sizeof *lines);
   if (!lines)
     return 1;
 
-  int* const types = realloc(text->types, count * sizeof *types);
+  int* const types = osl_allocator_realloc(text->types, count * sizeof *types);
   if (!types)
     return 1;
 
@@ -169,7 +170,7 @@ osl_annotation_text osl_annotation_text_clone(
       .lines = 0,
   };
   for (size_t i = 0; i < source->count; ++i) {
-    char* const line = strdup(source->lines[i]);
+    char* const line = osl_util_strdup(source->lines[i]);
     osl_annotation_text_append(&destination, source->types[i], line);
   }
   return destination;
@@ -185,12 +186,12 @@ void osl_annotation_text_clean(osl_annotation_text* text) {
   if (text->lines) {
     for (size_t i = 0; i < text->count; ++i) {
       if (text->lines[i])
-        free(text->lines[i]);
+        osl_allocator_free(text->lines[i]);
     }
-    free(text->lines);
+    osl_allocator_free(text->lines);
   }
   if (text->types) {
-    free(text->types);
+    osl_allocator_free(text->types);
   }
 }
 
@@ -307,11 +308,13 @@ osl_annotation* osl_annotation_sread(char** const input) {
   }
 
   osl_annotation* const output = osl_annotation_malloc();
+  osl_error_protect(output, (osl_error_cleanup_f)osl_annotation_free);
   osl_annotation_text_sread(&output->prefix, input);
   osl_annotation_text_sread(&output->suffix, input);
   osl_annotation_text_sread(&output->prelude, input);
   osl_annotation_text_sread(&output->postlude, input);
 
+  osl_error_unprotect(output);
   return output;
 }
 
@@ -320,7 +323,7 @@ osl_annotation* osl_annotation_sread(char** const input) {
  ******************************************************************************/
 
 osl_annotation* osl_annotation_malloc(void) {
-  osl_annotation* const annotation = malloc(sizeof *annotation);
+  osl_annotation* const annotation = osl_allocator_malloc(sizeof *annotation);
   if (!annotation) {
     fprintf(stderr, "[osl] Error: memory overflow (%s).\n", __func__);
     exit(1);
@@ -339,7 +342,7 @@ void osl_annotation_free(osl_annotation* annotation) {
   osl_annotation_text_clean(&annotation->suffix);
   osl_annotation_text_clean(&annotation->prelude);
   osl_annotation_text_clean(&annotation->postlude);
-  free(annotation);
+  osl_allocator_free(annotation);
 }
 
 /*****************************************************************************
@@ -396,6 +399,28 @@ bool osl_annotation_equal(const osl_annotation* const r1,
   return equal;
 }
 
+static void osl_annotation_text_memory_usage(const osl_annotation_text* text,
+                                             osl_memory_usage* const usage) {
+  if (text->count > 0) {
+    osl_memory_usage_add(usage, &usage->structures, text->count * sizeof(int));
+    osl_memory_usage_add(usage, &usage->strings, text->count * sizeof(char*));
+    for (size_t i = 0; i < text->count; ++i)
+      osl_memory_usage_string(usage, text->lines[i]);
+  }
+}
+
+void osl_annotation_memory_usage(const osl_annotation* const annotation,
+                                 osl_memory_usage* const usage) {
+  if (!annotation)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_annotation));
+  osl_annotation_text_memory_usage(&annotation->prefix, usage);
+  osl_annotation_text_memory_usage(&annotation->suffix, usage);
+  osl_annotation_text_memory_usage(&annotation->prelude, usage);
+  osl_annotation_text_memory_usage(&annotation->postlude, usage);
+}
+
 osl_interface* osl_annotation_interface(void) {
   osl_interface* const interface = osl_interface_malloc();
 
@@ -408,6 +433,7 @@ osl_interface* osl_annotation_interface(void) {
   interface->free = (osl_free_f)osl_annotation_free;
   interface->clone = (osl_clone_f)osl_annotation_clone;
   interface->equal = (osl_equal_f)osl_annotation_equal;
+  interface->size = (osl_size_f)osl_annotation_memory_usage;
 
   return interface;
 }
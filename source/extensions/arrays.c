@@ -187,6 +187,7 @@ osl_arrays* osl_arrays_sread(char** input) {
   arrays->nb_names = nb_names;
   for (int i = 0; i < nb_names; i++)
     arrays->names[i] = NULL;
+  osl_error_protect(arrays, (osl_error_cleanup_f)osl_arrays_free);
 
   // Get each array id/name.
   for (int k = 0; k < nb_names; k++) {
@@ -197,6 +198,7 @@ osl_arrays* osl_arrays_sread(char** input) {
     arrays->names[k] = osl_util_read_string(NULL, input);
   }
 
+  osl_error_unprotect(arrays);
   return arrays;
 }
 
@@ -219,6 +221,7 @@ osl_arrays* osl_arrays_malloc(void) {
   arrays->nb_names = 0;
   arrays->id = NULL;
   arrays->names = NULL;
+  arrays->index = NULL;
 
   return arrays;
 }
@@ -230,14 +233,143 @@ osl_arrays* osl_arrays_malloc(void) {
  */
 void osl_arrays_free(osl_arrays* const arrays) {
   if (arrays) {
-    free(arrays->id);
+    osl_allocator_free(arrays->id);
     for (int i = 0; i < arrays->nb_names; i++)
-      free(arrays->names[i]);
-    free(arrays->names);
-    free(arrays);
+      osl_allocator_free(arrays->names[i]);
+    osl_allocator_free(arrays->names);
+    osl_arrays_invalidate(arrays);
+    osl_allocator_free(arrays);
   }
 }
 
+/**
+ * osl_arrays_id_hash internal function:
+ * this function returns the hash of an array identifier.
+ * \param[in] id The identifier to hash.
+ * \return The hash of the identifier.
+ */
+static size_t osl_arrays_id_hash(const int id) {
+  return (size_t)((unsigned int)id * 2654435761u);
+}
+
+/**
+ * osl_arrays_index_insert internal function:
+ * this function records the identifier and the name at a given position of
+ * the indexed arrays in the hash index. Equal keys are placed after the
+ * previous ones, hence the lookups find their first position.
+ * \param[in,out] index    The hash index.
+ * \param[in]     position The position of the identifier and the name.
+ */
+static void osl_arrays_index_insert(osl_arrays_index* const index,
+                                    const int position) {
+  const size_t mask = index->nb_buckets - 1;
+  size_t bucket = osl_arrays_id_hash(index->id[position]) & mask;
+
+  while (index->by_id[bucket])
+    bucket = (bucket + 1) & mask;
+  index->by_id[bucket] = position + 1;
+
+  bucket = osl_util_hash(index->names[position]) & mask;
+  while (index->by_name[bucket])
+    bucket = (bucket + 1) & mask;
+  index->by_name[bucket] = position + 1;
+}
+
+/**
+ * osl_arrays_index_rehash internal function:
+ * this function rebuilds the buckets of a hash index with a new number of
+ * buckets.
+ * \param[in,out] index      The hash index.
+ * \param[in]     nb_buckets The new number of buckets (a power of two).
+ */
+static void osl_arrays_index_rehash(osl_arrays_index* const index,
+                                    const size_t nb_buckets) {
+  osl_allocator_free(index->by_id);
+  osl_allocator_free(index->by_name);
+  index->nb_buckets = nb_buckets;
+  OSL_malloc(index->by_id, int*, nb_buckets * sizeof(int));
+  OSL_malloc(index->by_name, int*, nb_buckets * sizeof(int));
+  for (size_t i = 0; i < nb_buckets; i++) {
+    index->by_id[i] = 0;
+    index->by_name[i] = 0;
+  }
+
+  for (int i = 0; i < index->nb_names; i++)
+    osl_arrays_index_insert(index, i);
+}
+
+/**
+ * osl_arrays_index_free internal function:
+ * this function frees the memory of a hash index over an arrays structure.
+ * \param[in] index The hash index to free.
+ */
+static void osl_arrays_index_free(osl_arrays_index* const index) {
+  if (index) {
+    osl_allocator_free(index->by_id);
+    osl_allocator_free(index->by_name);
+    osl_allocator_free(index);
+  }
+}
+
+/**
+ * osl_arrays_index_build internal function:
+ * this function builds a hash index over the identifiers and the names of
+ * an arrays structure.
+ * \param[in] arrays The arrays structure to index.
+ * \return The hash index of the arrays structure.
+ */
+static osl_arrays_index* osl_arrays_index_build(
+    const osl_arrays* const arrays) {
+  osl_arrays_index* index;
+
+  OSL_malloc(index, osl_arrays_index*, sizeof(osl_arrays_index));
+  index->id = arrays->id;
+  index->names = arrays->names;
+  index->nb_names = arrays->nb_names;
+  index->capacity = arrays->nb_names;
+  index->by_id = NULL;
+  index->by_name = NULL;
+
+  size_t nb_buckets = 16;
+  while (nb_buckets < 2 * (size_t)index->nb_names)
+    nb_buckets *= 2;
+  osl_arrays_index_rehash(index, nb_buckets);
+
+  return index;
+}
+
+/**
+ * osl_arrays_cached_index internal function:
+ * this function returns the hash index of an arrays structure, built on the
+ * first call, or NULL if it is outdated, i.e., if the identifier or name
+ * arrays have been replaced or resized without going through
+ * osl_arrays_add. The index is published atomically, hence this function
+ * may be called concurrently on the same arrays structure.
+ * \param[in] arrays The arrays structure whose index is required.
+ * \return The up to date index of the arrays structure, NULL if outdated.
+ */
+static osl_arrays_index* osl_arrays_cached_index(
+    const osl_arrays* const arrays) {
+  osl_arrays_index** const cache = &((osl_arrays*)arrays)->index;
+  osl_arrays_index* index = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+
+  if (!index) {
+    osl_arrays_index* const built = osl_arrays_index_build(arrays);
+    if (__atomic_compare_exchange_n(cache, &index, built, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      index = built;
+    } else {
+      osl_arrays_index_free(built);
+    }
+  }
+
+  if ((index->id != arrays->id) || (index->names != arrays->names) ||
+      (index->nb_names != arrays->nb_names))
+    return NULL;
+
+  return index;
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
@@ -336,7 +468,7 @@ osl_strings* osl_arrays_to_strings(const osl_arrays* const arrays) {
   // Build a strings structure for this number of ids.
   osl_strings* const strings = osl_strings_generate("Dummy", max_id);
   for (int i = 0; i < arrays->nb_names; i++) {
-    free(strings->string[arrays->id[i] - 1]);
+    osl_allocator_free(strings->string[arrays->id[i] - 1]);
     OSL_strdup(strings->string[arrays->id[i] - 1], arrays->names[i]);
   }
 
@@ -356,13 +488,32 @@ int osl_arrays_add(osl_arrays* const arrays, int id, const char* const name) {
   if (!arrays || !name)
     return -1;
 
-  OSL_realloc(arrays->id, int*, (size_t)(arrays->nb_names + 1) * sizeof(int));
-  OSL_realloc(arrays->names, char**,
-              (size_t)(arrays->nb_names + 1) * sizeof(char*));
+  osl_arrays_index* index = osl_arrays_cached_index(arrays);
+  if (!index) {
+    osl_arrays_invalidate(arrays);
+    index = osl_arrays_cached_index(arrays);
+  }
+
+  // Grow the arrays geometrically, the index keeps track of their capacity.
+  if (arrays->nb_names == index->capacity) {
+    index->capacity = OSL_max(4, 2 * index->capacity);
+    OSL_realloc(arrays->id, int*, (size_t)index->capacity * sizeof(int));
+    OSL_realloc(arrays->names, char**,
+                (size_t)index->capacity * sizeof(char*));
+    index->id = arrays->id;
+    index->names = arrays->names;
+  }
+
   arrays->id[arrays->nb_names] = id;
   OSL_strdup(arrays->names[arrays->nb_names], name);
   arrays->nb_names++;
 
+  index->nb_names = arrays->nb_names;
+  if (2 * (size_t)index->nb_names > index->nb_buckets)
+    osl_arrays_index_rehash(index, 2 * index->nb_buckets);
+  else
+    osl_arrays_index_insert(index, index->nb_names - 1);
+
   return arrays->nb_names;
 }
 
@@ -370,6 +521,9 @@ int osl_arrays_add(osl_arrays* const arrays, int id, const char* const name) {
  * osl_arrays_get_index_from_id function:
  * this function the index of a variable given its identifier
  *
+ * in constant time (a hash index is built on the first call, see
+ * osl_arrays_invalidate).
+ *
  * \param[in] arrays The arrays structure to modify.
  * \param[in] id     The variable's id.
  * \return index of the variable, array->nb_names means error
@@ -379,6 +533,20 @@ size_t osl_arrays_get_index_from_id(const osl_arrays* const arrays,
   if (!arrays)
     return 0;
 
+  const osl_arrays_index* const index = osl_arrays_cached_index(arrays);
+  if (index) {
+    const size_t mask = index->nb_buckets - 1;
+    size_t bucket = osl_arrays_id_hash(id) & mask;
+
+    while (index->by_id[bucket]) {
+      const int position = index->by_id[bucket] - 1;
+      if (arrays->id[position] == id)
+        return (size_t)position;
+      bucket = (bucket + 1) & mask;
+    }
+    return (size_t)arrays->nb_names;
+  }
+
   size_t i = 0;
   for (i = 0; i < (size_t)arrays->nb_names; i++) {
     if (arrays->id[i] == id)
@@ -392,6 +560,9 @@ size_t osl_arrays_get_index_from_id(const osl_arrays* const arrays,
  * osl_arrays_get_index_from_name function:
  * this function the index of a variable given its name
  *
+ * in constant time (a hash index is built on the first call, see
+ * osl_arrays_invalidate).
+ *
  * \param[in] arrays The arrays structure to modify.
  * \param[in] name     The variable's name.
  * \return index of the variable, array->nb_names means error
@@ -401,6 +572,20 @@ size_t osl_arrays_get_index_from_name(const osl_arrays* const arrays,
   if (!arrays || !name)
     return 0;
 
+  const osl_arrays_index* const index = osl_arrays_cached_index(arrays);
+  if (index) {
+    const size_t mask = index->nb_buckets - 1;
+    size_t bucket = osl_util_hash(name) & mask;
+
+    while (index->by_name[bucket]) {
+      const int position = index->by_name[bucket] - 1;
+      if (!strcmp(arrays->names[position], name))
+        return (size_t)position;
+      bucket = (bucket + 1) & mask;
+    }
+    return (size_t)arrays->nb_names;
+  }
+
   size_t i = 0;
   for (i = 0; i < (size_t)arrays->nb_names; i++) {
     if (!strcmp(arrays->names[i], name))
@@ -411,6 +596,51 @@ size_t osl_arrays_get_index_from_name(const osl_arrays* const arrays,
   ;
 }
 
+/**
+ * osl_arrays_invalidate function:
+ * this function drops the hash index of an arrays structure (see
+ * osl_arrays_get_index_from_id). The index follows osl_arrays_add and
+ * detects replaced identifier or name arrays, but this function has to be
+ * called each time an identifier or a name is modified in place.
+ * \param[in,out] arrays The arrays structure whose index is outdated.
+ */
+void osl_arrays_invalidate(osl_arrays* const arrays) {
+  osl_arrays_index_free(arrays->index);
+  arrays->index = NULL;
+}
+
+/**
+ * osl_arrays_memory_usage function:
+ * this function adds the memory footprint of an osl_arrays structure (its
+ * identifiers and names) to a memory usage.
+ * \param[in]     arrays The arrays structure.
+ * \param[in,out] usage  The memory usage to update.
+ */
+void osl_arrays_memory_usage(const osl_arrays* const arrays,
+                             osl_memory_usage* const usage) {
+  if (!arrays)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_arrays));
+  if (arrays->nb_names > 0) {
+    size_t nb_slots = (size_t)arrays->nb_names;
+    const osl_arrays_index* const index = arrays->index;
+    if (index && (index->id == arrays->id) &&
+        (index->names == arrays->names) &&
+        (index->nb_names == arrays->nb_names))
+      nb_slots = (size_t)index->capacity;
+    osl_memory_usage_add(usage, &usage->structures, nb_slots * sizeof(int));
+    osl_memory_usage_add(usage, &usage->strings, nb_slots * sizeof(char*));
+    for (int i = 0; i < arrays->nb_names; i++)
+      osl_memory_usage_string(usage, arrays->names[i]);
+  }
+  if (arrays->index) {
+    osl_memory_usage_add(usage, &usage->indexes, sizeof(osl_arrays_index));
+    osl_memory_usage_add(usage, &usage->indexes,
+                         2 * arrays->index->nb_buckets * sizeof(int));
+  }
+}
+
 /**
  * osl_arrays_interface function:
  * this function creates an interface structure corresponding to the arrays
@@ -428,6 +658,7 @@ osl_interface* osl_arrays_interface(void) {
   interface->free = (osl_free_f)osl_arrays_free;
   interface->clone = (osl_clone_f)osl_arrays_clone;
   interface->equal = (osl_equal_f)osl_arrays_equal;
+  interface->size = (osl_size_f)osl_arrays_memory_usage;
 
   return interface;
 }
@@ -99,7 +99,7 @@ void osl_clay_idump(FILE* const file, const osl_clay* const clay,
       if (tmp[l] == '\n')
         tmp[l] = ' ';
     fprintf(file, "script: %s\n", tmp);
-    free(tmp);
+    osl_allocator_free(tmp);
   }
 
   // The last line.
@@ -169,6 +169,7 @@ osl_clay* osl_clay_sread(char** input) {
 
   // Build the clay structure
   osl_clay* const clay = osl_clay_malloc();
+  osl_error_protect(clay, (osl_error_cleanup_f)osl_clay_free);
   char* script = *input;
 
   // Pass the carriage returns (this allows to remove those inserted by
@@ -176,6 +177,7 @@ osl_clay* osl_clay_sread(char** input) {
   while (*script && (*script == '\n'))
     script++;
   OSL_strdup(clay->script, script);
+  osl_error_unprotect(clay);
 
   // Update the input pointer (everything has been read).
   input += strlen(*input);
@@ -213,8 +215,8 @@ osl_clay* osl_clay_malloc(void) {
 void osl_clay_free(osl_clay* const clay) {
   if (clay) {
     if (clay->script)
-      free(clay->script);
-    free(clay);
+      osl_allocator_free(clay->script);
+    osl_allocator_free(clay);
   }
 }
 
@@ -264,6 +266,22 @@ bool osl_clay_equal(const osl_clay* const c1, const osl_clay* const c2) {
   return true;
 }
 
+/**
+ * osl_clay_memory_usage function:
+ * this function adds the memory footprint of an osl_clay structure (and its
+ * script) to a memory usage.
+ * \param[in]     clay The clay structure.
+ * \param[in,out] usage The memory usage to update.
+ */
+void osl_clay_memory_usage(const osl_clay* const clay,
+                           osl_memory_usage* const usage) {
+  if (!clay)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_clay));
+  osl_memory_usage_string(usage, clay->script);
+}
+
 /**
  * osl_clay_interface function:
  * this function creates an interface structure corresponding to the clay
@@ -281,6 +299,7 @@ osl_interface* osl_clay_interface(void) {
   interface->free = (osl_free_f)osl_clay_free;
   interface->clone = (osl_clone_f)osl_clay_clone;
   interface->equal = (osl_equal_f)osl_clay_equal;
+  interface->size = (osl_size_f)osl_clay_memory_usage;
 
   return interface;
 }
@@ -99,7 +99,7 @@ void osl_comment_idump(FILE* const file, const osl_comment* const comment,
       if (tmp[l] == '\n')
         tmp[l] = ' ';
     fprintf(file, "comment: %s\n", tmp);
-    free(tmp);
+    osl_allocator_free(tmp);
   }
 
   // The last line.
@@ -169,7 +169,9 @@ osl_comment* osl_comment_sread(char** input) {
 
   // Build the comment structure
   osl_comment* const comment = osl_comment_malloc();
+  osl_error_protect(comment, (osl_error_cleanup_f)osl_comment_free);
   OSL_strdup(comment->comment, *input);
+  osl_error_unprotect(comment);
 
   // Update the input pointer (everything has been read).
   input += strlen(*input);
@@ -207,8 +209,8 @@ osl_comment* osl_comment_malloc(void) {
 void osl_comment_free(osl_comment* comment) {
   if (comment) {
     if (comment->comment)
-      free(comment->comment);
-    free(comment);
+      osl_allocator_free(comment->comment);
+    osl_allocator_free(comment);
   }
 }
 
@@ -261,6 +263,22 @@ bool osl_comment_equal(const osl_comment* const c1,
   return true;
 }
 
+/**
+ * osl_comment_memory_usage function:
+ * this function adds the memory footprint of an osl_comment structure (and its
+ * message) to a memory usage.
+ * \param[in]     comment The comment structure.
+ * \param[in,out] usage   The memory usage to update.
+ */
+void osl_comment_memory_usage(const osl_comment* const comment,
+                              osl_memory_usage* const usage) {
+  if (!comment)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_comment));
+  osl_memory_usage_string(usage, comment->comment);
+}
+
 /**
  * osl_comment_interface function:
  * this function creates an interface structure corresponding to the comment
@@ -278,6 +296,7 @@ osl_interface* osl_comment_interface(void) {
   interface->free = (osl_free_f)osl_comment_free;
   interface->clone = (osl_clone_f)osl_comment_clone;
   interface->equal = (osl_equal_f)osl_comment_equal;
+  interface->size = (osl_size_f)osl_comment_memory_usage;
 
   return interface;
 }
@@ -188,6 +188,7 @@ osl_coordinates* osl_coordinates_sread(char** input) {
 
   // Build the coordinates structure.
   osl_coordinates* const coordinates = osl_coordinates_malloc();
+  osl_error_protect(coordinates, (osl_error_cleanup_f)osl_coordinates_free);
 
   // Read the file name (and path).
   coordinates->name = osl_util_read_line(NULL, input);
@@ -201,6 +202,7 @@ osl_coordinates* osl_coordinates_sread(char** input) {
   // Read the indentation level.
   coordinates->indent = osl_util_read_int(NULL, input);
 
+  osl_error_unprotect(coordinates);
   return coordinates;
 }
 
@@ -238,8 +240,8 @@ osl_coordinates* osl_coordinates_malloc(void) {
  */
 void osl_coordinates_free(osl_coordinates* const coordinates) {
   if (coordinates) {
-    free(coordinates->name);
-    free(coordinates);
+    osl_allocator_free(coordinates->name);
+    osl_allocator_free(coordinates);
   }
 }
 
@@ -319,6 +321,22 @@ bool osl_coordinates_equal(const osl_coordinates* const c1,
   return true;
 }
 
+/**
+ * osl_coordinates_memory_usage function:
+ * this function adds the memory footprint of an osl_coordinates structure (and
+ * its file name) to a memory usage.
+ * \param[in]     coordinates The coordinates structure.
+ * \param[in,out] usage       The memory usage to update.
+ */
+void osl_coordinates_memory_usage(const osl_coordinates* const coordinates,
+                                  osl_memory_usage* const usage) {
+  if (!coordinates)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_coordinates));
+  osl_memory_usage_string(usage, coordinates->name);
+}
+
 /**
  * osl_coordinates_interface function:
  * this function creates an interface structure corresponding to the coordinates
@@ -336,6 +354,7 @@ osl_interface* osl_coordinates_interface(void) {
   interface->free = (osl_free_f)osl_coordinates_free;
   interface->clone = (osl_clone_f)osl_coordinates_clone;
   interface->equal = (osl_equal_f)osl_coordinates_equal;
+  interface->size = (osl_size_f)osl_coordinates_memory_usage;
 
   return interface;
 }
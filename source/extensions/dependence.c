@@ -58,10 +58,12 @@
  *                                                                            *
  ******************************************************************************/
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <osl/int.h>
 #include <osl/macros.h>
 #include <osl/names.h>
 #include <osl/relation.h>
@@ -207,7 +209,7 @@ void osl_dependence_print(FILE* const file,
                           const osl_dependence* const dependence) {
   char* const string = osl_dependence_sprint(dependence);
   fprintf(file, "%s\n", string);
-  free(string);
+  osl_allocator_free(string);
 }
 
 /**
@@ -275,7 +277,7 @@ char* osl_dependence_sprint(const osl_dependence* const dependence) {
       /* Output dependence domain. */
       char* const pbuffer = osl_relation_sprint(tmp->domain);
       osl_util_safe_strcat(&buffer, pbuffer, &buffer_size);
-      free(pbuffer);
+      osl_allocator_free(pbuffer);
     }
   }
 
@@ -283,12 +285,160 @@ char* osl_dependence_sprint(const osl_dependence* const dependence) {
 }
 
 /**
- * osl_dependence_read_one_dep function:
- * Read one dependence from a string.
+ * The osl_dependence_domain_table structure is a hash table of the distinct
+ * domains of a dependence list, used to share identical domains. Each slot
+ * holds the first dependence with a given domain and the hash of this
+ * domain.
  */
-static osl_dependence* osl_dependence_read_one_dep(char** const input,
-                                                   const int precision) {
+struct osl_dependence_domain_table {
+  size_t size;                 /**< Number of slots (a power of 2) */
+  size_t* hash;                /**< Hash of the domain of each slot */
+  osl_dependence** dependence; /**< Dependence of each slot (or NULL) */
+};
+typedef struct osl_dependence_domain_table osl_dependence_domain_table;
+
+/**
+ * osl_dependence_domain_table_init internal function:
+ * this function allocates an empty domain table for a given number of
+ * dependences.
+ * \param[out] table The table to initialize.
+ * \param[in]  nb    The number of dependences to insert.
+ */
+static void osl_dependence_domain_table_init(
+    osl_dependence_domain_table* const table, const int nb) {
+  table->size = 16;
+  while (table->size < 2 * (size_t)(nb > 0 ? nb : 0))
+    table->size *= 2;
+
+  OSL_malloc(table->hash, size_t*, table->size * sizeof(size_t));
+  OSL_malloc(table->dependence, osl_dependence**,
+             table->size * sizeof(osl_dependence*));
+  for (size_t i = 0; i < table->size; i++)
+    table->dependence[i] = NULL;
+}
+
+/**
+ * osl_dependence_domain_table_free internal function:
+ * this function frees the memory of a domain table (not the dependences).
+ * \param[in] table The table to free.
+ */
+static void osl_dependence_domain_table_free(
+    osl_dependence_domain_table* const table) {
+  osl_allocator_free(table->hash);
+  osl_allocator_free(table->dependence);
+}
+
+/**
+ * osl_dependence_domain_hash internal function:
+ * this function returns a hash of the content of a relation union (its
+ * attributes and its elements).
+ * \param[in] relation The relation union to hash.
+ * \return The hash of the relation.
+ */
+static size_t osl_dependence_domain_hash(const osl_relation* relation) {
+  size_t hash = (size_t)2166136261U;
+
+#define OSL_DEPENDENCE_HASH(value) \
+  hash = (hash ^ (size_t)(value)) * (size_t)16777619U
+
+  for (; relation; relation = relation->next) {
+    OSL_DEPENDENCE_HASH(relation->type);
+    OSL_DEPENDENCE_HASH(relation->nb_rows);
+    OSL_DEPENDENCE_HASH(relation->nb_columns);
+    OSL_DEPENDENCE_HASH(relation->nb_output_dims);
+    OSL_DEPENDENCE_HASH(relation->nb_input_dims);
+    OSL_DEPENDENCE_HASH(relation->nb_local_dims);
+    OSL_DEPENDENCE_HASH(relation->nb_parameters);
+    for (int i = 0; i < relation->nb_rows; i++)
+      for (int j = 0; j < relation->nb_columns; j++)
+        OSL_DEPENDENCE_HASH(
+            osl_int_get_si(relation->precision, relation->m[i][j]));
+  }
+
+#undef OSL_DEPENDENCE_HASH
+  return hash;
+}
+
+/**
+ * osl_dependence_domain_intern internal function:
+ * this function looks for a dependence with the same domain as a given
+ * dependence in a domain table. If there is none, the dependence is added
+ * to the table.
+ * \param[in,out] table      The domain table.
+ * \param[in]     dependence The dependence whose domain is looked for.
+ * \return The dependence of the table with an identical domain, NULL if
+ *         there is none (or if the dependence has no domain).
+ */
+static osl_dependence* osl_dependence_domain_intern(
+    osl_dependence_domain_table* const table,
+    osl_dependence* const dependence) {
+  if (!dependence->domain)
+    return NULL;
+
+  const size_t hash = osl_dependence_domain_hash(dependence->domain);
+  size_t i = hash & (table->size - 1);
+  while (table->dependence[i]) {
+    if ((table->hash[i] == hash) &&
+        osl_relation_equal(table->dependence[i]->domain, dependence->domain))
+      return table->dependence[i];
+    i = (i + 1) & (table->size - 1);
+  }
+
+  table->hash[i] = hash;
+  table->dependence[i] = dependence;
+  return NULL;
+}
+
+/**
+ * osl_dependence_domain_attach internal function:
+ * this function makes a dependence share the domain of another one. The
+ * previous domain of the dependence is not freed.
+ * \param[in,out] same       The dependence whose domain is shared.
+ * \param[in,out] dependence The dependence to share the domain with.
+ */
+static void osl_dependence_domain_attach(osl_dependence* const same,
+                                         osl_dependence* const dependence) {
+  if (!same->shared_domain) {
+    OSL_malloc(same->shared_domain, osl_dependence_shared_domain*,
+               sizeof(osl_dependence_shared_domain));
+    same->shared_domain->domain = same->domain;
+    same->shared_domain->nb_references = 1;
+  }
+
+  dependence->domain = same->domain;
+  dependence->shared_domain = same->shared_domain;
+  dependence->shared_domain->nb_references++;
+}
+
+/**
+ * osl_dependence_release_domain internal function:
+ * this function releases the domain of a dependence: an owned domain is
+ * freed, a shared one is freed with its last dependence. A domain which
+ * replaced a shared one is owned by its dependence.
+ * \param[in,out] dependence The dependence whose domain is released.
+ */
+static void osl_dependence_release_domain(osl_dependence* const dependence) {
+  osl_dependence_shared_domain* const shared = dependence->shared_domain;
+
+  if (!shared || (dependence->domain != shared->domain))
+    osl_relation_free(dependence->domain);
+  if (shared && (--shared->nb_references == 0)) {
+    osl_relation_free(shared->domain);
+    osl_allocator_free(shared);
+  }
+
+  dependence->domain = NULL;
+  dependence->shared_domain = NULL;
+}
+
+/**
+ * osl_dependence_read_header function:
+ * Read the type, labels, depth and references of one dependence from a
+ * string, i.e., everything but its domain.
+ */
+static osl_dependence* osl_dependence_read_header(char** const input) {
   osl_dependence* const dep = osl_dependence_malloc();
+  osl_error_protect(dep, (osl_error_cleanup_f)osl_dependence_free);
 
   /* Dependence type */
   char* const buffer = osl_util_read_string(NULL, input);
@@ -302,7 +452,7 @@ static osl_dependence* osl_dependence_read_one_dep(char** const input,
     dep->type = OSL_DEPENDENCE_WAW;
   else if (!strcmp(buffer, "RAW_SCALPRIV"))
     dep->type = OSL_DEPENDENCE_RAW_SCALPRIV;
-  free(buffer);
+  osl_allocator_free(buffer);
 
   /* # From source statement xxx */
   dep->label_source = osl_util_read_int(NULL, input);
@@ -319,8 +469,22 @@ static osl_dependence* osl_dependence_read_one_dep(char** const input,
   /* # To target access ref */
   dep->ref_target = osl_util_read_int(NULL, input);
 
+  osl_error_unprotect(dep);
+  return dep;
+}
+
+/**
+ * osl_dependence_read_one_dep function:
+ * Read one dependence from a string.
+ */
+static osl_dependence* osl_dependence_read_one_dep(char** const input,
+                                                   const int precision) {
+  osl_dependence* const dep = osl_dependence_read_header(input);
+
   /* Read the osl_relation */
+  osl_error_protect(dep, (osl_error_cleanup_f)osl_dependence_free);
   dep->domain = osl_relation_psread(input, precision);
+  osl_error_unprotect(dep);
 
   return dep;
 }
@@ -356,15 +520,93 @@ osl_dependence* osl_dependence_psread(char** const input, const int precision) {
     osl_dependence* adep = osl_dependence_read_one_dep(input, precision);
     if (!first) {
       currdep = first = adep;
+      osl_error_protect(first, (osl_error_cleanup_f)osl_dependence_free);
     } else {
       currdep->next = adep;
       currdep = currdep->next;
     }
   }
 
+  osl_error_unprotect(first);
   return first;
 }
 
+/**
+ * osl_dependence_cursor_init function:
+ * this function initializes a cursor to read the dependences of a textual
+ * dependence extension one at a time, keeping only the dependences which
+ * match some criteria, OSL_UNDEFINED standing for any value (see
+ * osl_dependence_cursor_next). The input is the content of the extension,
+ * as given to osl_dependence_sread, possibly starting with the
+ * <dependence> tag (e.g., the textual extension of a scop read without the
+ * dependence interface). It is not copied and must live as long as the
+ * cursor. The precision of the domains is the one of the environment, the
+ * precision field may be set to use another one.
+ * \param[out] cursor       The cursor to initialize.
+ * \param[in]  input        The textual dependences.
+ * \param[in]  label_source The label of the source statement.
+ * \param[in]  label_target The label of the target statement.
+ * \param[in]  type         The type of the dependences.
+ * \param[in]  depth        The depth of the dependences.
+ */
+void osl_dependence_cursor_init(osl_dependence_cursor* const cursor,
+                                char* input, const int label_source,
+                                const int label_target, const int type,
+                                const int depth) {
+  const char* const tag = "<" OSL_URI_DEPENDENCE ">";
+
+  cursor->nb_remaining = 0;
+  cursor->precision = osl_util_get_precision();
+  cursor->label_source = label_source;
+  cursor->label_target = label_target;
+  cursor->type = type;
+  cursor->depth = depth;
+
+  if (input) {
+    osl_util_sskip_blank_and_comments(&input);
+    if (!strncmp(input, tag, strlen(tag)))
+      input += strlen(tag);
+    cursor->nb_remaining = osl_util_read_int(NULL, &input);
+  }
+  cursor->input = input;
+}
+
+/**
+ * osl_dependence_cursor_next function:
+ * this function reads the next dependence of a cursor which matches its
+ * criteria (see osl_dependence_cursor_init). The type, labels and depth of
+ * a dependence come before its domain: the domains of the other
+ * dependences are skipped without being decoded (see osl_relation_sskip).
+ * \param[in,out] cursor The cursor to read from.
+ * \return The next matching dependence, to be freed by the caller, or NULL
+ *         if there is none.
+ */
+osl_dependence* osl_dependence_cursor_next(
+    osl_dependence_cursor* const cursor) {
+  while (cursor->nb_remaining > 0) {
+    osl_dependence* const dep = osl_dependence_read_header(&cursor->input);
+    osl_error_protect(dep, (osl_error_cleanup_f)osl_dependence_free);
+    cursor->nb_remaining--;
+
+    if (((cursor->label_source == OSL_UNDEFINED) ||
+         (dep->label_source == cursor->label_source)) &&
+        ((cursor->label_target == OSL_UNDEFINED) ||
+         (dep->label_target == cursor->label_target)) &&
+        ((cursor->type == OSL_UNDEFINED) || (dep->type == cursor->type)) &&
+        ((cursor->depth == OSL_UNDEFINED) || (dep->depth == cursor->depth))) {
+      dep->domain = osl_relation_psread(&cursor->input, cursor->precision);
+      osl_error_unprotect(dep);
+      return dep;
+    }
+
+    osl_relation_sskip(&cursor->input);
+    osl_error_unprotect(dep);
+    osl_dependence_free(dep);
+  }
+
+  return NULL;
+}
+
 /*******************************************************************************
  *                         Memory deallocation function                        *
  *******************************************************************************/
@@ -404,6 +646,7 @@ osl_dependence* osl_dependence_malloc(void) {
   dependence->ref_target_access_ptr = NULL;
   dependence->stmt_source_ptr = NULL;
   dependence->stmt_target_ptr = NULL;
+  dependence->shared_domain = NULL;
 
   return dependence;
 }
@@ -417,12 +660,211 @@ void osl_dependence_free(osl_dependence* dependence) {
   osl_dependence* next;
   while (dependence) {
     next = dependence->next;
-    osl_relation_free(dependence->domain);
-    free(dependence);
+    osl_dependence_release_domain(dependence);
+    osl_allocator_free(dependence);
     dependence = next;
   }
 }
 
+/**
+ * osl_dependence_key_source, osl_dependence_key_target,
+ * osl_dependence_key_type and osl_dependence_key_depth internal functions:
+ * these functions return the keys of the buckets of a dependence graph.
+ */
+static int osl_dependence_key_source(const osl_dependence* const d) {
+  return d->label_source;
+}
+
+static int osl_dependence_key_target(const osl_dependence* const d) {
+  return d->label_target;
+}
+
+static int osl_dependence_key_type(const osl_dependence* const d) {
+  return d->type;
+}
+
+static int osl_dependence_key_depth(const osl_dependence* const d) {
+  return d->depth;
+}
+
+/**
+ * osl_dependence_key_compare internal function:
+ * this function compares two keys, for qsort.
+ * \param[in] a The address of the first key.
+ * \param[in] b The address of the second key.
+ * \return A negative, zero or positive value if a < b, a == b or a > b.
+ */
+static int osl_dependence_key_compare(const void* const a,
+                                      const void* const b) {
+  const int x = *(const int*)a;
+  const int y = *(const int*)b;
+
+  return (x > y) - (x < y);
+}
+
+/**
+ * osl_dependence_bucket_slot internal function:
+ * this function returns the slot of a key in a bucket (see the
+ * osl_dependence_bucket structure), in constant time if the slots are the
+ * keys, in logarithmic time otherwise.
+ * \param[in] bucket The bucket to query.
+ * \param[in] key    The key to find.
+ * \return The slot of the key, -1 if the key has no slot.
+ */
+static int osl_dependence_bucket_slot(
+    const osl_dependence_bucket* const bucket, const int key) {
+  if (key < 0)
+    return -1;
+
+  if (!bucket->key)
+    return (key < bucket->size) ? key : -1;
+
+  int low = 0;
+  int high = bucket->size;
+  while (low < high) {
+    const int middle = low + (high - low) / 2;
+    if (bucket->key[middle] < key)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+  return ((low < bucket->size) && (bucket->key[low] == key)) ? low : -1;
+}
+
+/**
+ * osl_dependence_bucket_build internal function:
+ * this function sorts an array of dependences by a key into a bucket (see
+ * the osl_dependence_bucket structure), with a counting sort which keeps
+ * the order of the array for each key. The memory is linear in the number
+ * of dependences, whatever the keys.
+ * \param[out] bucket     The bucket to build.
+ * \param[in]  dependence The array of dependences to sort.
+ * \param[in]  nb         The number of dependences in the array.
+ * \param[in]  key        The function returning the key of a dependence.
+ */
+static void osl_dependence_bucket_build(
+    osl_dependence_bucket* const bucket, const osl_dependence** dependence,
+    const int nb, int (*key)(const osl_dependence*)) {
+  int max = -1;
+  int nb_keys = 0;
+
+  for (int i = 0; i < nb; i++) {
+    if (key(dependence[i]) >= 0) {
+      nb_keys++;
+      if (key(dependence[i]) > max)
+        max = key(dependence[i]);
+    }
+  }
+
+  // The keys are the slots if they are small enough, e.g., statement labels
+  // or depths. Otherwise, e.g., with a huge label, the slots are the
+  // positions in the sorted array of the keys in use.
+  bucket->key = NULL;
+  bucket->edge = NULL;
+  if ((max < 0) || ((size_t)max < 2 * (size_t)nb + 16)) {
+    bucket->size = max + 1;
+  } else {
+    OSL_malloc(bucket->key, int*, (size_t)nb_keys * sizeof(int));
+    nb_keys = 0;
+    for (int i = 0; i < nb; i++)
+      if (key(dependence[i]) >= 0)
+        bucket->key[nb_keys++] = key(dependence[i]);
+    qsort(bucket->key, (size_t)nb_keys, sizeof(int),
+          osl_dependence_key_compare);
+
+    bucket->size = 0;
+    for (int k = 0; k < nb_keys; k++)
+      if ((k == 0) || (bucket->key[k] != bucket->key[k - 1]))
+        bucket->key[bucket->size++] = bucket->key[k];
+  }
+
+  const int size = bucket->size;
+  OSL_malloc(bucket->start, int*, (size_t)(size + 1) * sizeof(int));
+  for (int k = 0; k <= size; k++)
+    bucket->start[k] = 0;
+
+  // Count the dependences of each slot, then turn the counts into offsets.
+  for (int i = 0; i < nb; i++) {
+    const int slot = osl_dependence_bucket_slot(bucket, key(dependence[i]));
+    if (slot >= 0)
+      bucket->start[slot + 1]++;
+  }
+  for (int k = 0; k < size; k++)
+    bucket->start[k + 1] += bucket->start[k];
+
+  // Place each dependence at the next edge of its slot, which moves each
+  // offset to the next slot, then move the offsets back.
+  if (bucket->start[size] > 0)
+    OSL_malloc(bucket->edge, const osl_dependence**,
+               (size_t)bucket->start[size] * sizeof(osl_dependence*));
+  for (int i = 0; i < nb; i++) {
+    const int slot = osl_dependence_bucket_slot(bucket, key(dependence[i]));
+    if (slot >= 0)
+      bucket->edge[bucket->start[slot]++] = dependence[i];
+  }
+  for (int k = size; k > 0; k--)
+    bucket->start[k] = bucket->start[k - 1];
+  bucket->start[0] = 0;
+}
+
+/**
+ * osl_dependence_graph_build function:
+ * this function builds a graph index over a dependence list (see the
+ * osl_dependence_graph structure), in time linear in the number of
+ * dependences and statements.
+ * \param[in] list The dependence list to index.
+ * \return A pointer to the graph of the list.
+ */
+osl_dependence_graph* osl_dependence_graph_build(
+    const osl_dependence* const list) {
+  osl_dependence_graph* graph;
+
+  OSL_malloc(graph, osl_dependence_graph*, sizeof(osl_dependence_graph));
+  graph->list = list;
+  graph->nb_dependences = osl_nb_dependences(list);
+  graph->dependence = NULL;
+  if (graph->nb_dependences > 0)
+    OSL_malloc(graph->dependence, const osl_dependence**,
+               (size_t)graph->nb_dependences * sizeof(osl_dependence*));
+
+  int i = 0;
+  for (const osl_dependence* d = list; d; d = d->next)
+    graph->dependence[i++] = d;
+
+  osl_dependence_bucket_build(&graph->source, graph->dependence,
+                              graph->nb_dependences,
+                              osl_dependence_key_source);
+  osl_dependence_bucket_build(&graph->target, graph->dependence,
+                              graph->nb_dependences,
+                              osl_dependence_key_target);
+  osl_dependence_bucket_build(&graph->type, graph->dependence,
+                              graph->nb_dependences, osl_dependence_key_type);
+  osl_dependence_bucket_build(&graph->depth, graph->dependence,
+                              graph->nb_dependences, osl_dependence_key_depth);
+
+  return graph;
+}
+
+/**
+ * osl_dependence_graph_free function:
+ * this function frees the allocated memory for a dependence graph. The
+ * indexed dependence list is left untouched.
+ * \param[in] graph The pointer to the graph we want to free.
+ */
+void osl_dependence_graph_free(osl_dependence_graph* const graph) {
+  if (graph) {
+    osl_dependence_bucket* const buckets[] = {&graph->source, &graph->target,
+                                              &graph->type, &graph->depth};
+    for (size_t i = 0; i < sizeof(buckets) / sizeof(*buckets); i++) {
+      osl_allocator_free(buckets[i]->key);
+      osl_allocator_free(buckets[i]->start);
+      osl_allocator_free(buckets[i]->edge);
+    }
+    osl_allocator_free(graph->dependence);
+    osl_allocator_free(graph);
+  }
+}
+
 /*******************************************************************************
  *                            Processing functions                             *
  *******************************************************************************/
@@ -573,6 +1015,343 @@ int osl_nb_dependences(const osl_dependence* deps) {
   return num;
 }
 
+/**
+ * osl_dependence_bucket_get internal function:
+ * this function returns the dependences of a bucket with a given key.
+ * \param[in]  bucket The bucket to query.
+ * \param[in]  key    The key of the dependences.
+ * \param[out] nb     The number of dependences with this key.
+ * \return The array of the dependences with this key (NULL if none).
+ */
+static const osl_dependence* const* osl_dependence_bucket_get(
+    const osl_dependence_bucket* const bucket, const int key, int* const nb) {
+  const int slot = osl_dependence_bucket_slot(bucket, key);
+  if ((slot < 0) || (bucket->start[slot] == bucket->start[slot + 1])) {
+    *nb = 0;
+    return NULL;
+  }
+
+  *nb = bucket->start[slot + 1] - bucket->start[slot];
+  return bucket->edge + bucket->start[slot];
+}
+
+/**
+ * osl_dependence_graph_from function:
+ * this function returns the dependences of a graph whose source is a given
+ * statement, in constant time (logarithmic if the labels are sparse, see
+ * the osl_dependence_bucket structure).
+ * \param[in]  graph The dependence graph.
+ * \param[in]  label The label of the source statement.
+ * \param[out] nb    The number of dependences from this statement.
+ * \return The array of the dependences from the statement (NULL if none).
+ */
+const osl_dependence* const* osl_dependence_graph_from(
+    const osl_dependence_graph* const graph, const int label, int* const nb) {
+  return osl_dependence_bucket_get(&graph->source, label, nb);
+}
+
+/**
+ * osl_dependence_graph_to function:
+ * this function returns the dependences of a graph whose target is a given
+ * statement, in constant time (logarithmic if the labels are sparse, see
+ * the osl_dependence_bucket structure).
+ * \param[in]  graph The dependence graph.
+ * \param[in]  label The label of the target statement.
+ * \param[out] nb    The number of dependences to this statement.
+ * \return The array of the dependences to the statement (NULL if none).
+ */
+const osl_dependence* const* osl_dependence_graph_to(
+    const osl_dependence_graph* const graph, const int label, int* const nb) {
+  return osl_dependence_bucket_get(&graph->target, label, nb);
+}
+
+/**
+ * osl_dependence_graph_of_type function:
+ * this function returns the dependences of a graph of a given type (e.g.,
+ * OSL_DEPENDENCE_RAW), in constant time (logarithmic if the types are
+ * sparse, see the osl_dependence_bucket structure).
+ * \param[in]  graph The dependence graph.
+ * \param[in]  type  The type of the dependences.
+ * \param[out] nb    The number of dependences of this type.
+ * \return The array of the dependences of this type (NULL if none).
+ */
+const osl_dependence* const* osl_dependence_graph_of_type(
+    const osl_dependence_graph* const graph, const int type, int* const nb) {
+  return osl_dependence_bucket_get(&graph->type, type, nb);
+}
+
+/**
+ * osl_dependence_graph_at_depth function:
+ * this function returns the dependences of a graph at a given depth, in
+ * constant time (logarithmic if the depths are sparse, see the
+ * osl_dependence_bucket structure).
+ * \param[in]  graph The dependence graph.
+ * \param[in]  depth The depth of the dependences.
+ * \param[out] nb    The number of dependences at this depth.
+ * \return The array of the dependences at this depth (NULL if none).
+ */
+const osl_dependence* const* osl_dependence_graph_at_depth(
+    const osl_dependence_graph* const graph, const int depth, int* const nb) {
+  return osl_dependence_bucket_get(&graph->depth, depth, nb);
+}
+
+/**
+ * osl_dependence_iterator_init function:
+ * this function initializes an iterator over the dependences of a graph
+ * which match some criteria, OSL_UNDEFINED standing for any value. The
+ * iterator walks the smallest bucket among the criteria and checks the
+ * other ones, e.g., the RAW dependences from a statement are found among
+ * the dependences from this statement or among the RAW ones.
+ * \param[out] iterator     The iterator to initialize.
+ * \param[in]  graph        The dependence graph.
+ * \param[in]  label_source The label of the source statement.
+ * \param[in]  label_target The label of the target statement.
+ * \param[in]  type         The type of the dependences.
+ * \param[in]  depth        The depth of the dependences.
+ */
+void osl_dependence_iterator_init(osl_dependence_iterator* const iterator,
+                                  const osl_dependence_graph* const graph,
+                                  const int label_source,
+                                  const int label_target, const int type,
+                                  const int depth) {
+  const osl_dependence_bucket* const buckets[] = {
+      &graph->source, &graph->target, &graph->type, &graph->depth};
+  const int keys[] = {label_source, label_target, type, depth};
+  int nb = graph->nb_dependences;
+
+  iterator->label_source = label_source;
+  iterator->label_target = label_target;
+  iterator->type = type;
+  iterator->depth = depth;
+  iterator->next = graph->dependence;
+  iterator->end = nb ? graph->dependence + nb : NULL;
+
+  for (size_t i = 0; i < sizeof(keys) / sizeof(*keys); i++) {
+    if (keys[i] == OSL_UNDEFINED)
+      continue;
+
+    int size;
+    const osl_dependence* const* const edge =
+        osl_dependence_bucket_get(buckets[i], keys[i], &size);
+    if (size < nb) {
+      nb = size;
+      iterator->next = edge;
+      iterator->end = size ? edge + size : NULL;
+    }
+  }
+}
+
+/**
+ * osl_dependence_iterator_next function:
+ * this function returns the next dependence of an iterator (see
+ * osl_dependence_iterator_init), in the order of the dependence list.
+ * \param[in,out] iterator The iterator to advance.
+ * \return The next dependence matching the criteria, NULL if none.
+ */
+const osl_dependence* osl_dependence_iterator_next(
+    osl_dependence_iterator* const iterator) {
+  while (iterator->next != iterator->end) {
+    const osl_dependence* const d = *iterator->next++;
+    if (((iterator->label_source == OSL_UNDEFINED) ||
+         (d->label_source == iterator->label_source)) &&
+        ((iterator->label_target == OSL_UNDEFINED) ||
+         (d->label_target == iterator->label_target)) &&
+        ((iterator->type == OSL_UNDEFINED) || (d->type == iterator->type)) &&
+        ((iterator->depth == OSL_UNDEFINED) || (d->depth == iterator->depth)))
+      return d;
+  }
+
+  return NULL;
+}
+
+/**
+ * osl_dependence_resolve_access internal function:
+ * this function returns the access relation at a given position in the
+ * access list of a statement. The access lists are turned into arrays on
+ * demand, one per statement, so that each list is walked only once.
+ * \param[in,out] access    The access arrays, one per statement.
+ * \param[in,out] nb_access The number of accesses of each statement.
+ * \param[in]     statement The statement of the access.
+ * \param[in]     label     The position of the statement in the scop.
+ * \param[in]     ref       The position of the access in the list.
+ * \return The access relation, NULL if there is no such position.
+ */
+static osl_relation* osl_dependence_resolve_access(
+    osl_relation*** const access, int* const nb_access,
+    const osl_statement* const statement, const int label, const int ref) {
+  if (nb_access[label] == OSL_UNDEFINED) {
+    nb_access[label] = (int)osl_relation_list_count(statement->access);
+    if (nb_access[label] > 0) {
+      int i = 0;
+      OSL_malloc(access[label], osl_relation**,
+                 (size_t)nb_access[label] * sizeof(osl_relation*));
+      for (osl_relation_list* list = statement->access; list;
+           list = list->next)
+        access[label][i++] = list->elt;
+    }
+  }
+
+  if ((ref < 0) || (ref >= nb_access[label]))
+    return NULL;
+  return access[label][ref];
+}
+
+/**
+ * osl_dependence_resolve function:
+ * this function fills the statement and access pointers of the dependences
+ * of a list (stmt_source_ptr, stmt_target_ptr, ref_source_access_ptr and
+ * ref_target_access_ptr) from their labels and references: the labels are
+ * positions in the statement list of the scop and the references are
+ * positions in the access lists of the statements, both from 0. It runs in
+ * time linear in the number of dependences, statements and accesses. The
+ * pointers which cannot be resolved are set to NULL.
+ * \param[in,out] list The dependence list to resolve.
+ * \param[in,out] scop The scop the dependences refer to.
+ * \return The number of dependences which are not fully resolved.
+ */
+int osl_dependence_resolve(osl_dependence* const list,
+                           osl_scop* const scop) {
+  const int nb_statements = osl_scop_statement_number(scop);
+  osl_relation*** access = NULL;
+  int* nb_access = NULL;
+  int nb_unresolved = 0;
+
+  if (nb_statements > 0) {
+    OSL_malloc(access, osl_relation***,
+               (size_t)nb_statements * sizeof(osl_relation**));
+    OSL_malloc(nb_access, int*, (size_t)nb_statements * sizeof(int));
+    for (int i = 0; i < nb_statements; i++) {
+      access[i] = NULL;
+      nb_access[i] = OSL_UNDEFINED;
+    }
+  }
+
+  for (osl_dependence* d = list; d; d = d->next) {
+    d->stmt_source_ptr = osl_scop_statement_get(scop, d->label_source);
+    d->stmt_target_ptr = osl_scop_statement_get(scop, d->label_target);
+    d->ref_source_access_ptr = NULL;
+    d->ref_target_access_ptr = NULL;
+    if (d->stmt_source_ptr)
+      d->ref_source_access_ptr = osl_dependence_resolve_access(
+          access, nb_access, d->stmt_source_ptr, d->label_source,
+          d->ref_source);
+    if (d->stmt_target_ptr)
+      d->ref_target_access_ptr = osl_dependence_resolve_access(
+          access, nb_access, d->stmt_target_ptr, d->label_target,
+          d->ref_target);
+
+    if (!d->ref_source_access_ptr || !d->ref_target_access_ptr)
+      nb_unresolved++;
+  }
+
+  for (int i = 0; i < nb_statements; i++)
+    osl_allocator_free(access[i]);
+  osl_allocator_free(access);
+  osl_allocator_free(nb_access);
+  return nb_unresolved;
+}
+
+/**
+ * osl_dependence_share_domains function:
+ * this function makes the dependences of a list with identical domains
+ * share a single copy of their domain (see the osl_dependence_shared_domain
+ * structure). Sharing is opt-in: read and cloned lists own their domains,
+ * so that a tool may replace or modify a domain without care. It saves
+ * memory for large lists, where many dependences between the same
+ * statements differ only by their type or depth. Once shared, a domain must
+ * not be modified in place, see osl_dependence_unshare_domain.
+ * \param[in,out] list The dependence list whose domains are shared.
+ */
+void osl_dependence_share_domains(osl_dependence* const list) {
+  osl_dependence_domain_table table;
+
+  osl_dependence_domain_table_init(&table, osl_nb_dependences(list));
+  for (osl_dependence* d = list; d; d = d->next) {
+    osl_dependence* const same = osl_dependence_domain_intern(&table, d);
+    if (same && (same->domain != d->domain)) {
+      osl_dependence_release_domain(d);
+      osl_dependence_domain_attach(same, d);
+    }
+  }
+  osl_dependence_domain_table_free(&table);
+}
+
+/**
+ * osl_dependence_unshare_domain function:
+ * this function gives a dependence its own copy of its domain if it is
+ * shared with other dependences (see osl_dependence_share_domains). It must
+ * be called before modifying the domain of a dependence in place.
+ * \param[in,out] dependence The dependence whose domain is unshared.
+ */
+void osl_dependence_unshare_domain(osl_dependence* const dependence) {
+  osl_dependence_shared_domain* const shared = dependence->shared_domain;
+
+  if (shared && (dependence->domain == shared->domain)) {
+    osl_relation* const domain = osl_relation_clone(dependence->domain);
+    osl_dependence_release_domain(dependence);
+    dependence->domain = domain;
+  }
+}
+
+/**
+ * osl_dependence_shared_domain_compare internal function:
+ * this function compares the addresses of two shared domains, to sort them
+ * with qsort.
+ * \param[in] a The address of the first shared domain pointer.
+ * \param[in] b The address of the second shared domain pointer.
+ * \return A negative, null or positive value as a is before, at or after b.
+ */
+static int osl_dependence_shared_domain_compare(const void* const a,
+                                                const void* const b) {
+  const uintptr_t x = (uintptr_t)*(const osl_dependence_shared_domain**)a;
+  const uintptr_t y = (uintptr_t)*(const osl_dependence_shared_domain**)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * osl_dependence_memory_usage function:
+ * this function adds the memory footprint of an osl_dependence list (the nodes
+ * and their dependence polyhedra) to a memory usage.
+ * \param[in]     dependence The dependence structure.
+ * \param[in,out] usage      The memory usage to update.
+ */
+void osl_dependence_memory_usage(const osl_dependence* dependence,
+                                 osl_memory_usage* const usage) {
+  const osl_dependence_shared_domain** shared = NULL;
+  int nb_shared = 0;
+
+  for (const osl_dependence* d = dependence; d; d = d->next)
+    if (d->shared_domain)
+      nb_shared++;
+  if (nb_shared > 0)
+    OSL_malloc(shared, const osl_dependence_shared_domain**,
+               (size_t)nb_shared * sizeof(osl_dependence_shared_domain*));
+
+  nb_shared = 0;
+  while (dependence) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_dependence));
+    if (dependence->shared_domain)
+      shared[nb_shared++] = dependence->shared_domain;
+    if (!dependence->shared_domain ||
+        (dependence->domain != dependence->shared_domain->domain))
+      osl_relation_memory_usage(dependence->domain, usage);
+    dependence = dependence->next;
+  }
+
+  // The shared domains are counted once.
+  if (nb_shared > 0)
+    qsort(shared, (size_t)nb_shared, sizeof(*shared),
+          osl_dependence_shared_domain_compare);
+  for (int i = 0; i < nb_shared; i++) {
+    if ((i == 0) || (shared[i] != shared[i - 1])) {
+      osl_memory_usage_add(usage, &usage->structures,
+                           sizeof(osl_dependence_shared_domain));
+      osl_relation_memory_usage(shared[i]->domain, usage);
+    }
+  }
+  osl_allocator_free(shared);
+}
+
 /**
  * osl_dependence_interface function:
  * this function creates an interface structure corresponding to the dependence
@@ -590,6 +1369,7 @@ osl_interface* osl_dependence_interface(void) {
   interface->free = (osl_free_f)osl_dependence_free;
   interface->clone = (osl_clone_f)osl_dependence_clone;
   interface->equal = (osl_equal_f)osl_dependence_equal;
+  interface->size = (osl_size_f)osl_dependence_memory_usage;
 
   return interface;
 }
@@ -155,7 +155,7 @@ char* osl_extbody_sprint(const osl_extbody* const ebody) {
 
     char* const body_string = osl_body_sprint(ebody->body);
     osl_util_safe_strcat(&string, body_string, &high_water_mark);
-    free(body_string);
+    osl_allocator_free(body_string);
   }
 
   return string;
@@ -193,6 +193,7 @@ osl_extbody* osl_extbody_sread(char** const input) {
 
   // Allocate the array of start and length.
   osl_extbody* const ebody = osl_extbody_malloc();
+  osl_error_protect(ebody, (osl_error_cleanup_f)osl_extbody_free);
   OSL_malloc(ebody->start, int*, nb_access_unsigned * sizeof(int));
   OSL_malloc(ebody->length, int*, nb_access_unsigned * sizeof(int));
   ebody->nb_access = nb_access_unsigned;
@@ -206,6 +207,7 @@ osl_extbody* osl_extbody_sread(char** const input) {
   // Read simple body.
   ebody->body = osl_body_sread(input);
 
+  osl_error_unprotect(ebody);
   return ebody;
 }
 
@@ -240,10 +242,10 @@ osl_extbody* osl_extbody_malloc(void) {
  */
 void osl_extbody_free(osl_extbody* const ebody) {
   if (ebody) {
-    free(ebody->start);
-    free(ebody->length);
+    osl_allocator_free(ebody->start);
+    osl_allocator_free(ebody->length);
     osl_body_free(ebody->body);
-    free(ebody);
+    osl_allocator_free(ebody);
   }
 }
 
@@ -322,6 +324,28 @@ bool osl_extbody_equal(const osl_extbody* const e1,
   return osl_body_equal(e1->body, e2->body);
 }
 
+/**
+ * osl_extbody_memory_usage function:
+ * this function adds the memory footprint of an osl_extbody structure (its
+ * body and access coordinates) to a memory usage.
+ * \param[in]     extbody The extbody structure.
+ * \param[in,out] usage   The memory usage to update.
+ */
+void osl_extbody_memory_usage(const osl_extbody* const extbody,
+                              osl_memory_usage* const usage) {
+  if (!extbody)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_extbody));
+  osl_body_memory_usage(extbody->body, usage);
+  if (extbody->nb_access > 0) {
+    osl_memory_usage_add(usage, &usage->structures,
+                         extbody->nb_access * sizeof(int));
+    osl_memory_usage_add(usage, &usage->structures,
+                         extbody->nb_access * sizeof(int));
+  }
+}
+
 /**
  * osl_extbody_interface function:
  * this function creates an interface structure corresponding to the
@@ -339,6 +363,7 @@ osl_interface* osl_extbody_interface(void) {
   interface->free = (osl_free_f)osl_extbody_free;
   interface->clone = (osl_clone_f)osl_extbody_clone;
   interface->equal = (osl_equal_f)osl_extbody_equal;
+  interface->size = (osl_size_f)osl_extbody_memory_usage;
 
   return interface;
 }
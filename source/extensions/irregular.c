@@ -231,7 +231,7 @@ char* osl_irregular_sprint(const osl_irregular* const irregular) {
 
     // Keep only the memory space we need.
     OSL_realloc(string, char*, (strlen(string) + 1) * sizeof(char));
-    free(buffer);
+    osl_allocator_free(buffer);
   }
 
   return string;
@@ -241,6 +241,21 @@ char* osl_irregular_sprint(const osl_irregular* const irregular) {
  *                               Reading function                             *
  ******************************************************************************/
 
+/**
+ * osl_irregular_token internal function:
+ * this function returns the next token of the string being read (see
+ * strtok) and reports an error if there is none.
+ * \param  content The string to read (NULL to continue with the same one).
+ * \param  delim   The delimiters of the token.
+ * \return The next token.
+ */
+static char* osl_irregular_token(char* const content, const char* delim) {
+  char* const tok = strtok(content, delim);
+  if (!tok)
+    OSL_error("irregular too short");
+  return tok;
+}
+
 /**
  * osl_irregular_sread function:
  * this function reads a irregular structure from a string complying to the
@@ -264,54 +279,70 @@ osl_irregular* osl_irregular_sread(char** extensions_fixme) {
     OSL_error("irregular too long");
 
   osl_irregular* const irregular = osl_irregular_malloc();
+  osl_error_protect(irregular, (osl_error_cleanup_f)osl_irregular_free);
 
-  // nb statements
-  char* tok = strtok(content, " \n");
-  irregular->nb_statements = atoi(tok);
-  OSL_malloc(irregular->predicates, int**,
-             sizeof(int*) * irregular->nb_statements);
-  OSL_malloc(irregular->nb_predicates, int*,
-             sizeof(int) * irregular->nb_statements);
+  // nb statements (set once the arrays exist, for osl_irregular_free)
+  char* tok = osl_irregular_token(content, " \n");
+  const int nb_statements = atoi(tok);
+  OSL_malloc(irregular->predicates, int**, sizeof(int*) * nb_statements);
+  OSL_malloc(irregular->nb_predicates, int*, sizeof(int) * nb_statements);
+  for (int i = 0; i < nb_statements; i++)
+    irregular->predicates[i] = NULL;
+  irregular->nb_statements = nb_statements;
 
   // get predicats
   for (int i = 0; i < irregular->nb_statements; i++) {
     // nb conditions
-    tok = strtok(NULL, " \n");
+    tok = osl_irregular_token(NULL, " \n");
     irregular->nb_predicates[i] = atoi(tok);
     OSL_malloc(irregular->predicates[i], int*,
                sizeof(int) * irregular->nb_predicates[i]);
     for (int j = 0; j < irregular->nb_predicates[i]; j++) {
-      tok = strtok(NULL, " \n");
+      tok = osl_irregular_token(NULL, " \n");
       irregular->predicates[i][j] = atoi(tok);
     }
   }
   // Get nb predicat
   // control and exits :
-  tok = strtok(NULL, " \n");
-  irregular->nb_control = atoi(tok);
-  tok = strtok(NULL, " \n");
-  irregular->nb_exit = atoi(tok);
+  tok = osl_irregular_token(NULL, " \n");
+  const int nb_control = atoi(tok);
+  tok = osl_irregular_token(NULL, " \n");
+  const int nb_exit = atoi(tok);
 
-  int nb_predicates = irregular->nb_control + irregular->nb_exit;
+  int nb_predicates = nb_control + nb_exit;
 
   OSL_malloc(irregular->iterators, char***, sizeof(char**) * nb_predicates);
   OSL_malloc(irregular->nb_iterators, int*, sizeof(int) * nb_predicates);
   OSL_malloc(irregular->body, char**, sizeof(char*) * nb_predicates);
+  for (int i = 0; i < nb_predicates; i++) {
+    irregular->iterators[i] = NULL;
+    irregular->nb_iterators[i] = 0;
+    irregular->body[i] = NULL;
+  }
+  irregular->nb_control = nb_control;
+  irregular->nb_exit = nb_exit;
 
   for (int i = 0; i < nb_predicates; i++) {
     // Get number of iterators
-    tok = strtok(NULL, " \n");
-    irregular->nb_iterators[i] = atoi(tok);
+    tok = osl_irregular_token(NULL, " \n");
+    const int nb_iterators = atoi(tok);
     OSL_malloc(irregular->iterators[i], char**,
-               sizeof(char*) * irregular->nb_iterators[i]);
+               sizeof(char*) * nb_iterators);
+    for (int j = 0; j < nb_iterators; j++)
+      irregular->iterators[i][j] = NULL;
+    irregular->nb_iterators[i] = nb_iterators;
 
     // Get iterators
-    for (int j = 0; j < irregular->nb_iterators[i]; j++)
-      OSL_strdup(irregular->iterators[i][j], strtok(NULL, " \n"));
+    for (int j = 0; j < irregular->nb_iterators[i]; j++) {
+      tok = osl_irregular_token(NULL, " \n");
+      OSL_strdup(irregular->iterators[i][j], tok);
+    }
     // Get predicat string
-    OSL_strdup(irregular->body[i], strtok(NULL, "\n"));
+    tok = osl_irregular_token(NULL, "\n");
+    OSL_strdup(irregular->body[i], tok);
   }
 
+  osl_error_unprotect(irregular);
   return irregular;
 }
 
@@ -352,27 +383,27 @@ osl_irregular* osl_irregular_malloc(void) {
 void osl_irregular_free(osl_irregular* const irregular) {
   if (irregular) {
     for (int i = 0; i < irregular->nb_statements; i++)
-      free(irregular->predicates[i]);
+      osl_allocator_free(irregular->predicates[i]);
 
     if (irregular->predicates)
-      free(irregular->predicates);
+      osl_allocator_free(irregular->predicates);
 
     const int nb_predicates = irregular->nb_control + irregular->nb_exit;
     for (int i = 0; i < nb_predicates; i++) {
       for (int j = 0; j < irregular->nb_iterators[i]; j++)
-        free(irregular->iterators[i][j]);
-      free(irregular->iterators[i]);
-      free(irregular->body[i]);
+        osl_allocator_free(irregular->iterators[i][j]);
+      osl_allocator_free(irregular->iterators[i]);
+      osl_allocator_free(irregular->body[i]);
     }
     if (irregular->iterators)
-      free(irregular->iterators);
+      osl_allocator_free(irregular->iterators);
     if (irregular->nb_iterators)
-      free(irregular->nb_iterators);
+      osl_allocator_free(irregular->nb_iterators);
     if (irregular->body)
-      free(irregular->body);
+      osl_allocator_free(irregular->body);
     if (irregular->nb_predicates)
-      free(irregular->nb_predicates);
-    free(irregular);
+      osl_allocator_free(irregular->nb_predicates);
+    osl_allocator_free(irregular);
   }
 }
 
@@ -393,19 +424,20 @@ osl_irregular* osl_irregular_clone(const osl_irregular* irregular) {
 
   osl_irregular* const copy = osl_irregular_malloc();
   copy->nb_statements = irregular->nb_statements;
-  copy->nb_predicates = malloc(sizeof(int) * copy->nb_statements);
+  copy->nb_predicates = osl_allocator_malloc(sizeof(int) * copy->nb_statements);
   if (!copy->nb_predicates) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
-  copy->predicates = malloc(sizeof(int*) * copy->nb_statements);
+  copy->predicates = osl_allocator_malloc(sizeof(int*) * copy->nb_statements);
   if (!copy->predicates) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (int i = 0; i < copy->nb_statements; i++) {
     copy->nb_predicates[i] = irregular->nb_predicates[i];
-    copy->predicates[i] = malloc(sizeof(int) * copy->nb_predicates[i]);
+    copy->predicates[i] =
+        osl_allocator_malloc(sizeof(int) * copy->nb_predicates[i]);
     if (!copy->predicates[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -417,24 +449,25 @@ osl_irregular* osl_irregular_clone(const osl_irregular* irregular) {
   copy->nb_control = irregular->nb_control;
   copy->nb_exit = irregular->nb_exit;
   const int nb_predicates = irregular->nb_control + irregular->nb_exit;
-  copy->nb_iterators = malloc(sizeof(int) * nb_predicates);
+  copy->nb_iterators = osl_allocator_malloc(sizeof(int) * nb_predicates);
   if (!copy->nb_iterators) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
-  copy->iterators = malloc(sizeof(char**) * nb_predicates);
+  copy->iterators = osl_allocator_malloc(sizeof(char**) * nb_predicates);
   if (!copy->iterators) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
-  copy->body = malloc(sizeof(char*) * nb_predicates);
+  copy->body = osl_allocator_malloc(sizeof(char*) * nb_predicates);
   if (!copy->body) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (int i = 0; i < nb_predicates; i++) {
     copy->nb_iterators[i] = irregular->nb_iterators[i];
-    copy->iterators[i] = malloc(sizeof(char*) * copy->nb_iterators[i]);
+    copy->iterators[i] =
+        osl_allocator_malloc(sizeof(char*) * copy->nb_iterators[i]);
     if (!copy->iterators[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -501,9 +534,9 @@ osl_irregular* osl_irregular_add_control(const osl_irregular* const irregular,
   result->nb_statements = irregular->nb_statements;
   const int nb_predicates = result->nb_control + result->nb_exit;
 
-  result->iterators = malloc(sizeof(char**) * nb_predicates);
-  result->nb_iterators = malloc(sizeof(int) * nb_predicates);
-  result->body = malloc(sizeof(char*) * nb_predicates);
+  result->iterators = osl_allocator_malloc(sizeof(char**) * nb_predicates);
+  result->nb_iterators = osl_allocator_malloc(sizeof(int) * nb_predicates);
+  result->body = osl_allocator_malloc(sizeof(char*) * nb_predicates);
   if (!result->iterators || !result->nb_iterators || !result->body) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -512,7 +545,8 @@ osl_irregular* osl_irregular_add_control(const osl_irregular* const irregular,
   for (int i = 0; i < irregular->nb_control; i++) {
     result->nb_iterators[i] = irregular->nb_iterators[i];
     OSL_strdup(result->body[i], irregular->body[i]);
-    result->iterators[i] = malloc(sizeof(char*) * irregular->nb_iterators[i]);
+    result->iterators[i] =
+        osl_allocator_malloc(sizeof(char*) * irregular->nb_iterators[i]);
     if (!result->iterators[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -522,7 +556,7 @@ osl_irregular* osl_irregular_add_control(const osl_irregular* const irregular,
   }
   // add controls
   result->iterators[irregular->nb_control] =
-      malloc(sizeof(char*) * nb_iterators);
+      osl_allocator_malloc(sizeof(char*) * nb_iterators);
   if (!result->iterators[irregular->nb_control]) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -536,7 +570,7 @@ osl_irregular* osl_irregular_add_control(const osl_irregular* const irregular,
     result->nb_iterators[i] = irregular->nb_iterators[i - 1];
     OSL_strdup(result->body[i], irregular->body[i - 1]);
     result->iterators[i] =
-        malloc(sizeof(char*) * irregular->nb_iterators[i - 1]);
+        osl_allocator_malloc(sizeof(char*) * irregular->nb_iterators[i - 1]);
     if (!result->iterators[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -545,14 +579,17 @@ osl_irregular* osl_irregular_add_control(const osl_irregular* const irregular,
       OSL_strdup(result->iterators[i][j], irregular->iterators[i - 1][j]);
   }
   // copy statements
-  result->nb_predicates = malloc(sizeof(int) * irregular->nb_statements);
-  result->predicates = malloc(sizeof(int*) * irregular->nb_statements);
+  result->nb_predicates =
+      osl_allocator_malloc(sizeof(int) * irregular->nb_statements);
+  result->predicates =
+      osl_allocator_malloc(sizeof(int*) * irregular->nb_statements);
   if (!result->nb_predicates || !result->predicates) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (int i = 0; i < irregular->nb_statements; i++) {
-    result->predicates[i] = malloc(sizeof(int) * irregular->nb_predicates[i]);
+    result->predicates[i] =
+        osl_allocator_malloc(sizeof(int) * irregular->nb_predicates[i]);
     if (!result->predicates[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -574,9 +611,9 @@ osl_irregular* osl_irregular_add_exit(const osl_irregular* const irregular,
   result->nb_statements = irregular->nb_statements;
   const int nb_predicates = result->nb_control + result->nb_exit;
 
-  result->iterators = malloc(sizeof(char**) * nb_predicates);
-  result->nb_iterators = malloc(sizeof(int) * nb_predicates);
-  result->body = malloc(sizeof(char*) * nb_predicates);
+  result->iterators = osl_allocator_malloc(sizeof(char**) * nb_predicates);
+  result->nb_iterators = osl_allocator_malloc(sizeof(int) * nb_predicates);
+  result->body = osl_allocator_malloc(sizeof(char*) * nb_predicates);
   if (!result->iterators || !result->nb_iterators || !result->body) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -585,7 +622,8 @@ osl_irregular* osl_irregular_add_exit(const osl_irregular* const irregular,
   for (int i = 0; i < nb_predicates - 1; i++) {
     result->nb_iterators[i] = irregular->nb_iterators[i];
     OSL_strdup(result->body[i], irregular->body[i]);
-    result->iterators[i] = malloc(sizeof(char*) * irregular->nb_iterators[i]);
+    result->iterators[i] =
+        osl_allocator_malloc(sizeof(char*) * irregular->nb_iterators[i]);
     if (!result->iterators[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -594,7 +632,8 @@ osl_irregular* osl_irregular_add_exit(const osl_irregular* const irregular,
       OSL_strdup(result->iterators[i][j], irregular->iterators[i][j]);
   }
   // add exit
-  result->iterators[nb_predicates - 1] = malloc(sizeof(char*) * nb_iterators);
+  result->iterators[nb_predicates - 1] =
+      osl_allocator_malloc(sizeof(char*) * nb_iterators);
   if (!result->iterators[nb_predicates - 1]) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -605,14 +644,17 @@ osl_irregular* osl_irregular_add_exit(const osl_irregular* const irregular,
   result->nb_iterators[nb_predicates - 1] = nb_iterators;
   OSL_strdup(result->body[nb_predicates - 1], body);
   // copy statements
-  result->nb_predicates = malloc(sizeof(int) * irregular->nb_statements);
-  result->predicates = malloc(sizeof(int*) * irregular->nb_statements);
+  result->nb_predicates =
+      osl_allocator_malloc(sizeof(int) * irregular->nb_statements);
+  result->predicates =
+      osl_allocator_malloc(sizeof(int*) * irregular->nb_statements);
   if (!result->nb_predicates || !result->predicates) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (int i = 0; i < irregular->nb_statements; i++) {
-    result->predicates[i] = malloc(sizeof(int) * irregular->nb_predicates[i]);
+    result->predicates[i] =
+        osl_allocator_malloc(sizeof(int) * irregular->nb_predicates[i]);
     if (!result->predicates[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -634,9 +676,9 @@ osl_irregular* osl_irregular_add_predicates(
   result->nb_statements = irregular->nb_statements + 1;
   const int nb_predicates = result->nb_control + result->nb_exit;
 
-  result->iterators = malloc(sizeof(char**) * nb_predicates);
-  result->nb_iterators = malloc(sizeof(int) * nb_predicates);
-  result->body = malloc(sizeof(char*) * nb_predicates);
+  result->iterators = osl_allocator_malloc(sizeof(char**) * nb_predicates);
+  result->nb_iterators = osl_allocator_malloc(sizeof(int) * nb_predicates);
+  result->body = osl_allocator_malloc(sizeof(char*) * nb_predicates);
   if (!result->iterators || !result->nb_iterators || !result->body) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -645,7 +687,8 @@ osl_irregular* osl_irregular_add_predicates(
   for (int i = 0; i < nb_predicates; i++) {
     result->nb_iterators[i] = irregular->nb_iterators[i];
     OSL_strdup(result->body[i], irregular->body[i]);
-    result->iterators[i] = malloc(sizeof(char*) * irregular->nb_iterators[i]);
+    result->iterators[i] =
+        osl_allocator_malloc(sizeof(char*) * irregular->nb_iterators[i]);
     if (!result->iterators[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -654,14 +697,17 @@ osl_irregular* osl_irregular_add_predicates(
       OSL_strdup(result->iterators[i][j], irregular->iterators[i][j]);
   }
   // copy statements
-  result->nb_predicates = malloc(sizeof(int) * result->nb_statements);
-  result->predicates = malloc(sizeof(int*) * result->nb_statements);
+  result->nb_predicates =
+      osl_allocator_malloc(sizeof(int) * result->nb_statements);
+  result->predicates =
+      osl_allocator_malloc(sizeof(int*) * result->nb_statements);
   if (!result->nb_predicates || !result->predicates) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
   }
   for (int i = 0; i < irregular->nb_statements; i++) {
-    result->predicates[i] = malloc(sizeof(int) * irregular->nb_predicates[i]);
+    result->predicates[i] =
+        osl_allocator_malloc(sizeof(int) * irregular->nb_predicates[i]);
     if (!result->predicates[i]) {
       fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
       exit(1);
@@ -672,7 +718,7 @@ osl_irregular* osl_irregular_add_predicates(
   }
   // add statement
   result->predicates[irregular->nb_statements] =
-      malloc(sizeof(int) * nb_add_predicates);
+      osl_allocator_malloc(sizeof(int) * nb_add_predicates);
   if (!result->predicates[irregular->nb_statements]) {
     fprintf(stderr, "[OpenScop] Error: memory overflow.\n");
     exit(1);
@@ -684,6 +730,46 @@ osl_irregular* osl_irregular_add_predicates(
   return result;
 }
 
+/**
+ * osl_irregular_memory_usage function:
+ * this function adds the memory footprint of an osl_irregular structure (its
+ * predicates and their iterators and bodies) to a memory usage.
+ * \param[in]     irregular The irregular structure.
+ * \param[in,out] usage     The memory usage to update.
+ */
+void osl_irregular_memory_usage(const osl_irregular* const irregular,
+                                osl_memory_usage* const usage) {
+  if (!irregular)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_irregular));
+  const int nb_predicates = irregular->nb_control + irregular->nb_exit;
+  if (nb_predicates > 0 && irregular->nb_iterators) {
+    osl_memory_usage_add(usage, &usage->structures,
+                         (size_t)nb_predicates * sizeof(int));
+    osl_memory_usage_add(usage, &usage->strings,
+                         (size_t)nb_predicates * sizeof(char**));
+    osl_memory_usage_add(usage, &usage->strings,
+                         (size_t)nb_predicates * sizeof(char*));
+    for (int i = 0; i < nb_predicates; i++) {
+      osl_memory_usage_add(usage, &usage->strings,
+                           (size_t)irregular->nb_iterators[i] * sizeof(char*));
+      for (int j = 0; j < irregular->nb_iterators[i]; j++)
+        osl_memory_usage_string(usage, irregular->iterators[i][j]);
+      osl_memory_usage_string(usage, irregular->body[i]);
+    }
+  }
+  if (irregular->nb_statements > 0 && irregular->nb_predicates) {
+    osl_memory_usage_add(usage, &usage->structures,
+                         (size_t)irregular->nb_statements * sizeof(int));
+    osl_memory_usage_add(usage, &usage->structures,
+                         (size_t)irregular->nb_statements * sizeof(int*));
+    for (int i = 0; i < irregular->nb_statements; i++)
+      osl_memory_usage_add(usage, &usage->structures,
+                           (size_t)irregular->nb_predicates[i] * sizeof(int));
+  }
+}
+
 /**
  * osl_irregular_interface function:
  * this function creates an interface structure corresponding to the irregular
@@ -701,6 +787,7 @@ osl_interface* osl_irregular_interface(void) {
   interface->free = (osl_free_f)osl_irregular_free;
   interface->clone = (osl_clone_f)osl_irregular_clone;
   interface->equal = (osl_equal_f)osl_irregular_equal;
+  interface->size = (osl_size_f)osl_irregular_memory_usage;
 
   return interface;
 }
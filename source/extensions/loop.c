@@ -252,6 +252,7 @@ osl_loop* osl_loop_sread(char** input) {
   // Allocate the array of id and names.
   osl_loop* const head = osl_loop_malloc();
   osl_loop* loop = head;
+  osl_error_protect(head, (osl_error_cleanup_f)osl_loop_free);
 
   while (nb_loops != 0) {
     loop->iter = osl_util_read_string(NULL, input);
@@ -263,7 +264,7 @@ osl_loop* osl_loop_sread(char** input) {
 
     loop->private_vars = osl_util_read_line(NULL, input);
     if (!strcmp(loop->private_vars, "(null)")) {
-      free(loop->private_vars);
+      osl_allocator_free(loop->private_vars);
       loop->private_vars = NULL;
     }
 
@@ -273,7 +274,7 @@ osl_loop* osl_loop_sread(char** input) {
     if (loop->directive & OSL_LOOP_DIRECTIVE_USER) {
       loop->user = osl_util_read_line(NULL, input);
       if (!strcmp(loop->user, "(null)")) {
-        free(loop->user);
+        osl_allocator_free(loop->user);
         loop->user = NULL;
       }
     }
@@ -285,6 +286,7 @@ osl_loop* osl_loop_sread(char** input) {
     }
   }
 
+  osl_error_unprotect(head);
   return head;
 }
 
@@ -327,17 +329,17 @@ void osl_loop_free(osl_loop* loop) {
     osl_loop* const tmp = loop;
 
     if (loop->iter)
-      free(loop->iter);
+      osl_allocator_free(loop->iter);
     if (loop->stmt_ids)
-      free(loop->stmt_ids);
+      osl_allocator_free(loop->stmt_ids);
     if (loop->private_vars)
-      free(loop->private_vars);
+      osl_allocator_free(loop->private_vars);
     if (loop->user)
-      free(loop->user);
+      osl_allocator_free(loop->user);
 
     loop = loop->next;
 
-    free(tmp);
+    osl_allocator_free(tmp);
   }
 }
 
@@ -522,6 +524,27 @@ bool osl_loop_equal(const osl_loop* a1, const osl_loop* a2) {
   return true;
 }
 
+/**
+ * osl_loop_memory_usage function:
+ * this function adds the memory footprint of an osl_loop list (the nodes,
+ * their strings and statement identifiers) to a memory usage.
+ * \param[in]     loop The loop structure.
+ * \param[in,out] usage The memory usage to update.
+ */
+void osl_loop_memory_usage(const osl_loop* loop,
+                           osl_memory_usage* const usage) {
+  while (loop) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_loop));
+    osl_memory_usage_string(usage, loop->iter);
+    osl_memory_usage_string(usage, loop->private_vars);
+    osl_memory_usage_string(usage, loop->user);
+    if (loop->nb_stmts > 0)
+      osl_memory_usage_add(usage, &usage->structures,
+                           loop->nb_stmts * sizeof(int));
+    loop = loop->next;
+  }
+}
+
 /**
  * osl_loop_interface function:
  * this function creates an interface structure corresponding to the loop
@@ -540,6 +563,7 @@ osl_interface* osl_loop_interface(void) {
   interface->free = (osl_free_f)osl_loop_free;
   interface->clone = (osl_clone_f)osl_loop_clone;
   interface->equal = (osl_equal_f)osl_loop_equal;
+  interface->size = (osl_size_f)osl_loop_memory_usage;
 
   return interface;
 }
@@ -177,7 +177,7 @@ osl_null* osl_null_malloc(void) {
  */
 void osl_null_free(osl_null* null) {
   if (null != NULL) {
-    free(null);
+    osl_allocator_free(null);
   }
 }
 
@@ -220,6 +220,19 @@ bool osl_null_equal(const osl_null* const c1, const osl_null* const c2) {
   return true;
 }
 
+/**
+ * osl_null_memory_usage function:
+ * this function adds the memory footprint of an osl_null structure to a memory
+ * usage.
+ * \param[in]     null The null structure.
+ * \param[in,out] usage The memory usage to update.
+ */
+void osl_null_memory_usage(const osl_null* const null,
+                           osl_memory_usage* const usage) {
+  if (null)
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_null));
+}
+
 /**
  * osl_null_interface function:
  * this function creates an interface structure corresponding to the null
@@ -237,6 +250,7 @@ osl_interface* osl_null_interface(void) {
   interface->free = (osl_free_f)osl_null_free;
   interface->clone = (osl_clone_f)osl_null_clone;
   interface->equal = (osl_equal_f)osl_null_equal;
+  interface->size = (osl_size_f)osl_null_memory_usage;
 
   return interface;
 }
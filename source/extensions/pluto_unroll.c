@@ -205,6 +205,7 @@ char* osl_pluto_unroll_sprint(const osl_pluto_unroll* pluto_unroll) {
 osl_pluto_unroll* osl_pluto_unroll_sread(char** const input) {
   const int count = osl_util_read_int(NULL, input);
   osl_pluto_unroll* const res = count == 1 ? osl_pluto_unroll_malloc() : NULL;
+  osl_error_protect(res, (osl_error_cleanup_f)osl_pluto_unroll_free);
 
   osl_pluto_unroll* current = res;
   while (current != NULL) {
@@ -221,6 +222,7 @@ osl_pluto_unroll* osl_pluto_unroll_sread(char** const input) {
     current = current->next;
   }
 
+  osl_error_unprotect(res);
   return res;
 }
 
@@ -260,8 +262,8 @@ void osl_pluto_unroll_free(osl_pluto_unroll* const pluto_unroll) {
   if (pluto_unroll) {
     osl_pluto_unroll_free(pluto_unroll->next);
 
-    free(pluto_unroll->iter);
-    free(pluto_unroll);
+    osl_allocator_free(pluto_unroll->iter);
+    osl_allocator_free(pluto_unroll);
   }
 }
 
@@ -370,6 +372,22 @@ bool osl_pluto_unroll_equal(const osl_pluto_unroll* a,
   return true;
 }
 
+/**
+ * osl_pluto_unroll_memory_usage function:
+ * this function adds the memory footprint of an osl_pluto_unroll list (the
+ * nodes and their iterator names) to a memory usage.
+ * \param[in]     pluto_unroll The pluto unroll structure.
+ * \param[in,out] usage        The memory usage to update.
+ */
+void osl_pluto_unroll_memory_usage(const osl_pluto_unroll* pluto_unroll,
+                                   osl_memory_usage* const usage) {
+  while (pluto_unroll) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_pluto_unroll));
+    osl_memory_usage_string(usage, pluto_unroll->iter);
+    pluto_unroll = pluto_unroll->next;
+  }
+}
+
 /**
  * osl_pluto_unroll_interface function:
  * this function creates an interface structure corresponding to the
@@ -388,6 +406,7 @@ osl_interface* osl_pluto_unroll_interface(void) {
   interface->free = (osl_free_f)osl_pluto_unroll_free;
   interface->clone = (osl_clone_f)osl_pluto_unroll_clone;
   interface->equal = (osl_equal_f)osl_pluto_unroll_equal;
+  interface->size = (osl_size_f)osl_pluto_unroll_memory_usage;
 
   return interface;
 }
@@ -165,7 +165,7 @@ char* osl_region_sprint(const osl_region* region) {
     char* const extensions_string = osl_generic_sprint(region->extensions);
     sprintf(buffer, "%s\n", extensions_string);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
-    free(extensions_string);
+    osl_allocator_free(extensions_string);
 
     region = region->next;
   }
@@ -190,15 +190,20 @@ osl_region* osl_region_sread(char** input) {
 
   osl_region* const output = osl_region_malloc();
   osl_region* current = output;
+  osl_error_protect(output, (osl_error_cleanup_f)osl_region_free);
   for (int i = 0; i < region_count; ++i) {
     current->location = osl_util_read_int(NULL, input);
 
     const int extension_count = osl_util_read_int(NULL, input);
     osl_interface* const registry = osl_interface_get_default_registry();
+    osl_error_protect(registry, (osl_error_cleanup_f)osl_interface_free);
     for (int j = 0; j < extension_count; ++j) {
       osl_generic* const extension = osl_generic_sread_one(input, registry);
+      osl_error_protect(extension, (osl_error_cleanup_f)osl_generic_free);
       osl_generic_add(&current->extensions, extension);
+      osl_error_unprotect(extension);
     }
+    osl_error_unprotect(registry);
     osl_interface_free(registry);
 
     if (i + 1 < region_count) {
@@ -207,6 +212,7 @@ osl_region* osl_region_sread(char** input) {
     }
   }
 
+  osl_error_unprotect(output);
   return output;
 }
 
@@ -215,7 +221,7 @@ osl_region* osl_region_sread(char** input) {
  ******************************************************************************/
 
 osl_region* osl_region_malloc(void) {
-  osl_region* const region = malloc(sizeof *region);
+  osl_region* const region = osl_allocator_malloc(sizeof *region);
   if (!region) {
     fprintf(stderr, "[osl] Error: memory overflow (%s).\n", __func__);
     exit(1);
@@ -239,7 +245,7 @@ void osl_region_free(osl_region* region) {
     region = region->next;
 
     /* Do not forget to free the current region. */
-    free(tmp);
+    osl_allocator_free(tmp);
   }
 }
 
@@ -338,6 +344,15 @@ void osl_region_append_postlude(osl_region* const region,
   }
 }
 
+void osl_region_memory_usage(const osl_region* region,
+                             osl_memory_usage* const usage) {
+  while (region) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_region));
+    osl_generic_memory_usage(region->extensions, usage);
+    region = region->next;
+  }
+}
+
 osl_interface* osl_region_interface(void) {
   osl_interface* const interface = osl_interface_malloc();
 
@@ -350,6 +365,7 @@ osl_interface* osl_region_interface(void) {
   interface->free = (osl_free_f)osl_region_free;
   interface->clone = (osl_clone_f)osl_region_clone;
   interface->equal = (osl_equal_f)osl_region_equal;
+  interface->size = (osl_size_f)osl_region_memory_usage;
 
   return interface;
 }
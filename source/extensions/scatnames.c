@@ -148,7 +148,9 @@ osl_scatnames* osl_scatnames_sread(char** input) {
   osl_scatnames* scatnames = NULL;
   osl_strings* const names = osl_strings_sread(input);
   if (names) {
+    osl_error_protect(names, (osl_error_cleanup_f)osl_strings_free);
     scatnames = osl_scatnames_malloc();
+    osl_error_unprotect(names);
     scatnames->names = names;
   }
 
@@ -185,7 +187,7 @@ osl_scatnames* osl_scatnames_malloc(void) {
 void osl_scatnames_free(osl_scatnames* scatnames) {
   if (scatnames) {
     osl_strings_free(scatnames->names);
-    free(scatnames);
+    osl_allocator_free(scatnames);
   }
 }
 
@@ -232,6 +234,22 @@ bool osl_scatnames_equal(const osl_scatnames* const s1,
   return true;
 }
 
+/**
+ * osl_scatnames_memory_usage function:
+ * this function adds the memory footprint of an osl_scatnames structure (and
+ * its names) to a memory usage.
+ * \param[in]     scatnames The scatnames structure.
+ * \param[in,out] usage     The memory usage to update.
+ */
+void osl_scatnames_memory_usage(const osl_scatnames* const scatnames,
+                                osl_memory_usage* const usage) {
+  if (!scatnames)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_scatnames));
+  osl_strings_memory_usage(scatnames->names, usage);
+}
+
 /**
  * osl_scatnames_interface function:
  * this function creates an interface structure corresponding to the scatnames
@@ -249,6 +267,7 @@ osl_interface* osl_scatnames_interface(void) {
   interface->free = (osl_free_f)osl_scatnames_free;
   interface->clone = (osl_clone_f)osl_scatnames_clone;
   interface->equal = (osl_equal_f)osl_scatnames_equal;
+  interface->size = (osl_size_f)osl_scatnames_memory_usage;
 
   return interface;
 }
@@ -65,6 +65,7 @@
 #include <osl/interface.h>
 #include <osl/macros.h>
 #include <osl/relation.h>
+#include <osl/strings.h>
 #include <osl/util.h>
 
 #include <osl/extensions/symbols.h>
@@ -248,28 +249,28 @@ char* osl_symbols_sprint(const osl_symbols* symbols) {
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->identifier);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    osl_allocator_free(temp);
 
     // Printing Datatype
     sprintf(buffer, "\n# %d.5 Datatype\n", i);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->datatype);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    osl_allocator_free(temp);
 
     // Printing Scope
     sprintf(buffer, "\n# %d.6 Scope\n", i);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->scope);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    osl_allocator_free(temp);
 
     // Printing Extent
     sprintf(buffer, "\n# %d.7 Extent\n", i);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
     temp = osl_generic_sprint(symbols->extent);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    osl_allocator_free(temp);
 
     symbols = symbols->next;
   }
@@ -298,9 +299,6 @@ osl_symbols* osl_symbols_sread(char** input) {
     return NULL;
   }
 
-  if (strlen(*input) > OSL_MAX_STRING)
-    OSL_error("symbols too long");
-
   // Find the number of names provided.
   int nb_symbols = osl_util_read_int(NULL, input);
 
@@ -309,7 +307,9 @@ osl_symbols* osl_symbols_sread(char** input) {
 
   osl_symbols* const head = osl_symbols_malloc();
   osl_symbols* symbols = head;
+  osl_error_protect(head, (osl_error_cleanup_f)osl_symbols_free);
   osl_interface* const registry = osl_interface_get_default_registry();
+  osl_error_protect(registry, (osl_error_cleanup_f)osl_interface_free);
 
   while (nb_symbols != 0) {
     // Reading the type of symbol
@@ -325,7 +325,7 @@ osl_symbols* osl_symbols_sread(char** input) {
         symbols->type = OSL_SYMBOL_TYPE_FUNCTION;
       else
         symbols->type = OSL_UNDEFINED;
-      free(type);
+      osl_allocator_free(type);
     }
 
     // Reading origin of symbol
@@ -353,7 +353,9 @@ osl_symbols* osl_symbols_sread(char** input) {
     }
   }
 
+  osl_error_unprotect(registry);
   osl_interface_free(registry);
+  osl_error_unprotect(head);
   return head;
 }
 
@@ -380,6 +382,7 @@ osl_symbols* osl_symbols_malloc(void) {
   symbols->datatype = NULL;
   symbols->scope = NULL;
   symbols->extent = NULL;
+  symbols->index = NULL;
   symbols->next = NULL;
 
   return symbols;
@@ -398,7 +401,8 @@ void osl_symbols_free(osl_symbols* symbols) {
     osl_generic_free(symbols->datatype);
     osl_generic_free(symbols->scope);
     osl_generic_free(symbols->extent);
-    free(symbols);
+    osl_symbols_invalidate(symbols);
+    osl_allocator_free(symbols);
     symbols = tmp;
   }
 }
@@ -407,18 +411,148 @@ void osl_symbols_free(osl_symbols* symbols) {
  *                            Processing functions                            *
  ******************************************************************************/
 
+/**
+ * osl_symbols_identifier_hash internal function:
+ * this function returns a hash of a symbol identifier, consistent with
+ * osl_generic_equal: the nodes may be in any order and only the content of
+ * the strings identifiers is hashed (other identifiers are hashed by URI).
+ * \param[in] identifier The identifier to hash.
+ * \return The hash of the identifier.
+ */
+static size_t osl_symbols_identifier_hash(const osl_generic* identifier) {
+  size_t hash = 0;
+
+  for (; identifier; identifier = identifier->next) {
+    size_t node = 0;
+    if (identifier->interface) {
+      node = osl_util_hash(identifier->interface->URI);
+      if (!strcmp(identifier->interface->URI, OSL_URI_STRINGS) &&
+          identifier->data) {
+        const osl_strings* const strings = identifier->data;
+        for (size_t i = 0; strings->string && strings->string[i]; i++)
+          node = (node ^ osl_util_hash(strings->string[i])) * 16777619u;
+      }
+    }
+    hash += node;
+  }
+
+  return hash;
+}
+
+/**
+ * osl_symbols_index_insert internal function:
+ * this function records a symbol in the hash index of its list. Equal
+ * identifiers are placed after the previous ones, hence the lookups find
+ * the first symbol with a given identifier.
+ * \param[in,out] index  The hash index.
+ * \param[in]     symbol The symbol to record.
+ */
+static void osl_symbols_index_insert(osl_symbols_index* const index,
+                                     osl_symbols* const symbol) {
+  const size_t hash = osl_symbols_identifier_hash(symbol->identifier);
+  const size_t mask = index->nb_buckets - 1;
+  size_t bucket = hash & mask;
+
+  while (index->symbol[bucket])
+    bucket = (bucket + 1) & mask;
+  index->hash[bucket] = hash;
+  index->symbol[bucket] = symbol;
+}
+
+/**
+ * osl_symbols_index_extend internal function:
+ * this function records the symbols appended after the last indexed node in
+ * the hash index of a list, growing the index as needed.
+ * \param[in,out] index The hash index.
+ */
+static void osl_symbols_index_extend(osl_symbols_index* const index) {
+  while (index->last->next) {
+    index->last = index->last->next;
+    index->nb_symbols++;
+
+    if (2 * index->nb_symbols > index->nb_buckets) {
+      osl_allocator_free(index->hash);
+      osl_allocator_free(index->symbol);
+      index->nb_buckets *= 2;
+      OSL_malloc(index->hash, size_t*, index->nb_buckets * sizeof(size_t));
+      OSL_malloc(index->symbol, osl_symbols**,
+                 index->nb_buckets * sizeof(osl_symbols*));
+      for (size_t i = 0; i < index->nb_buckets; i++)
+        index->symbol[i] = NULL;
+
+      // Insert the symbols again in list order, to keep the first ones first.
+      for (osl_symbols* s = index->head; s != index->last; s = s->next)
+        osl_symbols_index_insert(index, s);
+    }
+    osl_symbols_index_insert(index, index->last);
+  }
+}
+
+/**
+ * osl_symbols_index_build internal function:
+ * this function builds a hash index over the identifiers of a symbols list.
+ * \param[in] symbols The first node of the symbols list.
+ * \return The hash index of the list.
+ */
+static osl_symbols_index* osl_symbols_index_build(
+    osl_symbols* const symbols) {
+  osl_symbols_index* index;
+  const size_t nb_symbols = (size_t)osl_symbols_get_nb_symbols(symbols);
+
+  OSL_malloc(index, osl_symbols_index*, sizeof(osl_symbols_index));
+  index->head = symbols;
+  index->last = symbols;
+  index->nb_symbols = 1;
+  index->nb_buckets = 16;
+  while (index->nb_buckets < 2 * nb_symbols)
+    index->nb_buckets *= 2;
+  OSL_malloc(index->hash, size_t*, index->nb_buckets * sizeof(size_t));
+  OSL_malloc(index->symbol, osl_symbols**,
+             index->nb_buckets * sizeof(osl_symbols*));
+  for (size_t i = 0; i < index->nb_buckets; i++)
+    index->symbol[i] = NULL;
+
+  osl_symbols_index_insert(index, symbols);
+  osl_symbols_index_extend(index);
+  return index;
+}
+
+/**
+ * osl_symbols_index_free internal function:
+ * this function frees the memory of a hash index over a symbols list.
+ * \param[in] index The hash index to free.
+ */
+static void osl_symbols_index_free(osl_symbols_index* const index) {
+  if (index) {
+    osl_allocator_free(index->hash);
+    osl_allocator_free(index->symbol);
+    osl_allocator_free(index);
+  }
+}
+
 /**
  * osl_symbols_add function:
  * this function adds a scop "scop" at the end of the symbols list pointed
- * by "location".
+ * by "location". If the list has a lookup index (see osl_symbols_lookup),
+ * the symbols are added in constant time and recorded in the index.
  * \param[in,out] location  Address of the first element of the symbols list.
  * \param[in]     symbols   The symbols to add to the list.
  */
 void osl_symbols_add(osl_symbols** location, osl_symbols* const symbols) {
+  osl_symbols_index* const index = *location ? (*location)->index : NULL;
+
+  // Only the first node of a list has an index.
+  if (symbols && *location)
+    osl_symbols_invalidate(symbols);
+
+  if (index)
+    location = &index->last->next;
   while (*location)
     location = &((*location)->next);
 
   *location = symbols;
+  if (index)
+    osl_symbols_index_extend(index);
 }
 
 /**
@@ -431,6 +565,7 @@ void osl_symbols_add(osl_symbols** location, osl_symbols* const symbols) {
  */
 osl_symbols* osl_symbols_nclone(const osl_symbols* symbols, const int n) {
   osl_symbols* clone = NULL;
+  osl_symbols** last = &clone;
   osl_symbols* new;
   int i = 0;
 
@@ -444,7 +579,8 @@ osl_symbols* osl_symbols_nclone(const osl_symbols* symbols, const int n) {
     new->scope = osl_generic_clone(symbols->scope);
     new->extent = osl_generic_clone(symbols->extent);
 
-    osl_symbols_add(&clone, new);
+    *last = new;
+    last = &new->next;
     symbols = symbols->next;
     i++;
   }
@@ -472,23 +608,20 @@ osl_symbols* osl_symbols_clone(const osl_symbols* const symbols) {
  * \return 1 if c1 and c2 are the same (content-wise), 0 otherwise.
  */
 bool osl_symbols_equal(const osl_symbols* c1, const osl_symbols* c2) {
-  if (c1 == c2)
-    return true;
-
-  if ((!c1 && c2) || (c1 && !c2))
-    return false;
-
-  if (c1->type == c2->type && c1->generated == c2->generated &&
-      c1->nb_dims == c2->nb_dims) {
-    if (osl_generic_equal(c1->identifier, c2->identifier)) {
-      if (osl_generic_equal(c1->datatype, c2->datatype)) {
-        if (osl_generic_equal(c1->scope, c2->scope)) {
-          if (osl_generic_equal(c1->extent, c2->extent)) {
-            return false;
-          }
-        }
-      }
-    }
+  while (c1 != c2) {
+    if ((!c1 && c2) || (c1 && !c2))
+      return false;
+
+    if (c1->type != c2->type || c1->generated != c2->generated ||
+        c1->nb_dims != c2->nb_dims ||
+        !osl_generic_equal(c1->identifier, c2->identifier) ||
+        !osl_generic_equal(c1->datatype, c2->datatype) ||
+        !osl_generic_equal(c1->scope, c2->scope) ||
+        !osl_generic_equal(c1->extent, c2->extent))
+      return false;
+
+    c1 = c1->next;
+    c2 = c2->next;
   }
 
   return true;
@@ -511,6 +644,121 @@ int osl_symbols_get_nb_symbols(const osl_symbols* symbols) {
   return nb_symbols;
 }
 
+/**
+ * osl_symbols_lookup function:
+ * this function returns the first symbol of a symbols list with a given
+ * identifier (see osl_generic_equal), or NULL if there is none. It relies
+ * on a hash index which is attached to the first node of the list on the
+ * first call, hence it runs in constant time. The index is published
+ * atomically, so that the list may be searched by several threads at once.
+ * It follows osl_symbols_add and osl_symbols_remove; the symbols appended
+ * otherwise are searched linearly, and osl_symbols_invalidate has to be
+ * called when a symbol is removed otherwise or its identifier is modified.
+ * \param[in,out] symbols    The symbols list where to find the identifier.
+ * \param[in]     identifier The identifier to look for.
+ * \return The first symbol with the identifier, NULL if there is none.
+ */
+osl_symbols* osl_symbols_lookup(osl_symbols* const symbols,
+                                osl_generic* const identifier) {
+  if (!symbols || !identifier)
+    return NULL;
+
+  osl_symbols_index* index =
+      __atomic_load_n(&symbols->index, __ATOMIC_ACQUIRE);
+  if (!index) {
+    osl_symbols_index* const built = osl_symbols_index_build(symbols);
+    if (__atomic_compare_exchange_n(&symbols->index, &index, built, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      index = built;
+    } else {
+      osl_symbols_index_free(built);
+    }
+  }
+
+  osl_symbols* appended = symbols;
+  if (index->head == symbols) {
+    const size_t hash = osl_symbols_identifier_hash(identifier);
+    const size_t mask = index->nb_buckets - 1;
+    size_t bucket = hash & mask;
+
+    while (index->symbol[bucket]) {
+      if ((index->hash[bucket] == hash) &&
+          osl_generic_equal(index->symbol[bucket]->identifier, identifier))
+        return index->symbol[bucket];
+      bucket = (bucket + 1) & mask;
+    }
+    appended = index->last->next;
+  }
+
+  for (; appended; appended = appended->next)
+    if (osl_generic_equal(appended->identifier, identifier))
+      return appended;
+
+  return NULL;
+}
+
+/**
+ * osl_symbols_remove function:
+ * this function removes a symbol from a symbols list and returns it (it
+ * is not freed), or returns NULL if the symbol is not in the list. The
+ * lookup index of the list is dropped (see osl_symbols_lookup).
+ * \param[in,out] location Address of the first element of the symbols list.
+ * \param[in]     symbol   The symbol to remove.
+ * \return The removed symbol, NULL if it is not in the list.
+ */
+osl_symbols* osl_symbols_remove(osl_symbols** location,
+                                osl_symbols* const symbol) {
+  if (!*location || !symbol)
+    return NULL;
+
+  osl_symbols_invalidate(*location);
+  while (*location && (*location != symbol))
+    location = &(*location)->next;
+  if (!*location)
+    return NULL;
+
+  *location = symbol->next;
+  symbol->next = NULL;
+  return symbol;
+}
+
+/**
+ * osl_symbols_invalidate function:
+ * this function drops the lookup index of a symbols list (see
+ * osl_symbols_lookup). It has to be called when a symbol is removed from
+ * the list without osl_symbols_remove or when an identifier is modified.
+ * \param[in,out] symbols The first node of the symbols list.
+ */
+void osl_symbols_invalidate(osl_symbols* const symbols) {
+  osl_symbols_index_free(symbols->index);
+  symbols->index = NULL;
+}
+
+/**
+ * osl_symbols_memory_usage function:
+ * this function adds the memory footprint of an osl_symbols list (the nodes
+ * and their generics) to a memory usage.
+ * \param[in]     symbols The symbols structure.
+ * \param[in,out] usage   The memory usage to update.
+ */
+void osl_symbols_memory_usage(const osl_symbols* symbols,
+                              osl_memory_usage* const usage) {
+  while (symbols) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_symbols));
+    osl_generic_memory_usage(symbols->identifier, usage);
+    osl_generic_memory_usage(symbols->datatype, usage);
+    osl_generic_memory_usage(symbols->scope, usage);
+    osl_generic_memory_usage(symbols->extent, usage);
+    if (symbols->index) {
+      osl_memory_usage_add(usage, &usage->indexes, sizeof(osl_symbols_index));
+      osl_memory_usage_add(
+          usage, &usage->indexes,
+          symbols->index->nb_buckets * (sizeof(size_t) + sizeof(osl_symbols*)));
+    }
+    symbols = symbols->next;
+  }
+}
+
 /**
  * osl_symbols_interface function:
  * this function creates an interface structure corresponding to the symbols
@@ -528,5 +776,6 @@ osl_interface* osl_symbols_interface(void) {
   interface->free = (osl_free_f)osl_symbols_free;
   interface->clone = (osl_clone_f)osl_symbols_clone;
   interface->equal = (osl_equal_f)osl_symbols_equal;
+  interface->size = (osl_size_f)osl_symbols_memory_usage;
   return interface;
 }
@@ -109,7 +109,7 @@ void osl_textual_idump(FILE* const file, const osl_textual* const textual,
     } else {
       fprintf(file, "%s\n", tmp);
     }
-    free(tmp);
+    osl_allocator_free(tmp);
   } else {
     fprintf(file, "+-- NULL textual\n");
   }
@@ -144,7 +144,7 @@ char * osl_textual_sprint(const osl_textual* const textual) {
     if (strlen(textual->textual) > OSL_MAX_STRING) 
       OSL_error("textual too long");
     
-    string = strdup(textual->textual);
+    string = osl_util_strdup(textual->textual);
     if (!string)
       OSL_error("memory overflow");
   }
@@ -184,7 +184,9 @@ osl_textual* osl_textual_sread(char** const extensions) {
 
   if (*extensions) {
     textual = osl_textual_malloc();
+    osl_error_protect(textual, (osl_error_cleanup_f)osl_textual_free);
     OSL_strdup(textual->textual, *extensions);
+    osl_error_unprotect(textual);
 
     // Update the input string pointer to the end of the string (since
     // everything has been read).
@@ -224,8 +226,8 @@ osl_textual* osl_textual_malloc(void) {
 void osl_textual_free(osl_textual* const textual) {
   if (textual) {
     if (textual->textual)
-      free(textual->textual);
-    free(textual);
+      osl_allocator_free(textual->textual);
+    osl_allocator_free(textual);
   }
 }
 
@@ -292,6 +294,22 @@ bool osl_textual_equal(const osl_textual* const f1,
 }
 #endif
 
+/**
+ * osl_textual_memory_usage function:
+ * this function adds the memory footprint of an osl_textual structure (and its
+ * text) to a memory usage.
+ * \param[in]     textual The textual structure.
+ * \param[in,out] usage   The memory usage to update.
+ */
+void osl_textual_memory_usage(const osl_textual* const textual,
+                              osl_memory_usage* const usage) {
+  if (!textual)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_textual));
+  osl_memory_usage_string(usage, textual->textual);
+}
+
 /**
  * osl_textual_interface function:
  * this function creates an interface structure corresponding to the textual
@@ -309,6 +327,7 @@ osl_interface* osl_textual_interface(void) {
   interface->free = (osl_free_f)osl_textual_free;
   interface->clone = (osl_clone_f)osl_textual_clone;
   interface->equal = (osl_equal_f)osl_textual_equal;
+  interface->size = (osl_size_f)osl_textual_memory_usage;
 
   return interface;
 }
@@ -142,12 +142,15 @@ char* osl_generic_sprint(const osl_generic* generic) {
 
   while (generic) {
     if (generic->interface) {
+      OSL_probe1(generic__print__start, generic->interface->URI);
       char* const content = generic->interface->sprint(generic->data);
+      OSL_probe2(generic__print__done, generic->interface->URI,
+                 content ? strlen(content) : 0);
       if (content) {
         sprintf(buffer, "<%s>\n", generic->interface->URI);
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
         osl_util_safe_strcat(&string, content, &high_water_mark);
-        free(content);
+        osl_allocator_free(content);
         sprintf(buffer, "</%s>\n", generic->interface->URI);
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
       }
@@ -173,7 +176,7 @@ void osl_generic_print(FILE* const file, const osl_generic* const generic) {
   char* const string = osl_generic_sprint(generic);
   if (string) {
     fprintf(file, "%s", string);
-    free(string);
+    osl_allocator_free(string);
   }
 }
 
@@ -191,7 +194,7 @@ void osl_generic_print_options_scoplib(FILE* const file,
   char* const string = osl_arrays_sprint(arrays);
   if (string) {
     fprintf(file, "<arrays>\n%s</arrays>\n", string);
-    free(string);
+    osl_allocator_free(string);
   }
 }
 
@@ -216,9 +219,42 @@ osl_generic* osl_generic_sread(char** const input,
 
   while (**input != '\0') {
     osl_generic* const new = osl_generic_sread_one(input, registry);
+    osl_error_protect(new, (osl_error_cleanup_f)osl_generic_free);
     osl_generic_add(&generic, new);
+    // The list head remains protected.
+    if (generic != new)
+      osl_error_unprotect(new);
   }
 
+  osl_error_unprotect(generic);
+  return generic;
+}
+
+/**
+ * osl_generic_sread_content internal function:
+ * this function builds a generic structure from the tag and the content of
+ * a generic read by osl_generic_sread_one or osl_generic_read_one.
+ * \param[in] tag      The tag of the generic (its URI).
+ * \param[in] content  The content of the generic, between its tags.
+ * \param[in] registry The list of known interfaces (others are ignored).
+ * \return A pointer to the generic structure, NULL if the URI is unknown.
+ */
+static osl_generic* osl_generic_sread_content(const char* const tag,
+                                              char* const content,
+                                              osl_interface* const registry) {
+  osl_interface* const interface = osl_interface_lookup(registry, tag);
+  if (!interface) {
+    OSL_warning("unsupported generic");
+    fprintf(stderr, "[osl] Warning: unknown URI \"%s\".\n", tag);
+    return NULL;
+  }
+
+  char* temp = content;
+  osl_generic* const generic = osl_generic_malloc();
+  generic->interface = osl_interface_nclone(interface, 1);
+  osl_error_protect(generic, (osl_error_cleanup_f)osl_generic_free);
+  generic->data = interface->sread(&temp);
+  osl_error_unprotect(generic);
   return generic;
 }
 
@@ -235,28 +271,31 @@ osl_generic* osl_generic_sread(char** const input,
  */
 osl_generic* osl_generic_sread_one(char** const input,
                                    osl_interface* const registry) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe(generic__read__start);
+
   char* const tag = osl_util_read_tag(NULL, input);
+  osl_generic* generic = NULL;
+  size_t size = 0;
   if (!tag || (strlen(tag) < 1) || (tag[0] == '/')) {
     OSL_debug("empty tag name or closing tag instead of an opening one");
-    return NULL;
-  }
-
-  char* const content = osl_util_read_uptoendtag(NULL, input, tag);
-  osl_interface* const interface = osl_interface_lookup(registry, tag);
-
-  char* temp = content;
-  osl_generic* generic = NULL;
-  if (!interface) {
-    OSL_warning("unsupported generic");
-    fprintf(stderr, "[osl] Warning: unknown URI \"%s\".\n", tag);
   } else {
-    generic = osl_generic_malloc();
-    generic->interface = osl_interface_nclone(interface, 1);
-    generic->data = interface->sread(&temp);
+    osl_error_protect(tag, osl_allocator_free);
+    char* const content = osl_util_read_uptoendtag(NULL, input, tag);
+    if (!content)
+      OSL_error("end tag not found");
+    osl_error_protect(content, osl_allocator_free);
+    generic = osl_generic_sread_content(tag, content, registry);
+    size = strlen(content);
+    osl_error_unprotect(content);
+    osl_error_unprotect(tag);
+    osl_allocator_free(content);
   }
 
-  free(content);
-  free(tag);
+  OSL_probe2(generic__read__done, tag, size);
+  osl_allocator_free(tag);
+  OSL_perf_end(OSL_PERF_GENERIC_READ, &mark);
   return generic;
 }
 
@@ -273,28 +312,31 @@ osl_generic* osl_generic_sread_one(char** const input,
  */
 osl_generic* osl_generic_read_one(FILE* const file,
                                   osl_interface* const registry) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe(generic__read__start);
+
   char* const tag = osl_util_read_tag(file, NULL);
+  osl_generic* generic = NULL;
+  size_t size = 0;
   if (!tag || (strlen(tag) < 1) || (tag[0] == '/')) {
     OSL_debug("empty tag name or closing tag instead of an opening one");
-    return NULL;
-  }
-
-  char* const content = osl_util_read_uptoendtag(file, NULL, tag);
-  osl_interface* const interface = osl_interface_lookup(registry, tag);
-
-  char* temp = content;
-  osl_generic* generic = NULL;
-  if (!interface) {
-    OSL_warning("unsupported generic");
-    fprintf(stderr, "[osl] Warning: unknown URI \"%s\".\n", tag);
   } else {
-    generic = osl_generic_malloc();
-    generic->interface = osl_interface_nclone(interface, 1);
-    generic->data = interface->sread(&temp);
+    osl_error_protect(tag, osl_allocator_free);
+    char* const content = osl_util_read_uptoendtag(file, NULL, tag);
+    if (!content)
+      OSL_error("end tag not found");
+    osl_error_protect(content, osl_allocator_free);
+    generic = osl_generic_sread_content(tag, content, registry);
+    size = strlen(content);
+    osl_error_unprotect(content);
+    osl_error_unprotect(tag);
+    osl_allocator_free(content);
   }
 
-  free(content);
-  free(tag);
+  OSL_probe2(generic__read__done, tag, size);
+  osl_allocator_free(tag);
+  OSL_perf_end(OSL_PERF_GENERIC_READ, &mark);
   return generic;
 }
 
@@ -310,9 +352,13 @@ osl_generic* osl_generic_read_one(FILE* const file,
 osl_generic* osl_generic_read(FILE* const file, osl_interface* const registry) {
   char* const generic_string =
       osl_util_read_uptoendtag(file, NULL, OSL_URI_SCOP);
+  if (!generic_string)
+    OSL_error("end of scop tag not found");
   char* temp = generic_string;
+  osl_error_protect(generic_string, osl_allocator_free);
   osl_generic* const generic_list = osl_generic_sread(&temp, registry);
-  free(generic_string);
+  osl_error_unprotect(generic_string);
+  osl_allocator_free(generic_string);
   return generic_list;
 }
 
@@ -351,6 +397,7 @@ void osl_generic_add(osl_generic** list, osl_generic* generic) {
     } else {
       *list = generic;
     }
+    (*list)->list_generation = osl_util_generation();
   }
 }
 
@@ -371,6 +418,8 @@ void osl_generic_remove_node(osl_generic** list, osl_generic* generic) {
         *list = generic->next;
         generic->next = NULL;  // free below removes the whole list!
         osl_generic_free(generic);
+        if (*list)
+          (*list)->list_generation = osl_util_generation();
         return;
       }
 
@@ -383,6 +432,7 @@ void osl_generic_remove_node(osl_generic** list, osl_generic* generic) {
         tmp->next = generic->next;
         generic->next = NULL;  // free below removes the whole list!
         osl_generic_free(generic);
+        (*list)->list_generation = osl_util_generation();
       } else  // target not found
         OSL_warning("generic not found in the list\n");
     }
@@ -423,6 +473,8 @@ osl_generic* osl_generic_malloc(void) {
   OSL_malloc(generic, osl_generic*, sizeof(osl_generic));
   generic->interface = NULL;
   generic->data = NULL;
+  generic->generation = osl_util_generation();
+  generic->list_generation = generic->generation;
   generic->next = NULL;
 
   return generic;
@@ -442,14 +494,60 @@ void osl_generic_free(osl_generic* generic) {
     } else {
       if (generic->data) {
         OSL_warning("unregistered interface, memory leaks are possible");
-        free(generic->data);
+        osl_allocator_free(generic->data);
       }
     }
-    free(generic);
+    osl_allocator_free(generic);
     generic = next;
   }
 }
 
+/**
+ * osl_generic_index_build function:
+ * this function builds a lookup table over a generic list (see the
+ * osl_generic_index structure). The list must not be modified while the
+ * index is in use.
+ * \param[in] list The generic list to index.
+ * \return A pointer to the index of the list.
+ */
+osl_generic_index* osl_generic_index_build(const osl_generic* const list) {
+  osl_generic_index* index;
+
+  OSL_malloc(index, osl_generic_index*, sizeof(osl_generic_index));
+  index->list = list;
+  index->generation = list ? list->list_generation : 0;
+  index->others = false;
+  for (int i = 0; i < OSL_INTERFACE_SLOTS; i++)
+    index->slot[i] = NULL;
+
+  for (const osl_generic* x = list; x; x = x->next) {
+    int slot = -1;
+    if (x->interface) {
+      slot = osl_interface_slot(x->interface);
+      if (slot == -1)
+        slot = osl_interface_URI_slot(x->interface->URI);
+    }
+
+    // Only the first generic with a given URI is visible, as for lookups.
+    if (slot == -1)
+      index->others = true;
+    else if (!index->slot[slot])
+      index->slot[slot] = (osl_generic*)x;
+  }
+
+  return index;
+}
+
+/**
+ * osl_generic_index_free function:
+ * this function frees the allocated memory for a generic index. The indexed
+ * generic list is left untouched.
+ * \param[in] index The pointer to the index we want to free.
+ */
+void osl_generic_index_free(osl_generic_index* const index) {
+  osl_allocator_free(index);
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
@@ -588,6 +686,41 @@ bool osl_generic_equal(const osl_generic* x1, const osl_generic* x2) {
   return 1;
 }
 
+/**
+ * osl_generic_memory_usage function:
+ * this function adds the memory footprint of a generic list to a memory
+ * usage. The data of each generic is measured by the size function of its
+ * interface and counted in the extensions category (without its allocator
+ * overhead). Without size function, the length of the textual form of the
+ * data is used as an estimate.
+ * \param[in]     generic The generic list.
+ * \param[in,out] usage   The memory usage to update.
+ */
+void osl_generic_memory_usage(const osl_generic* generic,
+                              osl_memory_usage* const usage) {
+  while (generic) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_generic));
+    osl_interface_memory_usage(generic->interface, usage);
+
+    if (generic->data && generic->interface) {
+      osl_memory_usage data;
+      osl_memory_usage_init(&data);
+      if (generic->interface->size) {
+        generic->interface->size(generic->data, &data);
+      } else if (generic->interface->sprint) {
+        char* const string = generic->interface->sprint(generic->data);
+        if (string)
+          osl_memory_usage_add(&data, &data.extensions, strlen(string) + 1);
+        osl_allocator_free(string);
+      }
+      usage->extensions += osl_memory_usage_total(&data) - data.overhead;
+      usage->overhead += data.overhead;
+    }
+
+    generic = generic->next;
+  }
+}
+
 /**
  * osl_generic_has_URI function:
  * this function returns 1 if the generic provided as parameter has
@@ -597,11 +730,10 @@ bool osl_generic_equal(const osl_generic* x1, const osl_generic* x2) {
  * \return 1 if x has the provided URI, 0 otherwise.
  */
 bool osl_generic_has_URI(const osl_generic* const x, char const* const URI) {
-  if (!x || !x->interface || !x->interface->URI ||
-      (strcmp(x->interface->URI, URI)))
+  if (!x || !x->interface || !x->interface->URI)
     return false;
 
-  return true;
+  return (x->interface->URI == URI) || !strcmp(x->interface->URI, URI);
 }
 
 /**
@@ -614,8 +746,14 @@ bool osl_generic_has_URI(const osl_generic* const x, char const* const URI) {
  * \return The first generic of the requested URI in the list.
  */
 void* osl_generic_lookup(const osl_generic* x, char const* const URI) {
+  if (!x)
+    return NULL;
+
+  // Generics using a shared interface are identified by their slot.
+  const int slot = osl_interface_URI_slot(URI);
   while (x) {
-    if (osl_generic_has_URI(x, URI))
+    const int x_slot = x->interface ? osl_interface_slot(x->interface) : -1;
+    if ((x_slot != -1) ? (x_slot == slot) : osl_generic_has_URI(x, URI))
       return x->data;
 
     x = x->next;
@@ -624,6 +762,64 @@ void* osl_generic_lookup(const osl_generic* x, char const* const URI) {
   return NULL;
 }
 
+/**
+ * osl_generic_index_lookup function:
+ * this function returns the data of the first generic with a given URI in
+ * an indexed generic list and NULL if there is no such generic. It runs in
+ * constant time for the URIs of the default registry.
+ * \param[in] index The index of the generic list where to search.
+ * \param[in] URI   The URI of the generic we are looking for.
+ * \return The data of the first generic of the requested URI in the list.
+ */
+void* osl_generic_index_lookup(const osl_generic_index* const index,
+                               char const* const URI) {
+  const int slot = osl_interface_URI_slot(URI);
+
+  if (slot != -1)
+    return index->slot[slot] ? index->slot[slot]->data : NULL;
+
+  return index->others ? osl_generic_lookup(index->list, URI) : NULL;
+}
+
+/**
+ * osl_generic_index_cached_lookup function:
+ * this function returns the data of the first generic with a given URI in
+ * a generic list, using (and building on the first call) the lookup index
+ * cached at a given address. The index is published atomically, so several
+ * threads may look up the same list concurrently: a thread losing the race
+ * to build it frees its own copy. If the cached index does not correspond
+ * to the list anymore (another head, or a list changed since by
+ * osl_generic_add or osl_generic_remove), the list is searched linearly
+ * (the index has to be freed and reset to NULL by the owner of the list to
+ * be rebuilt).
+ * \param[in,out] cache The address of the cached index (pointing to NULL
+ *                      if there is no index yet).
+ * \param[in]     list  The generic list where to search.
+ * \param[in]     URI   The URI of the generic we are looking for.
+ * \return The data of the first generic of the requested URI in the list.
+ */
+void* osl_generic_index_cached_lookup(osl_generic_index** const cache,
+                                      const osl_generic* const list,
+                                      char const* const URI) {
+  osl_generic_index* index = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+
+  if (!index) {
+    osl_generic_index* const built = osl_generic_index_build(list);
+    if (__atomic_compare_exchange_n(cache, &index, built, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      index = built;
+    } else {
+      osl_generic_index_free(built);
+    }
+  }
+
+  if ((index->list != list) ||
+      (list && (index->generation != list->list_generation)))
+    return osl_generic_lookup(list, URI);
+
+  return osl_generic_index_lookup(index, URI);
+}
+
 /**
  * osl_generic_shell function:
  * this function creates and returns a generic structure "shell" which
@@ -61,6 +61,7 @@
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef OSL_GMP_IS_HERE
 #include <gmp.h>
@@ -69,6 +70,21 @@
 #include <osl/int.h>
 #include <osl/macros.h>
 
+#ifdef OSL_GMP_IS_HERE
+/**
+ * osl_int_gmp_free_string function (internal function):
+ * this function frees a string allocated by GMP (e.g., by mpz_get_str) with
+ * the current free function of GMP, which may not be the allocator of the
+ * library (see osl_allocator_set).
+ * \param[in] str The string to free.
+ */
+static void osl_int_gmp_free_string(char* const str) {
+  void (*gmp_free)(void*, size_t);
+  mp_get_memory_functions(NULL, NULL, &gmp_free);
+  gmp_free(str, strlen(str) + 1);
+}
+#endif
+
 static long long int llgcd(long long int, long long int);
 static size_t lllog2(long long int);
 static size_t lllog10(long long int);
@@ -384,7 +400,7 @@ void osl_int_clear(const int precision, osl_int* const variable) {
 #ifdef OSL_GMP_IS_HERE
     case OSL_PRECISION_MP:
       mpz_clear(*variable->mp);
-      free(variable->mp);
+      osl_allocator_free(variable->mp);
       break;
 #endif
 
@@ -400,7 +416,33 @@ void osl_int_clear(const int precision, osl_int* const variable) {
  */
 void osl_int_free(const int precision, osl_int* const variable) {
   osl_int_clear(precision, variable);
-  free(variable);
+  osl_allocator_free(variable);
+}
+
+/**
+ * osl_int_memory_usage function:
+ * this function adds to a memory usage the blocks allocated for an osl int
+ * in addition to the osl int itself: the GMP integer and its limbs in
+ * multiple precision, nothing otherwise.
+ * \param[in]     precision Precision of the osl int.
+ * \param[in]     value     The osl int.
+ * \param[in,out] usage     The memory usage to update.
+ */
+void osl_int_memory_usage(const int precision, const osl_int value,
+                          osl_memory_usage* const usage) {
+#ifdef OSL_GMP_IS_HERE
+  if (precision == OSL_PRECISION_MP) {
+    osl_memory_usage_add(usage, &usage->matrices, sizeof(mpz_t));
+    const size_t nb_limbs = (size_t)(*value.mp)[0]._mp_alloc;
+    if (nb_limbs > 0)
+      osl_memory_usage_add(usage, &usage->limbs,
+                           nb_limbs * sizeof(mp_limb_t));
+  }
+#else
+  (void)precision;
+  (void)value;
+  (void)usage;
+#endif
 }
 
 /**
@@ -441,7 +483,7 @@ void osl_int_sprint(char* const string, const int precision,
       char* str;
       str = mpz_get_str(0, 10, *value.mp);  // TODO: 10 -> #define
       sprintf(string, OSL_FMT_MP, str);
-      free(str);
+      osl_int_gmp_free_string(str);
       break;
     }
 #endif
@@ -473,7 +515,7 @@ void osl_int_sprint_txt(char* const string, const int precision,
       char* str;
       str = mpz_get_str(0, 10, *value.mp);  // TODO: 10 -> #define
       sprintf(string, OSL_FMT_TXT_MP, str);
-      free(str);
+      osl_int_gmp_free_string(str);
       break;
     }
 #endif
@@ -58,10 +58,13 @@
  *                                                                            *
  ******************************************************************************/
 
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <osl/allocator.h>
 #include <osl/body.h>
 #include <osl/extensions/annotation.h>
 #include <osl/extensions/arrays.h>
@@ -81,7 +84,194 @@
 #include <osl/interface.h>
 #include <osl/relation.h>
 #include <osl/strings.h>
+#include <osl/util.h>
+
 
+/******************************************************************************
+ *                              Default registry                              *
+ ******************************************************************************/
+
+/**
+ * Number of buckets of the default registry URI hash table (a power of two,
+ * at least twice OSL_INTERFACE_SLOTS).
+ */
+#define OSL_INTERFACE_HASH_SIZE 64
+
+/**
+ * The default registry is built once per process and then never modified.
+ * Every interface it contains is stored twice: once as a node of the
+ * registry list (chain) and once as a stand-alone node (single) so generics
+ * can reference their interface without copying it. The index of an
+ * interface in both arrays is its slot. The hash table maps an URI to its
+ * slot (plus one, zero meaning an empty bucket).
+ */
+static struct {
+  osl_interface chain[OSL_INTERFACE_SLOTS];
+  osl_interface single[OSL_INTERFACE_SLOTS];
+  int hash[OSL_INTERFACE_HASH_SIZE];
+  int size;
+} osl_interface_default;
+
+static pthread_once_t osl_interface_default_once = PTHREAD_ONCE_INIT;
+
+/**
+ * osl_interface_default_find function:
+ * this function returns the index of the interface with a given URI in the
+ * default registry, or -1 if there is no such interface.
+ * \param[in] URI The URI of the interface we are looking for.
+ * \return The index of the interface in the default registry, -1 if none.
+ */
+static int osl_interface_default_find(const char* URI) {
+  size_t bucket = osl_util_hash(URI) & (OSL_INTERFACE_HASH_SIZE - 1);
+
+  while (osl_interface_default.hash[bucket]) {
+    const int index = osl_interface_default.hash[bucket] - 1;
+    if (!strcmp(osl_interface_default.chain[index].URI, URI))
+      return index;
+    bucket = (bucket + 1) & (OSL_INTERFACE_HASH_SIZE - 1);
+  }
+  return -1;
+}
+
+/**
+ * osl_interface_default_add function:
+ * this function moves an interface built by its osl_*_interface function
+ * into the default registry.
+ * \param[in] interface The interface to add (it is freed by this function).
+ */
+static void osl_interface_default_add(osl_interface* const interface) {
+  const int index = osl_interface_default.size;
+
+  if (index == OSL_INTERFACE_SLOTS)
+    OSL_error("too many interfaces in the default registry");
+  if (osl_interface_default_find(interface->URI) != -1)
+    OSL_error("only one interface with a given URI is allowed");
+
+  osl_interface_default.chain[index] = *interface;
+  osl_interface_default.chain[index].next = NULL;
+  osl_interface_default.single[index] = osl_interface_default.chain[index];
+  if (index > 0)
+    osl_interface_default.chain[index - 1].next =
+        &osl_interface_default.chain[index];
+
+  size_t bucket = osl_util_hash(interface->URI) & (OSL_INTERFACE_HASH_SIZE - 1);
+  while (osl_interface_default.hash[bucket])
+    bucket = (bucket + 1) & (OSL_INTERFACE_HASH_SIZE - 1);
+  osl_interface_default.hash[bucket] = index + 1;
+
+  osl_interface_default.size++;
+  // The URI string now belongs to the registry.
+  osl_allocator_free(interface);
+}
+
+/**
+ * osl_interface_default_init function:
+ * this function builds the default registry. It is called exactly once,
+ * through pthread_once.
+ */
+static void osl_interface_default_init(void) {
+  // Internal generics
+  osl_interface_default_add(osl_strings_interface());
+  osl_interface_default_add(osl_body_interface());
+  osl_interface_default_add(osl_relation_interface());
+
+  // Extensions
+  osl_interface_default_add(osl_textual_interface());
+  osl_interface_default_add(osl_comment_interface());
+  osl_interface_default_add(osl_null_interface());
+  osl_interface_default_add(osl_scatnames_interface());
+  osl_interface_default_add(osl_arrays_interface());
+  osl_interface_default_add(osl_coordinates_interface());
+  osl_interface_default_add(osl_clay_interface());
+  osl_interface_default_add(osl_dependence_interface());
+  osl_interface_default_add(osl_symbols_interface());
+  osl_interface_default_add(osl_extbody_interface());
+  osl_interface_default_add(osl_loop_interface());
+  osl_interface_default_add(osl_pluto_unroll_interface());
+  osl_interface_default_add(osl_region_interface());
+  osl_interface_default_add(osl_annotation_interface());
+  // osl_interface_default_add(osl_irregular_interface());
+}
+
+/**
+ * osl_interface_default_build function:
+ * this function makes sure the default registry is built. It is thread-safe.
+ */
+static void osl_interface_default_build(void) {
+  if (pthread_once(&osl_interface_default_once, osl_interface_default_init))
+    OSL_error("cannot build the default registry");
+}
+
+/**
+ * osl_interface_default_chain_index function:
+ * this function returns the index of an interface node in the default
+ * registry list, or -1 if the node does not belong to that list.
+ * \param[in] interface The interface node to check.
+ * \return The index of the node in the default registry list, -1 if none.
+ */
+static int osl_interface_default_chain_index(const osl_interface* interface) {
+  const uintptr_t address = (uintptr_t)interface;
+  const uintptr_t first = (uintptr_t)osl_interface_default.chain;
+  const uintptr_t last =
+      (uintptr_t)(osl_interface_default.chain + OSL_INTERFACE_SLOTS);
+
+  if ((address >= first) && (address < last))
+    return (int)(interface - osl_interface_default.chain);
+  return -1;
+}
+
+/**
+ * osl_interface_default_single_index function:
+ * this function returns the index of an interface node in the stand-alone
+ * nodes of the default registry, or -1 if it is not one of them.
+ * \param[in] interface The interface node to check.
+ * \return The index of the stand-alone node, -1 if none.
+ */
+static int osl_interface_default_single_index(const osl_interface* interface) {
+  const uintptr_t address = (uintptr_t)interface;
+  const uintptr_t first = (uintptr_t)osl_interface_default.single;
+  const uintptr_t last =
+      (uintptr_t)(osl_interface_default.single + OSL_INTERFACE_SLOTS);
+
+  if ((address >= first) && (address < last))
+    return (int)(interface - osl_interface_default.single);
+  return -1;
+}
+
+/**
+ * osl_interface_private_nclone function:
+ * this function builds a "hard copy" of the n first elements of an
+ * osl_interface list, whether its nodes are shared or not.
+ * \param interface The pointer to the interface structure we want to clone.
+ * \param n         The number of nodes we want to copy (-1 for infinity).
+ * \return The private clone of the n first nodes of the interface list.
+ */
+static osl_interface* osl_interface_private_nclone(
+    const osl_interface* interface, const int n) {
+  osl_interface* clone = NULL;
+  osl_interface** last = &clone;
+  int i = 0;
+
+  while (interface && ((n == -1) || (i < n))) {
+    osl_interface* const new = osl_interface_malloc();
+    OSL_strdup(new->URI, interface->URI);
+    new->idump = interface->idump;
+    new->sprint = interface->sprint;
+    new->sread = interface->sread;
+    new->malloc = interface->malloc;
+    new->free = interface->free;
+    new->clone = interface->clone;
+    new->equal = interface->equal;
+    new->size = interface->size;
+
+    *last = new;
+    last = &new->next;
+    interface = interface->next;
+    i++;
+  }
+
+  return clone;
+}
 /******************************************************************************
  *                          Structure display function                        *
  ******************************************************************************/
@@ -153,11 +343,14 @@ void osl_interface_dump(FILE* const file,
  *                    Memory allocation/deallocation function                 *
  ******************************************************************************/
 
+
 /**
  * osl_interface_add function:
  * this function adds an interface node (it may be a list as well) to a
  * list of interfaces provided as parameter (list). The new node
- * is inserted at the end of the list.
+ * is inserted at the end of the list. Shared nodes (see
+ * osl_interface_is_shared) are never modified: if the list ends with shared
+ * nodes, they are first replaced with private copies.
  * \param list      The list of interfaces to add a node (NULL if empty).
  * \param interface The interface to add to the list.
  */
@@ -174,14 +367,13 @@ void osl_interface_add(osl_interface** list, osl_interface* interface) {
       check_interface = check_interface->next;
     }
 
-    if (*list) {
-      osl_interface* tmp = *list;
-      while (tmp->next)
-        tmp = tmp->next;
-      tmp->next = interface;
-    } else {
-      *list = interface;
+    osl_interface** tail = list;
+    while (*tail) {
+      if (osl_interface_is_shared(*tail))
+        *tail = osl_interface_private_nclone(*tail, -1);
+      tail = &(*tail)->next;
     }
+    *tail = interface;
   }
 }
 
@@ -205,6 +397,7 @@ osl_interface* osl_interface_malloc(void) {
   interface->free = NULL;
   interface->clone = NULL;
   interface->equal = NULL;
+  interface->size = NULL;
   interface->next = NULL;
 
   return interface;
@@ -213,15 +406,17 @@ osl_interface* osl_interface_malloc(void) {
 /**
  * osl_interface_free function:
  * this function frees the allocated memory for an osl_interface
- * structure, and all the interfaces stored in the list.
+ * structure, and all the interfaces stored in the list. Shared nodes (see
+ * osl_interface_is_shared) are left untouched.
  * \param[in] interface The pointer to the interface we want to free.
  */
 void osl_interface_free(osl_interface* interface) {
-  while (interface) {
+  // Every node following a shared node is shared as well.
+  while (interface && !osl_interface_is_shared(interface)) {
     osl_interface* const tmp = interface->next;
     if (interface->URI)
-      free(interface->URI);
-    free(interface);
+      osl_allocator_free(interface->URI);
+    osl_allocator_free(interface);
     interface = tmp;
   }
 }
@@ -247,10 +442,57 @@ int osl_interface_number(const osl_interface* interface) {
   return number;
 }
 
+/**
+ * osl_interface_is_shared function:
+ * this function returns true if an interface node belongs to the default
+ * registry. Such nodes are shared by every user of the default registry:
+ * they are immutable and never freed.
+ * \param[in] interface The interface node to check.
+ * \return true if the node is shared, false otherwise.
+ */
+bool osl_interface_is_shared(const osl_interface* const interface) {
+  return (osl_interface_default_chain_index(interface) != -1) ||
+         (osl_interface_default_single_index(interface) != -1);
+}
+
+/**
+ * osl_interface_slot function:
+ * this function returns the slot of a shared interface node, i.e. its
+ * index in the default registry, in constant time and without any string
+ * comparison (see osl_interface_URI_slot).
+ * \param[in] interface The interface node to check.
+ * \return The slot of the node, or -1 if it is not shared.
+ */
+int osl_interface_slot(const osl_interface* const interface) {
+  const int chain_index = osl_interface_default_chain_index(interface);
+  if (chain_index != -1)
+    return chain_index;
+
+  return osl_interface_default_single_index(interface);
+}
+
+/**
+ * osl_interface_URI_slot function:
+ * this function returns the slot of the default registry interface with a
+ * given URI. Slots are smaller than OSL_INTERFACE_SLOTS and may be used to
+ * build constant-time lookup tables (see osl_generic_index).
+ * \param[in] URI The URI of the interface we are looking for.
+ * \return The slot of the URI, or -1 if it is not in the default registry.
+ */
+int osl_interface_URI_slot(const char* const URI) {
+  if (!URI)
+    return -1;
+
+  osl_interface_default_build();
+  return osl_interface_default_find(URI);
+}
+
 /**
  * osl_interface_nclone function:
- * This function builds and returns a "hard copy" (not a pointer copy) of the
- * n first elements of an osl_interface list.
+ * This function builds and returns a copy of the n first elements of an
+ * osl_interface list. Private nodes are hard-copied while shared nodes (see
+ * osl_interface_is_shared) are referenced when possible, since they are
+ * immutable.
  * \param interface The pointer to the interface structure we want to clone.
  * \param n         The number of nodes we want to copy (-1 for infinity).
  * \return The clone of the n first nodes of the interface list.
@@ -258,21 +500,28 @@ int osl_interface_number(const osl_interface* interface) {
 osl_interface* osl_interface_nclone(const osl_interface* interface,
                                     const int n) {
   osl_interface* clone = NULL;
-  osl_interface* new;
+  osl_interface** last = &clone;
   int i = 0;
 
   while (interface && ((n == -1) || (i < n))) {
-    new = osl_interface_malloc();
-    OSL_strdup(new->URI, interface->URI);
-    new->idump = interface->idump;
-    new->sprint = interface->sprint;
-    new->sread = interface->sread;
-    new->malloc = interface->malloc;
-    new->free = interface->free;
-    new->clone = interface->clone;
-    new->equal = interface->equal;
+    const int chain_index = osl_interface_default_chain_index(interface);
+    if (osl_interface_default_single_index(interface) != -1) {
+      *last = (osl_interface*)interface;
+      break;
+    }
+    if (chain_index != -1) {
+      const int remaining = osl_interface_default.size - chain_index;
+      if ((n == -1) || (n - i >= remaining))
+        *last = &osl_interface_default.chain[chain_index];
+      else if (n - i == 1)
+        *last = &osl_interface_default.single[chain_index];
+      else
+        *last = osl_interface_private_nclone(interface, n - i);
+      break;
+    }
 
-    osl_interface_add(&clone, new);
+    *last = osl_interface_private_nclone(interface, 1);
+    last = &(*last)->next;
     interface = interface->next;
     i++;
   }
@@ -282,8 +531,8 @@ osl_interface* osl_interface_nclone(const osl_interface* interface,
 
 /**
  * osl_interface_clone function:
- * This function builds and returns a "hard copy" (not a pointer copy) of an
- * osl_interface data structure.
+ * This function builds and returns a copy of an osl_interface data
+ * structure (see osl_interface_nclone).
  * \param interface The pointer to the interface structure we want to copy.
  * \return A pointer to the copy of the interface structure.
  */
@@ -314,17 +563,36 @@ bool osl_interface_equal(const osl_interface* const interface1,
       (interface1->malloc != interface2->malloc) ||
       (interface1->free != interface2->free) ||
       (interface1->clone != interface2->clone) ||
-      (interface1->equal != interface2->equal))
+      (interface1->equal != interface2->equal) ||
+      (interface1->size != interface2->size))
     return 0;
 
   return 1;
 }
 
+/**
+ * osl_interface_memory_usage function:
+ * this function adds the memory footprint of an interface list to a memory
+ * usage. Shared nodes (see osl_interface_is_shared) are not counted.
+ * \param[in]     interface The interface list.
+ * \param[in,out] usage     The memory usage to update.
+ */
+void osl_interface_memory_usage(const osl_interface* interface,
+                                osl_memory_usage* const usage) {
+  // Every node following a shared node is shared as well.
+  while (interface && !osl_interface_is_shared(interface)) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_interface));
+    osl_memory_usage_string(usage, interface->URI);
+    interface = interface->next;
+  }
+}
+
 /**
  * osl_interface_lookup function:
  * this function returns the first interface with a given URI in the
  * interface list provided as parameter and NULL if it doesn't find such
- * an interface.
+ * an interface. The part of the list that belongs to the default registry
+ * is searched in constant time.
  * \param list The interface list where to search a given interface URI.
  * \param URI  The URI of the interface we are looking for.
  * \return The first interface of the requested URI in the list.
@@ -334,6 +602,13 @@ osl_interface* osl_interface_lookup(osl_interface* list, const char* URI) {
     OSL_warning("lookup for a NULL URI");
   } else {
     while (list) {
+      const int chain_index = osl_interface_default_chain_index(list);
+      if (chain_index != -1) {
+        const int index = osl_interface_default_find(URI);
+        return (index >= chain_index) ? &osl_interface_default.chain[index]
+                                      : NULL;
+      }
+
       if (list->URI && (!strcmp(list->URI, URI)))
         return list;
 
@@ -346,34 +621,14 @@ osl_interface* osl_interface_lookup(osl_interface* list, const char* URI) {
 
 /**
  * osl_interface_get_default_registry function:
- * this function creates the list of known interfaces (of all generic types,
- * including extensions) and returns it.
+ * this function returns the list of known interfaces (of all generic types,
+ * including extensions). This list is built once per process and shared:
+ * it must not be modified, and freeing it with osl_interface_free has no
+ * effect. osl_interface_add copies it before appending to it. This function
+ * is thread-safe.
  * \return The list of known interfaces.
  */
 osl_interface* osl_interface_get_default_registry(void) {
-  osl_interface* registry = NULL;
-
-  // Internal generics
-  osl_interface_add(&registry, osl_strings_interface());
-  osl_interface_add(&registry, osl_body_interface());
-  osl_interface_add(&registry, osl_relation_interface());
-
-  // Extensions
-  osl_interface_add(&registry, osl_textual_interface());
-  osl_interface_add(&registry, osl_comment_interface());
-  osl_interface_add(&registry, osl_null_interface());
-  osl_interface_add(&registry, osl_scatnames_interface());
-  osl_interface_add(&registry, osl_arrays_interface());
-  osl_interface_add(&registry, osl_coordinates_interface());
-  osl_interface_add(&registry, osl_clay_interface());
-  osl_interface_add(&registry, osl_dependence_interface());
-  osl_interface_add(&registry, osl_symbols_interface());
-  osl_interface_add(&registry, osl_extbody_interface());
-  osl_interface_add(&registry, osl_loop_interface());
-  osl_interface_add(&registry, osl_pluto_unroll_interface());
-  osl_interface_add(&registry, osl_region_interface());
-  osl_interface_add(&registry, osl_annotation_interface());
-  // osl_interface_add(&registry, osl_irregular_interface());
-
-  return registry;
+  osl_interface_default_build();
+  return osl_interface_default.chain;
 }
@@ -0,0 +1,162 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                 memory.c                                 **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <osl/memory.h>
+
+/* Size of the header and alignment of the blocks of the C library
+ * allocator, used to estimate its overhead.
+ */
+#define OSL_MEMORY_HEADER sizeof(size_t)
+#define OSL_MEMORY_ALIGNMENT (2 * sizeof(size_t))
+#define OSL_MEMORY_MIN_BLOCK (4 * sizeof(size_t))
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+/**
+ * osl_memory_usage_print function:
+ * this function prints the bytes of each category of a memory usage, and
+ * their total, into a file (file, possibly stdout).
+ * \param[in] file  The file where the information has to be printed.
+ * \param[in] usage The memory usage to print.
+ */
+void osl_memory_usage_print(FILE* const file,
+                            const osl_memory_usage* const usage) {
+  fprintf(file, "structures %zu\n", usage->structures);
+  fprintf(file, "matrices   %zu\n", usage->matrices);
+  fprintf(file, "rows       %zu\n", usage->rows);
+  fprintf(file, "limbs      %zu\n", usage->limbs);
+  fprintf(file, "strings    %zu\n", usage->strings);
+  fprintf(file, "indexes    %zu\n", usage->indexes);
+  fprintf(file, "extensions %zu\n", usage->extensions);
+  fprintf(file, "overhead   %zu\n", usage->overhead);
+  fprintf(file, "total      %zu\n", osl_memory_usage_total(usage));
+}
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_memory_usage_init function:
+ * this function sets every category of a memory usage to zero. The
+ * memory_usage functions of the data structures add to their argument: it
+ * has to be initialized first.
+ * \param[out] usage The memory usage to initialize.
+ */
+void osl_memory_usage_init(osl_memory_usage* const usage) {
+  usage->structures = 0;
+  usage->matrices = 0;
+  usage->rows = 0;
+  usage->limbs = 0;
+  usage->strings = 0;
+  usage->indexes = 0;
+  usage->extensions = 0;
+  usage->overhead = 0;
+}
+
+/**
+ * osl_memory_usage_add function:
+ * this function accounts for an allocated block: its size is added to a
+ * category of the memory usage and its estimated allocator overhead to
+ * the overhead category.
+ * \param[in,out] usage    The memory usage to update.
+ * \param[in,out] category The category of the block (a field of usage).
+ * \param[in]     size     The size of the block.
+ */
+void osl_memory_usage_add(osl_memory_usage* const usage,
+                          size_t* const category, const size_t size) {
+  size_t block = (size + OSL_MEMORY_HEADER + OSL_MEMORY_ALIGNMENT - 1) &
+                 ~(OSL_MEMORY_ALIGNMENT - 1);
+  if (block < OSL_MEMORY_MIN_BLOCK)
+    block = OSL_MEMORY_MIN_BLOCK;
+
+  *category += size;
+  usage->overhead += block - size;
+}
+
+/**
+ * osl_memory_usage_string function:
+ * this function accounts for an allocated string in the strings category
+ * (nothing is done if the string is NULL).
+ * \param[in,out] usage  The memory usage to update.
+ * \param[in]     string The string.
+ */
+void osl_memory_usage_string(osl_memory_usage* const usage,
+                             const char* const string) {
+  if (string)
+    osl_memory_usage_add(usage, &usage->strings, strlen(string) + 1);
+}
+
+/**
+ * osl_memory_usage_total function:
+ * this function returns the total number of bytes of a memory usage.
+ * \param[in] usage The memory usage.
+ * \return The sum of every category of the memory usage.
+ */
+size_t osl_memory_usage_total(const osl_memory_usage* const usage) {
+  return usage->structures + usage->matrices + usage->rows + usage->limbs +
+         usage->strings + usage->indexes + usage->extensions +
+         usage->overhead;
+}
@@ -141,6 +141,7 @@ osl_names* osl_names_malloc(void) {
   names->scatt_dims = NULL;
   names->local_dims = NULL;
   names->arrays = NULL;
+  names->cache = NULL;
 
   return names;
 }
@@ -161,7 +162,34 @@ void osl_names_free(osl_names* const names) {
     osl_strings_free(names->local_dims);
     osl_strings_free(names->arrays);
 
-    free(names);
+    if (names->cache) {
+      for (size_t i = 0; i < OSL_NAMES_CACHE_BUCKETS; i++)
+        osl_names_columns_free(names->cache->bucket[i]);
+      osl_allocator_free(names->cache);
+    }
+
+    osl_allocator_free(names);
+  }
+}
+
+/**
+ * osl_names_columns_free function:
+ * this function frees the allocated memory for a list of osl_names_columns
+ * structures (column names and column headers included).
+ * \param[in,out] columns The pointer to the columns list we want to free.
+ */
+void osl_names_columns_free(osl_names_columns* columns) {
+  while (columns) {
+    osl_names_columns* const next = columns->next;
+
+    if (columns->strings) {
+      for (size_t i = 0; columns->strings[i]; i++)
+        osl_allocator_free(columns->strings[i]);
+      osl_allocator_free(columns->strings);
+    }
+    osl_allocator_free(columns->header);
+    osl_allocator_free(columns);
+    columns = next;
   }
 }
 
@@ -202,10 +230,28 @@ osl_names* osl_names_generate(
   return names;
 }
 
+/**
+ * osl_names_enable_cache function:
+ * this function attaches a column cache to a names structure (if it has
+ * none yet): the relation pretty-printer then computes the column names and
+ * column headers once for each relation kind and shape, and reuses them for
+ * every relation printed with these names (or with a copy of the structure
+ * sharing the same cache, e.g., with other iterator names).
+ * \param[in,out] names The names structure to attach a cache to.
+ */
+void osl_names_enable_cache(osl_names* const names) {
+  if (!names->cache) {
+    OSL_malloc(names->cache, osl_names_cache*, sizeof(osl_names_cache));
+    for (size_t i = 0; i < OSL_NAMES_CACHE_BUCKETS; i++)
+      names->cache->bucket[i] = NULL;
+  }
+}
+
 /**
  * osl_names_clone function:
  * this function builds and returns a "hard copy" (not a pointer copy) of an
- * osl_names data structure provided as parameter.
+ * osl_names data structure provided as parameter. The column cache (if any)
+ * is not cloned.
  * \param[in] names The pointer to the names structure we want to clone.
  * \return A pointer to the clone of the names structure provided as parameter.
  */
@@ -0,0 +1,281 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                                  perf.c                                  **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <osl/macros.h>
+#include <osl/perf.h>
+
+int osl_perf_state = -1;
+
+#ifdef OSL_SDT_IS_HERE
+// Semaphores of the tracing probes (see OSL_probe), set by the tracers.
+#define OSL_PROBE_SEMAPHORE_DEFINITION(name) \
+  unsigned short osl_##name##_semaphore __attribute__((section(".probes")));
+OSL_PROBES(OSL_PROBE_SEMAPHORE_DEFINITION)
+#endif
+
+/**
+ * Counters of each phase. They are shared by all threads and updated with
+ * atomic operations.
+ */
+static osl_perf_counter osl_perf_counters[OSL_PERF_NB_PHASES];
+
+/**
+ * Number of bytes requested to the allocator by the calling thread while the
+ * counters are enabled (a phase counts the difference between its end and
+ * its start).
+ */
+static _Thread_local unsigned long long osl_perf_thread_requested;
+
+/**
+ * Names of the phases, as used in the JSON output.
+ */
+static const char* const osl_perf_names[OSL_PERF_NB_PHASES] = {
+    "relation_read",  "generic_read",  "statement_read", "scop_read",
+    "relation_print", "scop_print",    "relation_clone", "scop_clone",
+    "relation_equal", "scop_equal",    "precision"};
+
+/******************************************************************************
+ *                          Structure display function                        *
+ ******************************************************************************/
+
+/**
+ * osl_perf_sprint_json function:
+ * this function prints the performance counters of every phase into a
+ * string (returned) as a JSON object: each phase name maps to an object
+ * with its number of calls, requested bytes and cumulative time.
+ * \return A string containing the JSON dump of the performance counters.
+ */
+char* osl_perf_sprint_json(void) {
+  size_t high_water_mark = OSL_MAX_STRING;
+  char* string = NULL;
+  char buffer[OSL_MAX_STRING];
+  OSL_malloc(string, char*, high_water_mark * sizeof(char));
+
+  snprintf(string, high_water_mark, "{\n  \"enabled\": %s,\n  \"phases\": {",
+           osl_perf_is_enabled() ? "true" : "false");
+  for (int i = 0; i < OSL_PERF_NB_PHASES; i++) {
+    osl_perf_counter counter;
+    osl_perf_get(i, &counter);
+    snprintf(buffer, OSL_MAX_STRING,
+             "%s\n    \"%s\": {\"calls\": %llu, \"bytes_requested\": %llu, "
+             "\"nanoseconds\": %llu}",
+             i ? "," : "", osl_perf_names[i], counter.calls,
+             counter.bytes_requested, counter.nanoseconds);
+    osl_util_safe_strcat(&string, buffer, &high_water_mark);
+  }
+  osl_util_safe_strcat(&string, "\n  }\n}\n", &high_water_mark);
+
+  return string;
+}
+
+/**
+ * osl_perf_print_json function:
+ * this function prints the performance counters into a file (file,
+ * possibly stdout) as a JSON object (see osl_perf_sprint_json).
+ * \param[in] file The file where the counters have to be printed.
+ */
+void osl_perf_print_json(FILE* const file) {
+  char* const string = osl_perf_sprint_json();
+  fprintf(file, "%s", string);
+  osl_allocator_free(string);
+}
+
+/******************************************************************************
+ *                            Processing functions                            *
+ ******************************************************************************/
+
+/**
+ * osl_perf_now function:
+ * this function returns the current time of a monotonic clock.
+ * \return The current time in nanoseconds.
+ */
+static unsigned long long osl_perf_now(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long long)now.tv_sec * 1000000000ULL +
+         (unsigned long long)now.tv_nsec;
+}
+
+/**
+ * osl_perf_enable function:
+ * this function enables or disables the performance counters for all
+ * threads, whatever the OSL_PERF environment variable says. Calls running
+ * when the counters are enabled are not measured.
+ * \param[in] enable True to enable the counters, false to disable them.
+ */
+void osl_perf_enable(const bool enable) {
+  __atomic_store_n(&osl_perf_state, enable ? 1 : 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * osl_perf_is_enabled function:
+ * this function returns true if the performance counters are enabled. Unless
+ * osl_perf_enable has been called, they are enabled if the environment
+ * variable OSL_PERF is set to anything but "0".
+ * \return True if the performance counters are enabled, false otherwise.
+ */
+bool osl_perf_is_enabled(void) {
+  int state = __atomic_load_n(&osl_perf_state, __ATOMIC_RELAXED);
+
+  if (state < 0) {
+    const char* const env = getenv("OSL_PERF");
+    const int enabled = (env != NULL && *env != '\0' && strcmp(env, "0"));
+    // Do not override a concurrent call to osl_perf_enable.
+    __atomic_compare_exchange_n(&osl_perf_state, &state, enabled, false,
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    state = __atomic_load_n(&osl_perf_state, __ATOMIC_RELAXED);
+  }
+
+  return state > 0;
+}
+
+/**
+ * osl_perf_reset function:
+ * this function sets the counters of every phase to zero.
+ */
+void osl_perf_reset(void) {
+  for (int i = 0; i < OSL_PERF_NB_PHASES; i++) {
+    __atomic_store_n(&osl_perf_counters[i].calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&osl_perf_counters[i].bytes_requested, 0,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&osl_perf_counters[i].nanoseconds, 0, __ATOMIC_RELAXED);
+  }
+}
+
+/**
+ * osl_perf_get function:
+ * this function copies the counters of a phase.
+ * \param[in]  phase   The phase (one of the OSL_PERF_* values).
+ * \param[out] counter Where to copy the counters of the phase.
+ */
+void osl_perf_get(const int phase, osl_perf_counter* const counter) {
+  if (phase < 0 || phase >= OSL_PERF_NB_PHASES)
+    OSL_error("unknown performance phase");
+
+  counter->calls =
+      __atomic_load_n(&osl_perf_counters[phase].calls, __ATOMIC_RELAXED);
+  counter->bytes_requested = __atomic_load_n(
+      &osl_perf_counters[phase].bytes_requested, __ATOMIC_RELAXED);
+  counter->nanoseconds =
+      __atomic_load_n(&osl_perf_counters[phase].nanoseconds, __ATOMIC_RELAXED);
+}
+
+/**
+ * osl_perf_phase_name function:
+ * this function returns the name of a phase (as used in the JSON output).
+ * \param[in] phase The phase (one of the OSL_PERF_* values).
+ * \return The name of the phase, NULL if the phase is unknown.
+ */
+const char* osl_perf_phase_name(const int phase) {
+  if (phase < 0 || phase >= OSL_PERF_NB_PHASES)
+    return NULL;
+  return osl_perf_names[phase];
+}
+
+/**
+ * osl_perf_begin function:
+ * this function starts the measure of a call (it is the function behind
+ * OSL_perf_begin, which only calls it when the counters may be enabled).
+ * \param[out] mark The state of the measured call.
+ */
+void osl_perf_begin(osl_perf_mark* const mark) {
+  mark->active = osl_perf_is_enabled();
+  if (mark->active) {
+    mark->bytes_requested = osl_perf_thread_requested;
+    mark->start = osl_perf_now();
+  }
+}
+
+/**
+ * osl_perf_end function:
+ * this function ends the measure of a call and adds it to the counters of a
+ * phase (it is the function behind OSL_perf_end).
+ * \param[in] phase The phase of the call (one of the OSL_PERF_* values).
+ * \param[in] mark  The state of the measured call.
+ */
+void osl_perf_end(const int phase, const osl_perf_mark* const mark) {
+  const unsigned long long end = osl_perf_now();
+  osl_perf_counter* const counter = &osl_perf_counters[phase];
+
+  __atomic_fetch_add(&counter->calls, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&counter->bytes_requested,
+                     osl_perf_thread_requested - mark->bytes_requested,
+                     __ATOMIC_RELAXED);
+  __atomic_fetch_add(&counter->nanoseconds, end - mark->start,
+                     __ATOMIC_RELAXED);
+}
+
+/**
+ * osl_perf_allocated function:
+ * this function records an allocation or a resize of the calling thread (it
+ * is called by the allocator of the library while the counters are
+ * enabled). A resize counts its whole new size, as the allocator does not
+ * know the previous one: the counters sum the requested bytes, not the
+ * growth of the memory in use.
+ * \param[in] size The size of the allocated or resized block.
+ */
+void osl_perf_allocated(const size_t size) {
+  osl_perf_thread_requested += size;
+}
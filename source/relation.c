@@ -71,7 +71,6 @@
 #include <osl/util.h>
 #include <osl/vector.h>
 
-static char* osl_relation_sprint_type(const osl_relation*);
 static void osl_relation_print_type(FILE*, const osl_relation*);
 static char* osl_relation_expression_element(const osl_int, int, bool*, int,
                                              const char*);
@@ -84,6 +83,11 @@ static char* osl_relation_sprint_comment(const osl_relation*, int, char**,
                                          char**);
 static char* osl_relation_column_string(const osl_relation*, char**);
 static char* osl_relation_column_string_scoplib(const osl_relation*, char**);
+static const char* osl_relation_column_name(const osl_relation*,
+                                            const osl_names*, int, int);
+static const osl_names_columns* osl_relation_columns(const osl_relation*,
+                                                     const osl_names*,
+                                                     osl_names_columns**);
 static osl_names* osl_relation_names(const osl_relation*);
 static int osl_relation_read_type(FILE*, char**);
 static bool osl_relation_check_attribute(int*, int);
@@ -158,7 +162,7 @@ char* osl_relation_sprint_type(const osl_relation* const relation) {
 void osl_relation_print_type(FILE* const file, const osl_relation* relation) {
   char* string = osl_relation_sprint_type(relation);
   fprintf(file, "%s", string);
-  free(string);
+  osl_allocator_free(string);
 }
 
 /**
@@ -313,8 +317,8 @@ char* osl_relation_expression_element(const osl_int val, const int precision,
       }
     }
   }
-  free(temp);
-  free(body);
+  osl_allocator_free(temp);
+  osl_allocator_free(body);
 
   return (sval);
 }
@@ -410,12 +414,17 @@ char* osl_relation_subexpression(const osl_relation* const relation,
   OSL_malloc(sline, char*, OSL_MAX_STRING * sizeof(char));
   sline[0] = '\0';
 
+  // Opposed values go through a local copy: the relation is left untouched
+  // so it may be printed concurrently.
+  osl_int value;
+  osl_int_init(relation->precision, &value);
+
   // Create the expression. The constant is a special case.
   for (int i = start; i <= stop; i++) {
-    if (oppose) {
-      osl_int_oppose(relation->precision, &relation->m[row][i],
-                     relation->m[row][i]);
-    }
+    if (oppose)
+      osl_int_oppose(relation->precision, &value, relation->m[row][i]);
+    else
+      osl_int_assign(relation->precision, &value, relation->m[row][i]);
 
     int constant;
     if (i == relation->nb_columns - 1)
@@ -424,16 +433,13 @@ char* osl_relation_subexpression(const osl_relation* const relation,
       constant = 0;
 
     char* const sval = osl_relation_expression_element(
-        relation->m[row][i], relation->precision, &first, constant, strings[i]);
+        value, relation->precision, &first, constant, strings[i]);
 
-    if (oppose) {
-      osl_int_oppose(relation->precision, &relation->m[row][i],
-                     relation->m[row][i]);
-    }
     strcat(sline, sval);
-    free(sval);
+    osl_allocator_free(sval);
   }
 
+  osl_int_clear(relation->precision, &value);
   return sline;
 }
 
@@ -534,7 +540,7 @@ char* osl_relation_sprint_comment(const osl_relation* const relation,
         relation, row, 1, relation->nb_output_dims, sign < 0, strings);
     snprintf(buffer, OSL_MAX_STRING, "   ## %s", expression);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
-    free(expression);
+    osl_allocator_free(expression);
 
     // We don't print the right hand side if it's an array identifier.
     if (!osl_relation_is_access(relation) ||
@@ -544,7 +550,7 @@ char* osl_relation_sprint_comment(const osl_relation* const relation,
           sign > 0, strings);
       snprintf(buffer, OSL_MAX_STRING, " == %s", expression);
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
-      free(expression);
+      osl_allocator_free(expression);
     } else {
       snprintf(buffer, OSL_MAX_STRING, " == %s",
                arrays[osl_relation_get_array_id(relation) - 1]);
@@ -556,7 +562,7 @@ char* osl_relation_sprint_comment(const osl_relation* const relation,
     char* const expression = osl_relation_expression(relation, row, strings);
     snprintf(buffer, OSL_MAX_STRING, "   ## %s", expression);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
-    free(expression);
+    osl_allocator_free(expression);
 
     if (osl_int_zero(relation->precision, relation->m[row][0]))
       snprintf(buffer, OSL_MAX_STRING, " == 0");
@@ -636,6 +642,155 @@ char* osl_relation_column_string(const osl_relation* const relation,
   return scolumn;
 }
 
+/**
+ * osl_relation_column_name function:
+ * this function returns the name of a given column of a relation taken from
+ * a names structure, as osl_relation_strings would, or NULL if the column
+ * name only depends on the relation kind and shape (e.g., "e/i", "1" or the
+ * array dimensions of an access relation).
+ * \param[in] relation The relation whose column name is requested.
+ * \param[in] names    The names of the relation dimensions.
+ * \param[in] kind     The relation kind (see osl_relation_columns).
+ * \param[in] column   The column number.
+ * \return The name of the column in names, or NULL.
+ */
+static const char* osl_relation_column_name(const osl_relation* const relation,
+                                            const osl_names* const names,
+                                            const int kind, int column) {
+  // 1. Equality/inequality marker.
+  if (column == 0)
+    return NULL;
+  column--;
+
+  // 2. Output dimensions.
+  if (column < relation->nb_output_dims) {
+    if (kind == OSL_TYPE_ACCESS)
+      return NULL;
+    if (kind == OSL_TYPE_DOMAIN)
+      return names->iterators->string[column];
+    return names->scatt_dims->string[column];
+  }
+  column -= relation->nb_output_dims;
+
+  // 3. Input dimensions.
+  if (column < relation->nb_input_dims)
+    return names->iterators->string[column];
+  column -= relation->nb_input_dims;
+
+  // 4. Local dimensions.
+  if (column < relation->nb_local_dims)
+    return names->local_dims->string[column];
+  column -= relation->nb_local_dims;
+
+  // 5. Parameters.
+  if (column < relation->nb_parameters)
+    return names->parameters->string[column];
+
+  // 6. Scalar.
+  return NULL;
+}
+
+/**
+ * osl_relation_columns function:
+ * this function returns the column names and the column header comment of
+ * a relation (see osl_relation_strings and osl_relation_column_string). If
+ * the names have a column cache (see osl_names_enable_cache), they are
+ * looked up in this cache by relation kind, shape and column names, and
+ * they are computed then added to the cache if they are not found (the
+ * cache is updated atomically, so it may be shared by several threads).
+ * Otherwise, they are computed and returned through the owned parameter,
+ * and the caller has to free them with osl_names_columns_free.
+ * \param[in]  relation The relation to get the column names of.
+ * \param[in]  names    The names of the relation dimensions.
+ * \param[out] owned    Set to the columns to free (NULL if they are cached).
+ * \return The column names and column header, or NULL if there is no names.
+ */
+static const osl_names_columns* osl_relation_columns(
+    const osl_relation* const relation, const osl_names* const names,
+    osl_names_columns** const owned) {
+  *owned = NULL;
+  if (!relation || !names)
+    return NULL;
+
+  // The column names only depend on the relation kind: access, domain
+  // (or context) or scattering (other types).
+  int kind = OSL_TYPE_SCATTERING;
+  if (osl_relation_is_access(relation))
+    kind = OSL_TYPE_ACCESS;
+  else if ((relation->type == OSL_TYPE_DOMAIN) ||
+           (relation->type == OSL_TYPE_CONTEXT))
+    kind = OSL_TYPE_DOMAIN;
+
+  osl_names_columns** bucket = NULL;
+  size_t hash = 0;
+  if (names->cache) {
+    // Hash the kind, the shape and the names of the columns.
+    hash = (size_t)kind;
+    hash = hash * 31 + (size_t)relation->nb_columns;
+    hash = hash * 31 + (size_t)relation->nb_output_dims;
+    hash = hash * 31 + (size_t)relation->nb_input_dims;
+    hash = hash * 31 + (size_t)relation->nb_local_dims;
+    hash = hash * 31 + (size_t)relation->nb_parameters;
+    for (int i = 0; i < relation->nb_columns; i++) {
+      const char* const name =
+          osl_relation_column_name(relation, names, kind, i);
+      if (name)
+        hash = hash * 31 + osl_util_hash(name);
+    }
+    bucket = &names->cache->bucket[hash % OSL_NAMES_CACHE_BUCKETS];
+
+    // Look for the columns in the cache.
+    const osl_names_columns* x = __atomic_load_n(bucket, __ATOMIC_ACQUIRE);
+    for (; x; x = x->next) {
+      if ((x->hash != hash) || (x->kind != kind) ||
+          (x->nb_columns != relation->nb_columns) ||
+          (x->nb_output_dims != relation->nb_output_dims) ||
+          (x->nb_input_dims != relation->nb_input_dims) ||
+          (x->nb_local_dims != relation->nb_local_dims) ||
+          (x->nb_parameters != relation->nb_parameters))
+        continue;
+
+      int i = 0;
+      for (; i < relation->nb_columns; i++) {
+        const char* const name =
+            osl_relation_column_name(relation, names, kind, i);
+        if (name && strcmp(name, x->strings[i]))
+          break;
+      }
+      if (i == relation->nb_columns)
+        return x;
+    }
+  }
+
+  // Compute the columns.
+  osl_names_columns* columns;
+  OSL_malloc(columns, osl_names_columns*, sizeof(osl_names_columns));
+  columns->hash = hash;
+  columns->kind = kind;
+  columns->nb_columns = relation->nb_columns;
+  columns->nb_output_dims = relation->nb_output_dims;
+  columns->nb_input_dims = relation->nb_input_dims;
+  columns->nb_local_dims = relation->nb_local_dims;
+  columns->nb_parameters = relation->nb_parameters;
+  columns->strings = osl_relation_strings(relation, names);
+  columns->header = osl_relation_column_string(relation, columns->strings);
+  columns->next = NULL;
+
+  if (!bucket) {
+    *owned = columns;
+    return columns;
+  }
+
+  // Add them to the cache. If another thread adds the same columns in the
+  // meantime, both are kept (the cache remains correct).
+  columns->next = __atomic_load_n(bucket, __ATOMIC_ACQUIRE);
+  while (!__atomic_compare_exchange_n(bucket, &columns->next, columns, false,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    continue;
+
+  return columns;
+}
+
 /**
  * osl_relation_column_string_scoplib function:
  * this function returns an OpenScop comment string showing all column
@@ -790,7 +945,10 @@ char* osl_relation_spprint_polylib(const osl_relation* relation,
   // Print each part of the union.
   for (int part = 1; part <= nb_parts; part++) {
     // Prepare the array of strings for comments.
-    char** const name_array = osl_relation_strings(relation, names);
+    osl_names_columns* owned_columns = NULL;
+    const osl_names_columns* const columns =
+        osl_relation_columns(relation, names, &owned_columns);
+    char** const name_array = columns ? columns->strings : NULL;
 
     if (nb_parts > 1) {
       snprintf(buffer, OSL_MAX_STRING, "# Union part No.%d\n", part);
@@ -803,11 +961,9 @@ char* osl_relation_spprint_polylib(const osl_relation* relation,
              relation->nb_parameters);
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
 
-    if (relation->nb_rows > 0) {
-      char* const scolumn = osl_relation_column_string(relation, name_array);
-      snprintf(buffer, OSL_MAX_STRING, "%s", scolumn);
+    if ((relation->nb_rows > 0) && columns) {
+      snprintf(buffer, OSL_MAX_STRING, "%s", columns->header);
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
-      free(scolumn);
     }
 
     for (int i = 0; i < relation->nb_rows; i++) {
@@ -822,18 +978,14 @@ char* osl_relation_spprint_polylib(const osl_relation* relation,
         char* const comment = osl_relation_sprint_comment(
             relation, i, name_array, names->arrays->string);
         osl_util_safe_strcat(&string, comment, &high_water_mark);
-        free(comment);
+        osl_allocator_free(comment);
       }
       snprintf(buffer, OSL_MAX_STRING, "\n");
       osl_util_safe_strcat(&string, buffer, &high_water_mark);
     }
 
-    // Free the array of strings.
-    if (name_array) {
-      for (int i = 0; i < relation->nb_columns; i++)
-        free(name_array[i]);
-      free(name_array);
-    }
+    // Free the array of strings if it is not cached.
+    osl_names_columns_free(owned_columns);
 
     relation = relation->next;
   }
@@ -961,7 +1113,7 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation* relation,
             osl_relation_column_string_scoplib(relation, name_array);
         snprintf(buffer, OSL_MAX_STRING, "%s", scolumn);
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
-        free(scolumn);
+        osl_allocator_free(scolumn);
       }
 
       start_row = 0;
@@ -1052,7 +1204,7 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation* relation,
         char* const comment = osl_relation_sprint_comment(
             relation, i, name_array, names->arrays->string);
         osl_util_safe_strcat(&string, comment, &high_water_mark);
-        free(comment);
+        osl_allocator_free(comment);
         snprintf(buffer, OSL_MAX_STRING, "\n");
         osl_util_safe_strcat(&string, buffer, &high_water_mark);
       }
@@ -1077,8 +1229,8 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation* relation,
     // Free the array of strings.
     if (name_array) {
       for (i = 0; i < relation->nb_columns; i++)
-        free(name_array[i]);
-      free(name_array);
+        osl_allocator_free(name_array[i]);
+      osl_allocator_free(name_array);
     }
 
     relation = relation->next;
@@ -1100,6 +1252,11 @@ char* osl_relation_spprint_polylib_scoplib(const osl_relation* relation,
  */
 char* osl_relation_spprint(const osl_relation* const relation,
                            const osl_names* const names) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe2(relation__print__start, relation ? relation->nb_rows : 0,
+             relation ? relation->nb_columns : 0);
+
   size_t high_water_mark = OSL_MAX_STRING;
   char* string = NULL;
   char buffer[OSL_MAX_STRING];
@@ -1109,16 +1266,19 @@ char* osl_relation_spprint(const osl_relation* const relation,
   if (osl_relation_nb_components(relation) > 0) {
     char* temp = osl_relation_sprint_type(relation);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    osl_allocator_free(temp);
 
     snprintf(buffer, OSL_MAX_STRING, "\n");
     osl_util_safe_strcat(&string, buffer, &high_water_mark);
 
     temp = osl_relation_spprint_polylib(relation, names);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    osl_allocator_free(temp);
   }
 
+  OSL_probe3(relation__print__done, relation ? relation->nb_rows : 0,
+             relation ? relation->nb_columns : 0, strlen(string));
+  OSL_perf_end(OSL_PERF_RELATION_PRINT, &mark);
   return string;
 }
 
@@ -1145,7 +1305,7 @@ char* osl_relation_spprint_scoplib(const osl_relation* const relation,
     char* const temp = osl_relation_spprint_polylib_scoplib(
         relation, names, print_nth_part, add_fakeiter);
     osl_util_safe_strcat(&string, temp, &high_water_mark);
-    free(temp);
+    osl_allocator_free(temp);
   }
 
   return string;
@@ -1163,7 +1323,7 @@ void osl_relation_pprint(FILE* const file, const osl_relation* const relation,
                          const osl_names* const names) {
   char* const string = osl_relation_spprint(relation, names);
   fprintf(file, "%s", string);
-  free(string);
+  osl_allocator_free(string);
 }
 
 /**
@@ -1184,7 +1344,7 @@ void osl_relation_pprint_scoplib(FILE* const file,
   char* const string = osl_relation_spprint_scoplib(
       relation, names, print_nth_part, add_fakeiter);
   fprintf(file, "%s", string);
-  free(string);
+  osl_allocator_free(string);
 }
 
 /**
@@ -1235,6 +1395,7 @@ int osl_relation_read_type(FILE* const file, char** const str) {
     strings = osl_strings_read(file);
   else
     strings = osl_strings_sread(str);
+  osl_error_protect(strings, (osl_error_cleanup_f)osl_strings_free);
 
   if (osl_strings_size(strings) > 1) {
     OSL_warning("uninterpreted information (after the relation type)");
@@ -1280,6 +1441,7 @@ int osl_relation_read_type(FILE* const file, char** const str) {
   OSL_error("relation type not supported");
 
 return_type:
+  osl_error_unprotect(strings);
   osl_strings_free(strings);
   return type;
 }
@@ -1293,6 +1455,11 @@ return_type:
  * \return A pointer to the relation structure that has been read.
  */
 osl_relation* osl_relation_pread(FILE* const foo, const int precision) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe1(relation__read__start, precision);
+  const long start = OSL_probe_enabled(relation__read__done) ? ftell(foo) : -1;
+
   int n;
   int nb_union_parts = 1;
   int may_read_nb_union_parts = 1;
@@ -1317,9 +1484,11 @@ osl_relation* osl_relation_pread(FILE* const foo, const int precision) {
 
       // Read relation attributes.
       c = osl_util_skip_blank_and_comments(foo, s);
-      const int read = sscanf(c, " %d %d %d %d %d %d", &nb_rows, &nb_columns,
-                              &nb_output_dims, &nb_input_dims, &nb_local_dims,
-                              &nb_parameters);
+      const int read =
+          c ? sscanf(c, " %d %d %d %d %d %d", &nb_rows, &nb_columns,
+                     &nb_output_dims, &nb_input_dims, &nb_local_dims,
+                     &nb_parameters)
+            : 0;
 
       if (((read != 1) && (read != 6)) ||
           ((read == 1) && (may_read_nb_union_parts != 1)))
@@ -1338,9 +1507,17 @@ osl_relation* osl_relation_pread(FILE* const foo, const int precision) {
       may_read_nb_union_parts = 0;
     }
 
-    // Allocate the union part and fill its properties.
+    // Allocate the union part, link it and fill its properties.
     osl_relation* const relation =
         osl_relation_pmalloc(precision, nb_rows, nb_columns);
+    if (first) {
+      relation_union = relation;
+      osl_error_protect(relation_union, (osl_error_cleanup_f)osl_relation_free);
+      first = false;
+    } else {
+      previous->next = relation;
+    }
+    previous = relation;
     relation->type = type;
     relation->nb_output_dims = nb_output_dims;
     relation->nb_input_dims = nb_input_dims;
@@ -1354,9 +1531,9 @@ osl_relation* osl_relation_pread(FILE* const foo, const int precision) {
         OSL_error("not enough rows");
 
       for (int j = 0; j < relation->nb_columns; j++) {
-        if (!c || *c == '#' || *c == '\n')
+        if (!c || *c == '\0' || *c == '#' || *c == '\n')
           OSL_error("not enough columns");
-        if (sscanf(c, "%s%n", str, &n) == 0)
+        if (sscanf(c, "%s%n", str, &n) != 1)
           OSL_error("not enough rows");
 
         // TODO: remove this tmp (sread updates the pointer).
@@ -1366,18 +1543,15 @@ osl_relation* osl_relation_pread(FILE* const foo, const int precision) {
       }
     }
 
-    // Build the linked list of union parts.
-    if (first) {
-      relation_union = relation;
-      first = false;
-    } else {
-      previous->next = relation;
-    }
-
-    previous = relation;
     read_attributes = true;
   }
 
+  osl_error_unprotect(relation_union);
+  OSL_probe3(relation__read__done,
+             relation_union ? relation_union->nb_rows : 0,
+             relation_union ? relation_union->nb_columns : 0,
+             (start >= 0) ? ftell(foo) - start : 0);
+  OSL_perf_end(OSL_PERF_RELATION_READ, &mark);
   return relation_union;
 }
 
@@ -1409,6 +1583,11 @@ osl_relation* osl_relation_psread(char** const input, const int precision) {
  */
 osl_relation* osl_relation_psread_polylib(char** const input,
                                           const int precision) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe1(relation__read__start, precision);
+  const char* const start = *input;
+
   int n;
   int nb_union_parts = 1;
   int may_read_nb_union_parts = 1;
@@ -1460,9 +1639,17 @@ osl_relation* osl_relation_psread_polylib(char** const input,
       may_read_nb_union_parts = 0;
     }
 
-    // Allocate the union part and fill its properties.
+    // Allocate the union part, link it and fill its properties.
     osl_relation* const relation =
         osl_relation_pmalloc(precision, nb_rows, nb_columns);
+    if (first) {
+      relation_union = relation;
+      osl_error_protect(relation_union, (osl_error_cleanup_f)osl_relation_free);
+      first = false;
+    } else {
+      previous->next = relation;
+    }
+    previous = relation;
     relation->nb_output_dims = nb_output_dims;
     relation->nb_input_dims = nb_input_dims;
     relation->nb_local_dims = nb_local_dims;
@@ -1471,13 +1658,14 @@ osl_relation* osl_relation_psread_polylib(char** const input,
     // Read the matrix of constraints.
     for (int i = 0; i < relation->nb_rows; i++) {
       osl_util_sskip_blank_and_comments(input);
-      if (!(*input))
+      if (!(*input) || **input == '\0')
         OSL_error("not enough rows");
 
       for (int j = 0; j < relation->nb_columns; j++) {
-        if (!(*input) || **input == '#' || **input == '\n')
+        if (!(*input) || **input == '\0' || **input == '#' ||
+            **input == '\n')
           OSL_error("not enough columns");
-        if (sscanf(*input, "%s%n", str, &n) == 0)
+        if (sscanf(*input, "%s%n", str, &n) != 1)
           OSL_error("not enough rows");
 
         // TODO: remove this tmp (sread updates the pointer).
@@ -1487,18 +1675,15 @@ osl_relation* osl_relation_psread_polylib(char** const input,
       }
     }
 
-    // Build the linked list of union parts.
-    if (first) {
-      relation_union = relation;
-      first = false;
-    } else {
-      previous->next = relation;
-    }
-
-    previous = relation;
     read_attributes = true;
   }
 
+  osl_error_unprotect(relation_union);
+  OSL_probe3(relation__read__done,
+             relation_union ? relation_union->nb_rows : 0,
+             relation_union ? relation_union->nb_columns : 0,
+             (size_t)(*input - start));
+  OSL_perf_end(OSL_PERF_RELATION_READ, &mark);
   return relation_union;
 }
 
@@ -1526,6 +1711,141 @@ osl_relation* osl_relation_sread_polylib(char** const input) {
   return osl_relation_psread_polylib(input, precision);
 }
 
+/**
+ * osl_relation_sskip_attributes internal function:
+ * this function reads the integers of a relation attribute line (the number
+ * of union parts, or the number of rows, columns and dimensions of a part).
+ * \param[in,out] input The input string where to find the line. Updated to
+ *                      the end of the line.
+ * \param[out]    first The first integer of the line.
+ * \return The number of integers on the line.
+ */
+static int osl_relation_sskip_attributes(char** const input, long* const first) {
+  int nb_values = 0;
+
+  osl_util_sskip_blank_and_comments(input);
+  while (**input && (**input != '\n') && (**input != '#')) {
+    char* end;
+    const long value = strtol(*input, &end, 10);
+    if (end == *input)
+      OSL_error("not an integer on the first relation line");
+    if (nb_values++ == 0)
+      *first = value;
+
+    *input = end;
+    while ((**input == ' ') || (**input == '\t') || (**input == '\r'))
+      (*input)++;
+  }
+
+  return nb_values;
+}
+
+/**
+ * osl_relation_sskip function:
+ * this function skips a relation in the OpenScop textual format (see
+ * osl_relation_psread) without decoding its elements: only the attribute
+ * lines are read, then the rows of each union part are skipped line by line,
+ * as the library prints one row per line. It is much cheaper than reading
+ * and freeing the relation.
+ * \param[in,out] input The input string where to find a relation. Updated
+ *                      to the position after the relation.
+ */
+void osl_relation_sskip(char** const input) {
+  long nb_union_parts = 1;
+  long nb_rows = 0;
+
+  // Skip the relation type.
+  osl_util_sskip_blank_and_comments(input);
+  while (**input && !isspace(**input) && (**input != '#'))
+    (*input)++;
+
+  for (long k = 0; k < nb_union_parts; k++) {
+    int nb_values = osl_relation_sskip_attributes(input, &nb_rows);
+    if ((k == 0) && (nb_values == 1)) {
+      // Only one number means a union and is the number of parts.
+      nb_union_parts = nb_rows;
+      if (nb_union_parts < 1)
+        OSL_error("negative nb of union parts");
+      nb_values = osl_relation_sskip_attributes(input, &nb_rows);
+    }
+    if (nb_values != 6)
+      OSL_error("not 1 or 6 integers on the first relation line");
+
+    for (long i = 0; i < nb_rows; i++) {
+      osl_util_sskip_blank_and_comments(input);
+      if (**input == '\0')
+        OSL_error("not enough rows");
+      *input += strcspn(*input, "\n");
+    }
+  }
+}
+
+/**
+ * Arguments and result of the relation readers when run by
+ * osl_relation_pread_try or osl_relation_psread_try.
+ */
+struct osl_relation_read_args {
+  FILE* file;
+  char** input;
+  int precision;
+  osl_relation* relation;
+};
+
+/**
+ * osl_relation_read_body function:
+ * this function runs osl_relation_pread (if a file is provided) or
+ * osl_relation_psread on behalf of the relation _try readers.
+ * \param[in,out] data The arguments and result of the reader.
+ */
+static void osl_relation_read_body(void* const data) {
+  struct osl_relation_read_args* const args = data;
+
+  if (args->file)
+    args->relation = osl_relation_pread(args->file, args->precision);
+  else
+    args->relation = osl_relation_psread(args->input, args->precision);
+}
+
+/**
+ * osl_relation_pread_try function:
+ * this function is equivalent to osl_relation_pread() except that errors
+ * do not exit the program: the partially read relation is freed and the
+ * function fails (see osl_error_try).
+ * \param[in]  foo       The input stream.
+ * \param[in]  precision The precision of the relation elements.
+ * \param[out] relation  The relation that has been read (NULL on error).
+ * \return true if the relation has been read, false if an error occurred.
+ */
+bool osl_relation_pread_try(FILE* const foo, const int precision,
+                            osl_relation** const relation) {
+  struct osl_relation_read_args args = {foo, NULL, precision, NULL};
+  const bool success = osl_error_try(osl_relation_read_body, &args);
+
+  *relation = args.relation;
+  return success;
+}
+
+/**
+ * osl_relation_psread_try function:
+ * this function is equivalent to osl_relation_psread() except that errors
+ * do not exit the program: the partially read relation is freed and the
+ * function fails (see osl_error_try). On error, the input pointer is left
+ * where the error has been detected.
+ * \param[in,out] input     The input string where to find a relation.
+ *                          Updated to the position after what has been read.
+ * \param[in]     precision The precision of the relation elements.
+ * \param[out]    relation  The relation that has been read (NULL on error).
+ * \return true if the relation has been read, false if an error occurred.
+ */
+bool osl_relation_psread_try(char** const input, const int precision,
+                             osl_relation** const relation) {
+  struct osl_relation_read_args args = {NULL, input, precision, NULL};
+  const bool success = osl_error_try(osl_relation_read_body, &args);
+
+  *relation = args.relation;
+  return success;
+}
+
 /**
  * osl_relation_read function:
  * this function is equivalent to osl_relation_pread() except that
@@ -1572,6 +1892,7 @@ osl_relation* osl_relation_pmalloc(const int precision, const int nb_rows,
   relation->nb_parameters = OSL_UNDEFINED;
   relation->nb_local_dims = OSL_UNDEFINED;
   relation->precision = precision;
+  relation->generation = osl_util_generation();
 
   if ((nb_rows == 0) || (nb_columns == 0) || (nb_rows == OSL_UNDEFINED) ||
       (nb_columns == OSL_UNDEFINED)) {
@@ -1626,8 +1947,8 @@ void osl_relation_free_inside(osl_relation* const relation) {
 
   if (relation->m) {
     if (nb_elements > 0)
-      free(relation->m[0]);
-    free(relation->m);
+      osl_allocator_free(relation->m[0]);
+    osl_allocator_free(relation->m);
   }
 }
 
@@ -1641,7 +1962,7 @@ void osl_relation_free(osl_relation* relation) {
   while (relation) {
     osl_relation* const tmp = relation->next;
     osl_relation_free_inside(relation);
-    free(relation);
+    osl_allocator_free(relation);
     relation = tmp;
   }
 }
@@ -1661,6 +1982,9 @@ void osl_relation_free(osl_relation* relation) {
  *         first n parts of the relation union.
  */
 osl_relation* osl_relation_nclone(const osl_relation* relation, const int n) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+
   bool first = true;
   osl_relation* clone = NULL;
   osl_relation* previous = NULL;
@@ -1695,6 +2019,7 @@ osl_relation* osl_relation_nclone(const osl_relation* relation, const int n) {
     relation = relation->next;
   }
 
+  OSL_perf_end(OSL_PERF_RELATION_CLONE, &mark);
   return clone;
 }
 
@@ -1822,6 +2147,7 @@ void osl_relation_replace_vector(osl_relation* const relation,
       (row < 0))
     OSL_error("vector cannot replace relation row");
 
+  relation->generation = osl_util_generation();
   for (int i = 0; i < vector->size; i++)
     osl_int_assign(relation->precision, &relation->m[row][i], vector->v[i]);
 }
@@ -1843,6 +2169,7 @@ void osl_relation_add_vector(osl_relation* const relation,
       (row < 0))
     OSL_error("vector cannot be added to relation");
 
+  relation->generation = osl_util_generation();
   if (osl_int_get_si(relation->precision, relation->m[row][0]) == 0)
     osl_int_assign(relation->precision, &relation->m[row][0], vector->v[0]);
 
@@ -1867,6 +2194,7 @@ void osl_relation_sub_vector(osl_relation* const relation,
       (row < 0))
     OSL_error("vector cannot be subtracted to row");
 
+  relation->generation = osl_util_generation();
   if (osl_int_get_si(relation->precision, relation->m[row][0]) == 0)
     osl_int_assign(relation->precision, &relation->m[row][0], vector->v[0]);
 
@@ -1963,11 +2291,12 @@ void osl_relation_insert_blank_column(osl_relation* const relation,
   osl_relation_free_inside(relation);
 
   // Replace the inside of relation.
+  relation->generation = osl_util_generation();
   relation->nb_columns = temp->nb_columns;
   relation->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  osl_allocator_free(temp);
 }
 
 /**
@@ -2004,6 +2333,7 @@ void osl_relation_replace_constraints(osl_relation* const r1,
       ((row + r2->nb_rows) > r1->nb_rows) || (row < 0))
     OSL_error("relation rows could not be replaced");
 
+  r1->generation = osl_util_generation();
   for (int i = 0; i < r2->nb_rows; i++)
     for (int j = 0; j < r2->nb_columns; j++)
       osl_int_assign(r1->precision, &r1->m[i + row][j], r2->m[i][j]);
@@ -2050,11 +2380,12 @@ void osl_relation_insert_constraints(osl_relation* const r1,
   osl_relation_free_inside(r1);
 
   // Replace the inside of relation.
+  r1->generation = osl_util_generation();
   r1->nb_rows = temp->nb_rows;
   r1->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  osl_allocator_free(temp);
 }
 
 /**
@@ -2074,6 +2405,7 @@ void osl_relation_swap_constraints(osl_relation* const relation, const int c1,
       (c2 < 0))
     OSL_error("bad constraint rows");
 
+  relation->generation = osl_util_generation();
   for (int i = 0; i < relation->nb_columns; i++)
     osl_int_swap(relation->precision, &relation->m[c1][i], &relation->m[c2][i]);
 }
@@ -2107,11 +2439,12 @@ void osl_relation_remove_row(osl_relation* const r, const int row) {
   osl_relation_free_inside(r);
 
   // Replace the inside of relation.
+  r->generation = osl_util_generation();
   r->nb_rows = temp->nb_rows;
   r->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  osl_allocator_free(temp);
 }
 
 /**
@@ -2143,11 +2476,12 @@ void osl_relation_remove_column(osl_relation* const r, const int column) {
   osl_relation_free_inside(r);
 
   // Replace the inside of relation.
+  r->generation = osl_util_generation();
   r->nb_columns = temp->nb_columns;
   r->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  osl_allocator_free(temp);
 }
 
 /**
@@ -2194,11 +2528,12 @@ void osl_relation_insert_columns(osl_relation* const relation,
   osl_relation_free_inside(relation);
 
   // Replace the inside of relation.
+  relation->generation = osl_util_generation();
   relation->nb_columns = temp->nb_columns;
   relation->m = temp->m;
 
   // Free the temp "shell".
-  free(temp);
+  osl_allocator_free(temp);
 }
 
 /**
@@ -2278,18 +2613,46 @@ bool osl_relation_part_equal(const osl_relation* const r1,
  * \return 1 if r1 and r2 are the same (content-wise), 0 otherwise.
  */
 bool osl_relation_equal(const osl_relation* r1, const osl_relation* r2) {
-  while (r1 && r2) {
-    if (!osl_relation_part_equal(r1, r2))
-      return 0;
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
 
+  while (r1 && r2 && osl_relation_part_equal(r1, r2)) {
     r1 = r1->next;
     r2 = r2->next;
   }
 
-  if ((!r1 && r2) || (r1 && !r2))
-    return 0;
+  // Both unions are equal if every part has been matched.
+  const bool equal = !r1 && !r2;
+  OSL_perf_end(OSL_PERF_RELATION_EQUAL, &mark);
+  return equal;
+}
 
-  return 1;
+/**
+ * osl_relation_memory_usage function:
+ * this function adds the memory footprint of a relation union (its nodes,
+ * row-pointer arrays, matrix elements and GMP limbs) to a memory usage.
+ * \param[in]     relation The relation union.
+ * \param[in,out] usage    The memory usage to update.
+ */
+void osl_relation_memory_usage(const osl_relation* relation,
+                               osl_memory_usage* const usage) {
+  while (relation) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_relation));
+    if (relation->m) {
+      const size_t nb_rows = (size_t)relation->nb_rows;
+      const size_t nb_elements = nb_rows * (size_t)relation->nb_columns;
+      osl_memory_usage_add(usage, &usage->rows, nb_rows * sizeof(osl_int*));
+      if (nb_elements > 0) {
+        osl_memory_usage_add(usage, &usage->matrices,
+                             nb_elements * sizeof(osl_int));
+        if (relation->precision == OSL_PRECISION_MP)
+          for (size_t i = 0; i < nb_elements; i++)
+            osl_int_memory_usage(relation->precision, relation->m[0][i],
+                                 usage);
+      }
+    }
+    relation = relation->next;
+  }
 }
 
 /**
@@ -2495,6 +2858,7 @@ void osl_relation_set_attributes_one(osl_relation* const relation,
                                      const int nb_local_dims,
                                      const int nb_parameters) {
   if (relation) {
+    relation->generation = osl_util_generation();
     relation->nb_output_dims = nb_output_dims;
     relation->nb_input_dims = nb_input_dims;
     relation->nb_local_dims = nb_local_dims;
@@ -2533,11 +2897,28 @@ void osl_relation_set_attributes(osl_relation* relation,
  */
 void osl_relation_set_type(osl_relation* relation, const int type) {
   while (relation) {
+    relation->generation = osl_util_generation();
     relation->type = type;
     relation = relation->next;
   }
 }
 
+/**
+ * osl_relation_touch function:
+ * this function marks each part of a relation union as modified, so that
+ * the texts cached for it are not used anymore (see
+ * osl_statement_enable_print_cache). The functions of the library which
+ * modify a relation do it themselves: it is only necessary after a direct
+ * modification of the fields or of the matrix elements.
+ * \param[in,out] relation The relation union to mark as modified.
+ */
+void osl_relation_touch(osl_relation* relation) {
+  while (relation) {
+    relation->generation = osl_util_generation();
+    relation = relation->next;
+  }
+}
+
 /**
  * osl_relation_get_array_id function:
  * this function returns the array identifier in a relation with access type
@@ -2803,6 +3184,73 @@ osl_relation* osl_relation_extend_output(const osl_relation* relation,
   return extended;
 }
 
+/**
+ * osl_relation_extend_output_inplace function:
+ * this function is equivalent to osl_relation_extend_output() except that
+ * it extends the relation itself instead of a copy: the matrix of each union
+ * part is grown in place (the existing elements are moved, not copied, and
+ * the row and element arrays are reallocated, which may reuse the slack of
+ * their blocks). Union parts which already have "dim" output dimensions are
+ * left untouched.
+ * \param[in,out] relation The relation to extend.
+ * \param[in]     dim      The number of output dimension to reach.
+ */
+void osl_relation_extend_output_inplace(osl_relation* relation,
+                                        const int dim) {
+  for (; relation; relation = relation->next) {
+    if (relation->nb_output_dims > dim)
+      OSL_error("Number of output dims is greater than required extension");
+    const int offset = dim - relation->nb_output_dims;
+    if (offset == 0)
+      continue;
+
+    const int precision = relation->precision;
+    const int nb_rows = relation->nb_rows + offset;
+    const int nb_columns = relation->nb_columns + offset;
+    const int nb_heads = relation->nb_output_dims + 1;
+    const int nb_tails = relation->nb_columns - nb_heads;
+    const bool has_elements = (relation->m != NULL);
+    osl_int* elements = has_elements ? relation->m[0] : NULL;
+    OSL_realloc(elements, osl_int*,
+                (size_t)nb_rows * (size_t)nb_columns * sizeof(osl_int));
+    OSL_realloc(relation->m, osl_int**, (size_t)nb_rows * sizeof(osl_int*));
+
+    // Spread the rows from the last one, so that no element is overwritten
+    // before it is moved, and clear the new output dimension columns.
+    for (int i = relation->nb_rows - 1; i >= 0; i--) {
+      osl_int* const source = elements + (size_t)i * relation->nb_columns;
+      osl_int* const target = elements + (size_t)i * nb_columns;
+      if (has_elements) {
+        memmove(target + nb_heads + offset, source + nb_heads,
+                (size_t)nb_tails * sizeof(osl_int));
+        memmove(target, source, (size_t)nb_heads * sizeof(osl_int));
+        for (int j = nb_heads; j < nb_heads + offset; j++)
+          osl_int_init_set_si(precision, &target[j], 0);
+      } else {
+        for (int j = 0; j < nb_columns; j++)
+          osl_int_init_set_si(precision, &target[j], 0);
+      }
+    }
+
+    // New rows dedicated to the new dimensions
+    for (int i = relation->nb_rows; i < nb_rows; i++) {
+      osl_int* const row = elements + (size_t)i * nb_columns;
+      for (int j = 0; j < nb_columns; j++)
+        osl_int_init_set_si(precision, &row[j], 0);
+      osl_int_set_si(precision,
+                     &row[i - relation->nb_rows + relation->nb_output_dims + 1],
+                     -1);
+    }
+
+    for (int i = 0; i < nb_rows; i++)
+      relation->m[i] = elements + (size_t)i * nb_columns;
+    relation->generation = osl_util_generation();
+    relation->nb_rows = nb_rows;
+    relation->nb_columns = nb_columns;
+    relation->nb_output_dims = dim;
+  }
+}
+
 /**
  * osl_relation_interface function:
  * this function creates an interface structure corresponding to the relation
@@ -2820,6 +3268,7 @@ osl_interface* osl_relation_interface(void) {
   interface->free = (osl_free_f)osl_relation_free;
   interface->clone = (osl_clone_f)osl_relation_clone;
   interface->equal = (osl_equal_f)osl_relation_equal;
+  interface->size = (osl_size_f)osl_relation_memory_usage;
 
   return interface;
 }
@@ -2831,6 +3280,9 @@ osl_interface* osl_relation_interface(void) {
  * \param[in,out] r         A osl relation to change the precision
  */
 void osl_relation_set_precision(int const precision, osl_relation* r) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+
   while (r) {
     if (precision != r->precision) {
       for (size_t i = 0; i < (size_t)r->nb_rows; ++i) {
@@ -2839,9 +3291,12 @@ void osl_relation_set_precision(int const precision, osl_relation* r) {
         }
       }
       r->precision = precision;
+      r->generation = osl_util_generation();
     }
     r = r->next;
   }
+
+  OSL_perf_end(OSL_PERF_PRECISION, &mark);
 }
 
 /**
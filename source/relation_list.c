@@ -137,25 +137,46 @@ void osl_relation_list_dump(FILE* const file,
 void osl_relation_list_pprint_elts(FILE* const file,
                                    const osl_relation_list* const list,
                                    const osl_names* const names) {
-  // Count the number of elements in the list with non-NULL content.
-  size_t i = osl_relation_list_count(list);
+  char* const string = osl_relation_list_spprint_elts(list, names);
+  fprintf(file, "%s", string);
+  osl_allocator_free(string);
+}
+
+/**
+ * osl_relation_list_spprint_elts function:
+ * this function pretty-prints the elements of a osl_relation_list structure
+ * into a string in the OpenScop format, as osl_relation_list_pprint_elts
+ * does, and returns this string.
+ * \param[in] list  The relation list whose information has to be printed.
+ * \param[in] names Array of constraint columns names.
+ * \return A string containing the elements of the relation list.
+ */
+char* osl_relation_list_spprint_elts(const osl_relation_list* const list,
+                                     const osl_names* const names) {
+  size_t high_water_mark = OSL_MAX_STRING;
+  char* string = NULL;
+
+  OSL_malloc(string, char*, high_water_mark * sizeof(char));
+  string[0] = '\0';
 
   // Print each element of the relation list.
-  if (i > 0) {
-    i = 0;
+  if (osl_relation_list_count(list) > 0) {
     const osl_relation_list* head = list;
     while (head) {
       if (head->elt) {
-        osl_relation_pprint(file, head->elt, names);
+        char* const element = osl_relation_spprint(head->elt, names);
+        osl_util_safe_strcat(&string, element, &high_water_mark);
+        osl_allocator_free(element);
         if (head->next)
-          fprintf(file, "\n");
-        i++;
+          osl_util_safe_strcat(&string, "\n", &high_water_mark);
       }
       head = head->next;
     }
   } else {
-    fprintf(file, "# NULL relation list\n");
+    osl_util_safe_strcat(&string, "# NULL relation list\n", &high_water_mark);
   }
+
+  return string;
 }
 
 /**
@@ -315,6 +336,7 @@ osl_relation_list* osl_relation_list_pread(FILE* const file,
 
   // Allocate the header of the list and start reading each element.
   osl_relation_list* const res = osl_relation_list_malloc();
+  osl_error_protect(res, (osl_error_cleanup_f)osl_relation_list_free);
   osl_relation_list* list = res;
   for (int i = 0; i < nb_mat; ++i) {
     list->elt = osl_relation_pread(file, precision);
@@ -323,6 +345,7 @@ osl_relation_list* osl_relation_list_pread(FILE* const file,
     list = list->next;
   }
 
+  osl_error_unprotect(res);
   return res;
 }
 
@@ -374,7 +397,7 @@ void osl_relation_list_free(osl_relation_list* list) {
     if (list->elt)
       osl_relation_free(list->elt);
     osl_relation_list* const tmp = list->next;
-    free(list);
+    osl_allocator_free(list);
     list = tmp;
   }
 }
@@ -579,6 +602,23 @@ bool osl_relation_list_equal(const osl_relation_list* l1,
   return true;
 }
 
+/**
+ * osl_relation_list_memory_usage function:
+ * this function adds the memory footprint of a relation list (its nodes
+ * and their relations) to a memory usage.
+ * \param[in]     list  The relation list.
+ * \param[in,out] usage The memory usage to update.
+ */
+void osl_relation_list_memory_usage(const osl_relation_list* list,
+                                    osl_memory_usage* const usage) {
+  while (list) {
+    osl_memory_usage_add(usage, &usage->structures,
+                         sizeof(osl_relation_list));
+    osl_relation_memory_usage(list->elt, usage);
+    list = list->next;
+  }
+}
+
 /**
  * osl_relation_integrity_check function:
  * This function checks that a list of relation is "well formed" according to
@@ -623,6 +663,7 @@ bool osl_relation_list_integrity_check(const osl_relation_list* list,
 void osl_relation_list_set_type(osl_relation_list* list, const int type) {
   while (list) {
     if (list->elt) {
+      list->elt->generation = osl_util_generation();
       list->elt->type = type;
     }
     list = list->next;
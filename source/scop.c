@@ -64,6 +64,7 @@
 #include <string.h>
 
 #include <osl/extensions/arrays.h>
+#include <osl/extensions/dependence.h>
 #include <osl/extensions/textual.h>
 #include <osl/generic.h>
 #include <osl/interface.h>
@@ -176,6 +177,21 @@ osl_names* osl_scop_names(const osl_scop* const scop) {
  * \param scop The scop structure whose information has to be printed.
  */
 void osl_scop_print(FILE* const file, const osl_scop* scop) {
+  osl_scop_print_parallel(file, scop, 1);
+}
+
+/**
+ * osl_scop_print_parallel function:
+ * this function is equivalent to osl_scop_print() except that the
+ * statements are formatted concurrently by nb_threads threads (see
+ * osl_statement_pprint_parallel). The output is identical.
+ * \param file       The file where the information has to be printed.
+ * \param scop       The scop structure whose information has to be printed.
+ * \param nb_threads The number of threads to use (the number of online
+ *                   processors if it is not positive).
+ */
+void osl_scop_print_parallel(FILE* const file, const osl_scop* scop,
+                             const int nb_threads) {
   if (!scop) {
     fprintf(file, "# NULL scop\n");
     return;
@@ -184,11 +200,18 @@ void osl_scop_print(FILE* const file, const osl_scop* scop) {
             OSL_RELEASE);
   }
 
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe2(scop__print__start, osl_scop_number(scop),
+             osl_statement_number(scop->statement));
+
   if (osl_scop_integrity_check(scop) == 0)
     OSL_warning("OpenScop integrity check failed. Something may go wrong.");
 
-  // Generate the names for the various dimensions.
+  // Generate the names for the various dimensions, the column names and
+  // headers of the relations are computed once for each relation shape.
   osl_names* const names = osl_scop_names(scop);
+  osl_names_enable_cache(names);
 
   while (scop) {
     bool arrays_backedup = false;
@@ -230,7 +253,7 @@ void osl_scop_print(FILE* const file, const osl_scop* scop) {
     fprintf(file, "\n# Number of statements\n");
     fprintf(file, "%d\n\n", osl_statement_number(scop->statement));
 
-    osl_statement_pprint(file, scop->statement, names);
+    osl_statement_pprint_parallel(file, scop->statement, names, nb_threads);
 
     if (scop->extension) {
       fprintf(file,
@@ -257,6 +280,8 @@ void osl_scop_print(FILE* const file, const osl_scop* scop) {
   }
 
   osl_names_free(names);
+  OSL_probe(scop__print__done);
+  OSL_perf_end(OSL_PERF_SCOP_PRINT, &mark);
 }
 
 /**
@@ -379,6 +404,10 @@ osl_scop* osl_scop_pread(FILE* const file, osl_interface* const registry,
   if (!file)
     return NULL;
 
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe1(scop__read__start, precision);
+
   osl_scop* list = NULL;
   osl_scop* current = NULL;
   bool first = true;
@@ -392,10 +421,11 @@ osl_scop* osl_scop_pread(FILE* const file, osl_interface* const registry,
       OSL_debug("no more scop in the file");
       break;
     } else {
-      free(tmp);
+      osl_allocator_free(tmp);
     }
 
     osl_scop* const scop = osl_scop_malloc();
+    osl_error_protect(scop, (osl_error_cleanup_f)osl_scop_free);
     scop->registry = osl_interface_clone(registry);
 
     //
@@ -404,8 +434,10 @@ osl_scop* osl_scop_pread(FILE* const file, osl_interface* const registry,
 
     // Read the language.
     osl_strings* const language = osl_strings_read(file);
-    if (osl_strings_size(language) == 0)
+    if (osl_strings_size(language) == 0) {
+      osl_strings_free(language);
       OSL_error("no language (backend) specified");
+    }
 
     if (osl_strings_size(language) > 1)
       OSL_warning("uninterpreted information (after language)");
@@ -448,19 +480,24 @@ osl_scop* osl_scop_pread(FILE* const file, osl_interface* const registry,
     // Read up the end tag (if any), and store extensions.
     scop->extension = osl_generic_read(file, scop->registry);
 
-    // Add the new scop to the list.
+    // Add the new scop to the list (the list head remains protected).
     if (first) {
       list = scop;
       first = false;
     } else {
       current->next = scop;
+      osl_error_unprotect(scop);
     }
     current = scop;
   }
+  osl_error_unprotect(list);
 
   if (!osl_scop_integrity_check(list))
     OSL_warning("scop integrity check failed");
 
+  OSL_probe2(scop__read__done, osl_scop_number(list),
+             list ? osl_statement_number(list->statement) : 0);
+  OSL_perf_end(OSL_PERF_SCOP_READ, &mark);
   return list;
 }
 
@@ -481,6 +518,61 @@ osl_scop* osl_scop_read(FILE* const foo) {
   return scop;
 }
 
+/**
+ * Arguments and result of osl_scop_pread when run by osl_scop_pread_try.
+ */
+struct osl_scop_pread_args {
+  FILE* file;
+  osl_interface* registry;
+  int precision;
+  osl_scop* scop;
+};
+
+/**
+ * osl_scop_pread_body function:
+ * this function runs osl_scop_pread on behalf of osl_scop_pread_try.
+ * \param[in,out] data The arguments and result of osl_scop_pread.
+ */
+static void osl_scop_pread_body(void* const data) {
+  struct osl_scop_pread_args* const args = data;
+  args->scop = osl_scop_pread(args->file, args->registry, args->precision);
+}
+
+/**
+ * osl_scop_pread_try function:
+ * this function is equivalent to osl_scop_pread() except that errors do not
+ * exit the program: the partially read scops are freed and the function
+ * fails (see osl_error_try).
+ * \param[in]  file      The file where the scop has to be read.
+ * \param[in]  registry  The list of known interfaces (others are ignored).
+ * \param[in]  precision The precision of the relation elements.
+ * \param[out] scop      The scop list that has been read (NULL on error).
+ * \return true if the scop list has been read, false if an error occurred.
+ */
+bool osl_scop_pread_try(FILE* const file, osl_interface* const registry,
+                        const int precision, osl_scop** const scop) {
+  struct osl_scop_pread_args args = {file, registry, precision, NULL};
+  const bool success = osl_error_try(osl_scop_pread_body, &args);
+
+  *scop = args.scop;
+  return success;
+}
+
+/**
+ * osl_scop_read_try function:
+ * this function is equivalent to osl_scop_pread_try() with the precision
+ * and the list of known interfaces of osl_scop_read().
+ * \see{osl_scop_pread_try}
+ */
+bool osl_scop_read_try(FILE* const foo, osl_scop** const scop) {
+  const int precision = osl_util_get_precision();
+  osl_interface* const registry = osl_interface_get_default_registry();
+  const bool success = osl_scop_pread_try(foo, registry, precision, scop);
+
+  osl_interface_free(registry);
+  return success;
+}
+
 /******************************************************************************
  *                   Memory allocation/deallocation functions                 *
  ******************************************************************************/
@@ -503,6 +595,8 @@ osl_scop* osl_scop_malloc(void) {
   scop->statement = NULL;
   scop->registry = NULL;
   scop->extension = NULL;
+  scop->extension_index = NULL;
+  scop->statement_index = NULL;
   scop->usr = NULL;
   scop->next = NULL;
 
@@ -517,15 +611,17 @@ osl_scop* osl_scop_malloc(void) {
 void osl_scop_free(osl_scop* scop) {
   while (scop) {
     if (scop->language)
-      free(scop->language);
+      osl_allocator_free(scop->language);
     osl_generic_free(scop->parameters);
     osl_relation_free(scop->context);
     osl_statement_free(scop->statement);
     osl_interface_free(scop->registry);
     osl_generic_free(scop->extension);
+    osl_generic_index_free(scop->extension_index);
+    osl_statement_index_free(scop->statement_index);
 
     osl_scop* const tmp = scop->next;
-    free(scop);
+    osl_allocator_free(scop);
     scop = tmp;
   }
 }
@@ -574,9 +670,25 @@ size_t osl_scop_number(const osl_scop* scop) {
  * \return A pointer to the full clone of the scop provided as parameter.
  */
 osl_scop* osl_scop_clone(const osl_scop* scop) {
+  return osl_scop_clone_parallel(scop, 1);
+}
+
+/**
+ * osl_scop_clone_parallel function:
+ * this function is equivalent to osl_scop_clone() except that the
+ * statements are cloned concurrently by nb_threads threads (see
+ * osl_statement_clone_parallel). The clone is identical.
+ * \param scop       The pointer to the scop we want to clone.
+ * \param nb_threads The number of threads to use (the number of online
+ *                   processors if it is not positive).
+ * \return A pointer to the full clone of the scop provided as parameter.
+ */
+osl_scop* osl_scop_clone_parallel(const osl_scop* scop, const int nb_threads) {
   osl_scop* clone = NULL;
   osl_scop* previous = NULL;
   bool first = true;
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
 
   while (scop) {
     osl_scop* const node = osl_scop_malloc();
@@ -585,7 +697,7 @@ osl_scop* osl_scop_clone(const osl_scop* scop) {
       OSL_strdup(node->language, scop->language);
     node->context = osl_relation_clone(scop->context);
     node->parameters = osl_generic_clone(scop->parameters);
-    node->statement = osl_statement_clone(scop->statement);
+    node->statement = osl_statement_clone_parallel(scop->statement, nb_threads);
     node->registry = osl_interface_clone(scop->registry);
     node->extension = osl_generic_clone(scop->extension);
 
@@ -601,6 +713,7 @@ osl_scop* osl_scop_clone(const osl_scop* scop) {
     scop = scop->next;
   }
 
+  OSL_perf_end(OSL_PERF_SCOP_CLONE, &mark);
   return clone;
 }
 
@@ -608,6 +721,8 @@ osl_scop* osl_scop_clone(const osl_scop* scop) {
  * osl_scop_remove_unions function:
  * Replace each statement having unions of relations by a list of statements,
  * each of which has exactly one domain relation and one scattering relation.
+ * Everything is copied: to enumerate these statements without copies, use an
+ * osl_statement_union_iterator over the statements of each scop.
  * \param[in] scop A SCoP with statements featuring unions of relations.
  * \returns  An identical SCoP without unions of relations.
  */
@@ -630,14 +745,15 @@ osl_scop* osl_scop_remove_unions(const osl_scop* scop) {
         scop_statement_ptr->next = new_statement;
         scop_statement_ptr = scop_statement_ptr->next;
       }
+      // Move to the end of the new statements before appending the next ones.
+      while (scop_statement_ptr && scop_statement_ptr->next)
+        scop_statement_ptr = scop_statement_ptr->next;
     }
-    while (scop_statement_ptr && scop_statement_ptr->next)
-      scop_statement_ptr = scop_statement_ptr->next;
 
     new_scop->context = osl_relation_clone(scop->context);
     new_scop->extension = osl_generic_clone(scop->extension);
     if (scop->language) {
-      new_scop->language = malloc(strlen(scop->language) + 1);
+      new_scop->language = osl_allocator_malloc(strlen(scop->language) + 1);
       new_scop->language = strcpy(new_scop->language, scop->language);
     }
     new_scop->parameters = osl_generic_clone(scop->parameters);
@@ -656,14 +772,16 @@ osl_scop* osl_scop_remove_unions(const osl_scop* scop) {
 }
 
 /**
- * osl_scop_equal function:
- * this function returns true if the two scops are the same, false
- * otherwise (the usr field is not tested).
- * \param s1 The first scop.
- * \param s2 The second scop.
+ * osl_scop_list_equal internal function:
+ * this function returns true if the two lists of scops are the same, false
+ * otherwise (see osl_scop_equal_parallel).
+ * \param s1         The first scop list.
+ * \param s2         The second scop list.
+ * \param nb_threads The number of threads to compare the statements.
  * \return 1 if s1 and s2 are the same (content-wise), 0 otherwise.
  */
-bool osl_scop_equal(const osl_scop* s1, const osl_scop* s2) {
+static bool osl_scop_list_equal(const osl_scop* s1, const osl_scop* s2,
+                                const int nb_threads) {
   while (s1 && s2) {
     if (s1 == s2)
       return true;
@@ -673,7 +791,8 @@ bool osl_scop_equal(const osl_scop* s1, const osl_scop* s2) {
       return false;
     }
 
-    if (strcmp(s1->language, s2->language) != 0) {
+    if ((!s1->language != !s2->language) ||
+        (s1->language && strcmp(s1->language, s2->language) != 0)) {
       OSL_info("languages are not the same");
       return false;
     }
@@ -688,7 +807,8 @@ bool osl_scop_equal(const osl_scop* s1, const osl_scop* s2) {
       return false;
     }
 
-    if (!osl_statement_equal(s1->statement, s2->statement)) {
+    if (!osl_statement_equal_parallel(s1->statement, s2->statement,
+                                      nb_threads)) {
       OSL_info("statements are not the same");
       return false;
     }
@@ -713,6 +833,73 @@ bool osl_scop_equal(const osl_scop* s1, const osl_scop* s2) {
   return true;
 }
 
+/**
+ * osl_scop_equal function:
+ * this function returns true if the two scops are the same, false
+ * otherwise (the usr field is not tested).
+ * \param s1 The first scop.
+ * \param s2 The second scop.
+ * \return 1 if s1 and s2 are the same (content-wise), 0 otherwise.
+ */
+bool osl_scop_equal(const osl_scop* s1, const osl_scop* s2) {
+  return osl_scop_equal_parallel(s1, s2, 1);
+}
+
+/**
+ * osl_scop_equal_parallel function:
+ * this function is equivalent to osl_scop_equal() except that the
+ * statements are compared concurrently by nb_threads threads, which stop at
+ * the first difference (see osl_statement_equal_parallel).
+ * \param s1         The first scop.
+ * \param s2         The second scop.
+ * \param nb_threads The number of threads to use (the number of online
+ *                   processors if it is not positive).
+ * \return 1 if s1 and s2 are the same (content-wise), 0 otherwise.
+ */
+bool osl_scop_equal_parallel(const osl_scop* s1, const osl_scop* s2,
+                             const int nb_threads) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+
+  const bool equal = osl_scop_list_equal(s1, s2, nb_threads);
+  OSL_perf_end(OSL_PERF_SCOP_EQUAL, &mark);
+  return equal;
+}
+
+/**
+ * osl_scop_memory_usage function:
+ * this function adds the memory footprint of a scop list (statements,
+ * relations, strings, registries, extensions, etc.) to a memory usage, by
+ * category (see osl_memory_usage). The memory usage has to be initialized
+ * first (see osl_memory_usage_init).
+ * \param[in]     scop  The scop list.
+ * \param[in,out] usage The memory usage to update.
+ */
+void osl_scop_memory_usage(const osl_scop* scop,
+                           osl_memory_usage* const usage) {
+  while (scop) {
+    osl_memory_usage_add(usage, &usage->structures, sizeof(osl_scop));
+    osl_memory_usage_string(usage, scop->language);
+    osl_relation_memory_usage(scop->context, usage);
+    osl_generic_memory_usage(scop->parameters, usage);
+    for (const osl_statement* statement = scop->statement; statement;
+         statement = statement->next)
+      osl_statement_memory_usage(statement, usage);
+    osl_interface_memory_usage(scop->registry, usage);
+    osl_generic_memory_usage(scop->extension, usage);
+    if (scop->extension_index)
+      osl_memory_usage_add(usage, &usage->indexes, sizeof(osl_generic_index));
+    if (scop->statement_index) {
+      osl_memory_usage_add(usage, &usage->indexes, sizeof(osl_statement_index));
+      if (scop->statement_index->capacity)
+        osl_memory_usage_add(
+            usage, &usage->indexes,
+            scop->statement_index->capacity * sizeof(osl_statement*));
+    }
+    scop = scop->next;
+  }
+}
+
 /**
  * osl_scop_integrity_check function:
  * This function checks that a scop is "well formed". It returns 0 if the
@@ -841,10 +1028,150 @@ void osl_scop_register_extension(osl_scop* scop, osl_interface* interface) {
       char* extension_string = t->textual;
       osl_generic* const new = osl_generic_sread(&extension_string, interface);
       osl_generic_add(&scop->extension, new);
+      osl_scop_extension_invalidate(scop);
     }
   }
 }
 
+/**
+ * osl_scop_extension_lookup function:
+ * this function returns the data of the extension with a given URI of a scop
+ * and NULL if there is no such extension. It relies on a lookup index which
+ * is built on the first call, hence it runs in constant time for the URIs of
+ * the default registry. It may be called concurrently on the same scop (see
+ * osl_generic_index_cached_lookup). After osl_generic_add or
+ * osl_generic_remove on the extension list, the lookups are linear until
+ * osl_scop_extension_invalidate is called. If the list is modified
+ * directly, osl_scop_extension_invalidate must be called before the next
+ * lookup.
+ * \param[in,out] scop The scop where to search a given extension URI.
+ * \param[in]     URI  The URI of the extension we are looking for.
+ * \return The data of the extension with the requested URI in the scop.
+ */
+void* osl_scop_extension_lookup(osl_scop* const scop, const char* const URI) {
+  return osl_generic_index_cached_lookup(&scop->extension_index,
+                                         scop->extension, URI);
+}
+
+/**
+ * osl_scop_extension_invalidate function:
+ * this function drops the extension lookup index of a scop (see
+ * osl_scop_extension_lookup). It has to be called each time the
+ * extension list of the scop is modified directly.
+ * \param[in,out] scop The scop whose extension index is outdated.
+ */
+void osl_scop_extension_invalidate(osl_scop* const scop) {
+  osl_generic_index_free(scop->extension_index);
+  scop->extension_index = NULL;
+}
+
+/**
+ * osl_scop_statement_index internal function:
+ * this function returns the statement index of a scop, built on the first
+ * call, or NULL if it is outdated (see osl_statement_index_is_valid). It may
+ * be called concurrently on the same scop, as osl_scop_extension_lookup.
+ * \param[in,out] scop The scop whose statement index is required.
+ * \return The up to date statement index of the scop, NULL if outdated.
+ */
+static osl_statement_index* osl_scop_statement_index(osl_scop* const scop) {
+  osl_statement_index* index =
+      __atomic_load_n(&scop->statement_index, __ATOMIC_ACQUIRE);
+
+  if (!index) {
+    osl_statement_index* const built =
+        osl_statement_index_build(scop->statement);
+    if (__atomic_compare_exchange_n(&scop->statement_index, &index, built,
+                                    false, __ATOMIC_ACQ_REL,
+                                    __ATOMIC_ACQUIRE)) {
+      index = built;
+    } else {
+      osl_statement_index_free(built);
+    }
+  }
+
+  if (!osl_statement_index_is_valid(index, scop->statement))
+    return NULL;
+
+  return index;
+}
+
+/**
+ * osl_scop_statement_get function:
+ * this function returns the statement at a given position (from 0, as the
+ * statement labels of the dependences) in the statement list of a scop, or
+ * NULL if there is no such position. It relies on an array index which is
+ * built on the first call, hence it runs in constant time. The index is kept
+ * up to date by osl_scop_statement_add; if the statement list is modified
+ * otherwise, the statements are found by walking the list (the changes made
+ * through osl_statement_add or followed by osl_statement_touch on the head
+ * of the list are detected) until osl_scop_statement_invalidate is called.
+ * \param[in,out] scop     The scop where to find the statement.
+ * \param[in]     position The position of the statement in the list.
+ * \return The statement at the given position, NULL if there is none.
+ */
+osl_statement* osl_scop_statement_get(osl_scop* const scop,
+                                      const int position) {
+  const osl_statement_index* const index = osl_scop_statement_index(scop);
+  if (index)
+    return osl_statement_index_get(index, position);
+
+  osl_statement* statement = scop->statement;
+  for (int i = 0; statement && (i < position); i++)
+    statement = statement->next;
+  return (position < 0) ? NULL : statement;
+}
+
+/**
+ * osl_scop_statement_number function:
+ * this function returns the number of statements of a scop, in constant time
+ * when its statement index is up to date (see osl_scop_statement_get).
+ * \param[in,out] scop The scop whose statements are counted.
+ * \return The number of statements of the scop.
+ */
+int osl_scop_statement_number(osl_scop* const scop) {
+  const osl_statement_index* const index = osl_scop_statement_index(scop);
+  if (index)
+    return (int)index->size;
+
+  return osl_statement_number(scop->statement);
+}
+
+/**
+ * osl_scop_statement_add function:
+ * this function adds a statement list at the end of the statement list of a
+ * scop, in constant time (amortized), and keeps the statement index of the
+ * scop up to date (see osl_scop_statement_get).
+ * \param[in,out] scop      The scop where to add the statements.
+ * \param[in]     statement The statement list to add.
+ */
+void osl_scop_statement_add(osl_scop* const scop,
+                            osl_statement* const statement) {
+  osl_statement_index* index = osl_scop_statement_index(scop);
+  if (!index) {
+    osl_scop_statement_invalidate(scop);
+    index = osl_scop_statement_index(scop);
+  }
+
+  if (index->size == 0)
+    scop->statement = statement;
+  else
+    index->statement[index->size - 1]->next = statement;
+  osl_statement_index_add(index, statement);
+}
+
+/**
+ * osl_scop_statement_invalidate function:
+ * this function drops the statement index of a scop (see
+ * osl_scop_statement_get). It has to be called each time the statement list
+ * of the scop is modified directly, unless the change is detected (see
+ * osl_statement_index_is_valid).
+ * \param[in,out] scop The scop whose statement index is outdated.
+ */
+void osl_scop_statement_invalidate(osl_scop* const scop) {
+  osl_statement_index_free(scop->statement_index);
+  scop->statement_index = NULL;
+}
+
 /**
  * osl_scop_get_attributes function:
  * this function returns, through its parameters, the maximum values of the
@@ -894,7 +1221,8 @@ void osl_scop_get_attributes(const osl_scop* scop, int* const nb_parameters,
  * osl_scop_normalize_scattering function:
  * this function modifies a scop such that all scattering relation have
  * the same number of output dimensions (additional output dimensions are
- * set as being equal to zero).
+ * set as being equal to zero). The scattering relations are extended in
+ * place (see osl_relation_extend_output_inplace).
  * \param[in,out] scop The scop to nomalize the scattering functions.
  */
 void osl_scop_normalize_scattering(osl_scop* scop) {
@@ -915,13 +1243,57 @@ void osl_scop_normalize_scattering(osl_scop* scop) {
     // Normalize.
     statement = scop->statement;
     while (statement) {
-      if (statement->scattering) {
-        osl_relation* const extended = osl_relation_extend_output(
-            statement->scattering, max_scattering_dims);
-        osl_relation_free(statement->scattering);
-        statement->scattering = extended;
-      }
+      osl_relation_extend_output_inplace(statement->scattering,
+                                         max_scattering_dims);
       statement = statement->next;
     }
   }
 }
+
+/**
+ * osl_scop_normalize_scattering_all function:
+ * this function normalizes the scattering functions of every scop of a scop
+ * list (see osl_scop_normalize_scattering), each scop independently.
+ * \param[in,out] scop The scop list to nomalize the scattering functions.
+ */
+void osl_scop_normalize_scattering_all(osl_scop* scop) {
+  for (; scop; scop = scop->next)
+    osl_scop_normalize_scattering(scop);
+}
+
+/**
+ * osl_scop_enable_print_cache function:
+ * this function enables the print cache of the statements of every scop of
+ * a scop list (see osl_statement_enable_print_cache): printing the scops
+ * again only formats the statements which changed in between. The
+ * statements added later have no cache unless this function is called
+ * again.
+ * \param[in,out] scop The scop list to enable the print cache of.
+ */
+void osl_scop_enable_print_cache(osl_scop* scop) {
+  for (; scop; scop = scop->next)
+    osl_statement_enable_print_cache(scop->statement);
+}
+
+/**
+ * osl_scop_resolve_dependences function:
+ * this function fills the statement and access pointers of the dependences
+ * of every scop of a scop list (see osl_dependence_resolve), in time linear
+ * in the number of dependences, statements and accesses. It is meant to be
+ * called once after reading, instead of searching the statement and the
+ * access of each dependence.
+ * \param[in,out] scop The scop list whose dependences are resolved.
+ * \return The number of dependences which are not fully resolved.
+ */
+int osl_scop_resolve_dependences(osl_scop* scop) {
+  int nb_unresolved = 0;
+
+  for (; scop; scop = scop->next) {
+    osl_dependence* const dependence =
+        osl_scop_extension_lookup(scop, OSL_URI_DEPENDENCE);
+    if (dependence)
+      nb_unresolved += osl_dependence_resolve(dependence, scop);
+  }
+
+  return nb_unresolved;
+}
@@ -59,9 +59,12 @@
  ******************************************************************************/
 
 #include <ctype.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <osl/body.h>
 #include <osl/generic.h>
@@ -77,6 +80,7 @@
 static osl_names* osl_statement_names(const osl_statement*);
 static void osl_statement_dispatch(osl_statement*, osl_relation_list*);
 static osl_relation* osl_relation_clone_one_safe(const osl_relation*);
+static bool osl_statement_equal_one(const osl_statement*, const osl_statement*);
 
 /******************************************************************************
  *                         Structure display functions                        *
@@ -170,6 +174,213 @@ osl_names* osl_statement_names(const osl_statement* const statement) {
                             nb_scattdims, "l", nb_localdims, "A", array_id);
 }
 
+/**
+ * osl_statement_spprint_one function:
+ * this function pretty-prints the content of a single statement (the next
+ * statements of the list are ignored) into a string in the OpenScop format
+ * and returns this string. It does not modify the names, so it may be
+ * called concurrently for several statements with the same names.
+ * \param[in] statement The statement whose information has to be printed.
+ * \param[in] names     The names of the constraint columns for comments.
+ * \param[in] number    The number of the statement in the list.
+ * \return A string containing the OpenScop text of the statement.
+ */
+static char* osl_statement_spprint_one(const osl_statement* const statement,
+                                       const osl_names* const names,
+                                       const int number) {
+  size_t high_water_mark = OSL_MAX_STRING;
+  char* string = NULL;
+  char buffer[OSL_MAX_STRING];
+  char* part;
+
+  OSL_probe1(statement__print__start, number);
+  OSL_malloc(string, char*, high_water_mark * sizeof(char));
+  string[0] = '\0';
+
+  // If possible, replace iterator names with statement iterator names.
+  osl_names local_names = *names;
+  const osl_body* const body =
+      osl_generic_lookup(statement->extension, OSL_URI_BODY);
+  if (body && body->iterators)
+    local_names.iterators = body->iterators;
+
+  size_t nb_relations = 0;
+  if (statement->domain)
+    nb_relations++;
+  if (statement->scattering)
+    nb_relations++;
+  nb_relations += osl_relation_list_count(statement->access);
+
+  snprintf(buffer, OSL_MAX_STRING,
+           "# =============================================== "
+           "Statement %d\n"
+           "# Number of relations describing the statement:\n"
+           "%lu\n\n"
+           "# ---------------------------------------------- "
+           "%2d.1 Domain\n",
+           number, nb_relations, number);
+  osl_util_safe_strcat(&string, buffer, &high_water_mark);
+  part = osl_relation_spprint(statement->domain, &local_names);
+  osl_util_safe_strcat(&string, part, &high_water_mark);
+  osl_allocator_free(part);
+
+  snprintf(buffer, OSL_MAX_STRING,
+           "\n# ---------------------------------------------- "
+           "%2d.2 Scattering\n",
+           number);
+  osl_util_safe_strcat(&string, buffer, &high_water_mark);
+  part = osl_relation_spprint(statement->scattering, &local_names);
+  osl_util_safe_strcat(&string, part, &high_water_mark);
+  osl_allocator_free(part);
+
+  snprintf(buffer, OSL_MAX_STRING,
+           "\n# ---------------------------------------------- "
+           "%2d.3 Access\n",
+           number);
+  osl_util_safe_strcat(&string, buffer, &high_water_mark);
+  part = osl_relation_list_spprint_elts(statement->access, &local_names);
+  osl_util_safe_strcat(&string, part, &high_water_mark);
+  osl_allocator_free(part);
+
+  const int nb_ext = osl_generic_number(statement->extension);
+  snprintf(buffer, OSL_MAX_STRING,
+           "\n# ---------------------------------------------- "
+           "%2d.4 Statement Extensions\n"
+           "# Number of Statement Extensions\n"
+           "%d\n",
+           number, nb_ext);
+  osl_util_safe_strcat(&string, buffer, &high_water_mark);
+  if (nb_ext > 0) {
+    part = osl_generic_sprint(statement->extension);
+    if (part) {
+      osl_util_safe_strcat(&string, part, &high_water_mark);
+      osl_allocator_free(part);
+    }
+  }
+  osl_util_safe_strcat(&string, "\n", &high_water_mark);
+
+  OSL_probe2(statement__print__done, number, strlen(string));
+  return string;
+}
+
+/**
+ * osl_statement_stamp_mix function:
+ * this function mixes a value into a stamp (FNV-1a step).
+ * \param[in] stamp The stamp to update.
+ * \param[in] value The value to mix into the stamp.
+ * \return The updated stamp.
+ */
+static size_t osl_statement_stamp_mix(const size_t stamp, const size_t value) {
+  return (stamp ^ value) * (size_t)1099511628211ULL;
+}
+
+/**
+ * osl_statement_stamp_relation function:
+ * this function mixes the parts of a relation union (their modification
+ * counters) into a stamp.
+ * \param[in] stamp    The stamp to update.
+ * \param[in] relation The relation union to mix into the stamp.
+ * \return The updated stamp.
+ */
+static size_t osl_statement_stamp_relation(size_t stamp,
+                                           const osl_relation* relation) {
+  for (; relation; relation = relation->next)
+    stamp = osl_statement_stamp_mix(stamp, relation->generation);
+  return osl_statement_stamp_mix(stamp, 0);
+}
+
+/**
+ * osl_statement_stamp function:
+ * this function returns a stamp of the printed parts of a single statement:
+ * it changes when a part is replaced or added, when a relation is modified
+ * by the library (or marked with osl_relation_touch) and when the statement
+ * is marked with osl_statement_touch. It relies on the modification
+ * counters, which are unique in the process (see osl_util_generation), so
+ * a part freed then reallocated at the same address is detected as well.
+ * The content is not read, so that the stamp costs a few operations per
+ * relation.
+ * \param[in] statement The statement to stamp.
+ * \return The stamp of the statement.
+ */
+static size_t osl_statement_stamp(const osl_statement* const statement) {
+  size_t stamp = osl_statement_stamp_mix((size_t)2166136261U,
+                                         statement->generation);
+
+  stamp = osl_statement_stamp_relation(stamp, statement->domain);
+  stamp = osl_statement_stamp_relation(stamp, statement->scattering);
+  for (const osl_relation_list* l = statement->access; l; l = l->next)
+    stamp = osl_statement_stamp_relation(stamp, l->elt);
+  stamp = osl_statement_stamp_mix(stamp, 0);
+  for (const osl_generic* x = statement->extension; x; x = x->next) {
+    stamp = osl_statement_stamp_mix(stamp, x->generation);
+    stamp = osl_statement_stamp_mix(stamp, (uintptr_t)x->data);
+  }
+
+  return stamp;
+}
+
+/**
+ * osl_statement_names_stamp function:
+ * this function returns a stamp of the content of a set of names.
+ * \param[in] names The names to stamp.
+ * \return The stamp of the names.
+ */
+static size_t osl_statement_names_stamp(const osl_names* const names) {
+  const osl_strings* const strings[] = {names->parameters, names->iterators,
+                                        names->scatt_dims, names->local_dims,
+                                        names->arrays};
+  size_t stamp = (size_t)2166136261U;
+
+  for (size_t i = 0; i < sizeof(strings) / sizeof(*strings); i++) {
+    stamp = osl_statement_stamp_mix(stamp, i);
+    if (strings[i] && strings[i]->string)
+      for (char** string = strings[i]->string; *string; string++)
+        stamp = osl_statement_stamp_mix(stamp, osl_util_hash(*string));
+  }
+
+  return stamp;
+}
+
+/**
+ * osl_statement_text function:
+ * this function returns the OpenScop text of a single statement (see
+ * osl_statement_spprint_one). When the print cache of the statement is
+ * enabled, the cached text is returned if the statement, its number and
+ * the names did not change since it has been cached, otherwise the new
+ * text is cached. Distinct statements may be processed concurrently.
+ * \param[in]  statement   The statement whose text is required.
+ * \param[in]  names       The names of the constraint columns for comments.
+ * \param[in]  names_stamp The stamp of the names.
+ * \param[in]  number      The number of the statement in the list.
+ * \param[out] owned       Set to the returned text if the caller has to free
+ *                         it, to NULL if it belongs to the cache.
+ * \return The OpenScop text of the statement.
+ */
+static const char* osl_statement_text(const osl_statement* const statement,
+                                      const osl_names* const names,
+                                      const size_t names_stamp,
+                                      const int number, char** const owned) {
+  osl_statement_print_cache* const cache = statement->print_cache;
+
+  *owned = NULL;
+  if (!cache) {
+    *owned = osl_statement_spprint_one(statement, names, number);
+    return *owned;
+  }
+
+  const size_t stamp = osl_statement_stamp(statement);
+  if (!cache->text || (cache->number != number) ||
+      (cache->names != names_stamp) || (cache->stamp != stamp)) {
+    osl_allocator_free(cache->text);
+    cache->text = osl_statement_spprint_one(statement, names, number);
+    OSL_realloc(cache->text, char*, strlen(cache->text) + 1);
+    cache->number = number;
+    cache->names = names_stamp;
+    cache->stamp = stamp;
+  }
+  return cache->text;
+}
+
 /**
  * osl_statement_pprint function:
  * this function pretty-prints the content of an osl_statement structure
@@ -180,75 +391,233 @@ osl_names* osl_statement_names(const osl_statement* const statement) {
  */
 void osl_statement_pprint(FILE* const file, const osl_statement* statement,
                           const osl_names* const input_names) {
-  // Generate the dimension names if necessary and replace iterators with
-  // statement iterators if possible.
-  osl_names* const names = input_names ? osl_names_clone(input_names)
-                                       : osl_statement_names(statement);
+  osl_statement_pprint_parallel(file, statement, input_names, 1);
+}
 
-  int number = 1;
-  while (statement) {
-    bool iterators_backedup = false;
-    osl_strings* iterators_backup = NULL;
+/**
+ * osl_statement_nb_threads function:
+ * this function returns the number of threads to use for a requested number
+ * of threads: the number of online processors if it is not positive. It is
+ * at most the number of work items and OSL_STATEMENT_MAX_THREADS.
+ * \param[in] nb_threads The requested number of threads.
+ * \param[in] size       The number of work items.
+ * \return The number of threads to use (at least 1).
+ */
+static int osl_statement_nb_threads(int nb_threads, const size_t size) {
+  if (nb_threads <= 0) {
+    const long nb_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    nb_threads = (nb_processors > 0) ? (int)nb_processors : 1;
+  }
+  if (nb_threads > OSL_STATEMENT_MAX_THREADS)
+    nb_threads = OSL_STATEMENT_MAX_THREADS;
+  if ((size_t)nb_threads > size)
+    nb_threads = (size > 0) ? (int)size : 1;
+  return nb_threads;
+}
 
-    // If possible, replace iterator names with statement iterator names.
-    osl_body* const body =
-        osl_generic_lookup(statement->extension, OSL_URI_BODY);
-    if (body && body->iterators) {
-      iterators_backedup = true;
-      iterators_backup = names->iterators;
-      names->iterators = body->iterators;
-    }
+/**
+ * Pool of helper threads shared by the parallel functions: the helpers are
+ * started on demand, never exit and wait for the next run between two runs.
+ * A run is done by the calling thread and by nb_wanted helpers. A run which
+ * finds the pool busy (parallel functions called by several threads at once)
+ * is done by the calling thread alone.
+ */
+static struct osl_statement_pool {
+  pthread_mutex_t mutex;   /**< Protects the pool */
+  pthread_cond_t posted;   /**< Signaled when a run is posted */
+  pthread_cond_t finished; /**< Signaled when the last helper of a run ends */
+  void* (*worker)(void*);  /**< Body of the current run */
+  void* work;              /**< Work of the current run */
+  int nb_helpers;          /**< Number of started helpers */
+  int nb_wanted;           /**< Number of helpers still to join the run */
+  int nb_running;          /**< Number of helpers not done with the run */
+  bool busy;               /**< A run uses the helpers */
+} osl_statement_pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                        PTHREAD_COND_INITIALIZER, NULL, NULL, 0, 0, 0, false};
 
-    fprintf(file, "# =============================================== ");
-    fprintf(file, "Statement %d\n", number);
+/**
+ * osl_statement_pool_helper function (internal function):
+ * this function is the body of the helpers of the thread pool: it waits for
+ * a run, takes part in it, and waits for the next one.
+ * \param[in] data Unused.
+ * \return Never returns.
+ */
+static void* osl_statement_pool_helper(void* const data) {
+  struct osl_statement_pool* const pool = &osl_statement_pool;
+  (void)data;
+
+  pthread_mutex_lock(&pool->mutex);
+  for (;;) {
+    while (pool->nb_wanted == 0)
+      pthread_cond_wait(&pool->posted, &pool->mutex);
+    pool->nb_wanted--;
+    void* (*const worker)(void*) = pool->worker;
+    void* const work = pool->work;
+    pthread_mutex_unlock(&pool->mutex);
+
+    worker(work);
+
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->nb_running == 0)
+      pthread_cond_signal(&pool->finished);
+  }
+  return NULL;
+}
 
-    fprintf(file, "# Number of relations describing the statement:\n");
+/**
+ * osl_statement_run_parallel function:
+ * this function runs a worker on a shared work with up to nb_threads threads
+ * (the calling thread and helpers of the thread pool, with no more threads
+ * than work items), and returns when every worker returned. The helpers are
+ * started by the first runs which need them and reused by the next ones.
+ * \param[in]     worker     The body of the threads.
+ * \param[in,out] work       The work shared by the threads.
+ * \param[in]     size       The number of work items.
+ * \param[in]     nb_threads The number of threads to use (at least 1 and at
+ *                           most OSL_STATEMENT_MAX_THREADS).
+ */
+static void osl_statement_run_parallel(void* (*worker)(void*), void* const work,
+                                       const size_t size,
+                                       const int nb_threads) {
+  struct osl_statement_pool* const pool = &osl_statement_pool;
+  int nb_helpers = ((size_t)nb_threads < size) ? nb_threads - 1
+                                               : (int)size - 1;
+
+  pthread_mutex_lock(&pool->mutex);
+  if (pool->busy || (nb_helpers < 1)) {
+    nb_helpers = 0;
+  } else {
+    while (pool->nb_helpers < nb_helpers) {
+      pthread_t thread;
+      if (pthread_create(&thread, NULL, osl_statement_pool_helper, NULL))
+        break;
+      pthread_detach(thread);
+      pool->nb_helpers++;
+    }
+    if (nb_helpers > pool->nb_helpers)
+      nb_helpers = pool->nb_helpers;
+    pool->worker = worker;
+    pool->work = work;
+    pool->nb_wanted = nb_helpers;
+    pool->nb_running = nb_helpers;
+    pool->busy = (nb_helpers > 0);
+    pthread_cond_broadcast(&pool->posted);
+  }
+  pthread_mutex_unlock(&pool->mutex);
 
-    size_t nb_relations = 0;
-    if (statement->domain)
-      nb_relations++;
-    if (statement->scattering)
-      nb_relations++;
-    nb_relations += osl_relation_list_count(statement->access);
+  worker(work);
 
-    fprintf(file, "%lu\n\n", nb_relations);
+  if (nb_helpers > 0) {
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->nb_running > 0)
+      pthread_cond_wait(&pool->finished, &pool->mutex);
+    pool->busy = false;
+    pthread_mutex_unlock(&pool->mutex);
+  }
+}
 
-    fprintf(file, "# ---------------------------------------------- ");
-    fprintf(file, "%2d.1 Domain\n", number);
-    osl_relation_pprint(file, statement->domain, names);
-    fprintf(file, "\n");
+/**
+ * Work shared by the threads of osl_statement_pprint_parallel: each thread
+ * takes the next statement to print and stores its text at its position.
+ */
+struct osl_statement_print_work {
+  const osl_statement** statement; /**< Statements to print */
+  const char** text;               /**< Text of each statement */
+  char** owned;                    /**< Texts to free (NULL if cached) */
+  const osl_names* names;          /**< Names of the constraint columns */
+  size_t names_stamp;              /**< Stamp of the names */
+  int first_number;                /**< Number of the first statement */
+  size_t size;                     /**< Number of statements to print */
+  size_t next;                     /**< Next statement to print */
+};
 
-    fprintf(file, "# ---------------------------------------------- ");
-    fprintf(file, "%2d.2 Scattering\n", number);
-    osl_relation_pprint(file, statement->scattering, names);
-    fprintf(file, "\n");
+/**
+ * osl_statement_print_worker function:
+ * this function is the body of the threads of osl_statement_pprint_parallel:
+ * it prints statements until there is no statement left in the work.
+ * \param[in,out] data The shared work (struct osl_statement_print_work).
+ * \return NULL.
+ */
+static void* osl_statement_print_worker(void* const data) {
+  struct osl_statement_print_work* const work = data;
+  size_t i;
+
+  while ((i = __atomic_fetch_add(&work->next, 1, __ATOMIC_RELAXED)) <
+         work->size) {
+    work->text[i] = osl_statement_text(work->statement[i], work->names,
+                                       work->names_stamp,
+                                       work->first_number + (int)i,
+                                       &work->owned[i]);
+  }
+  return NULL;
+}
 
-    fprintf(file, "# ---------------------------------------------- ");
-    fprintf(file, "%2d.3 Access\n", number);
-    osl_relation_list_pprint_elts(file, statement->access, names);
-    fprintf(file, "\n");
+/**
+ * osl_statement_pprint_parallel function:
+ * this function is equivalent to osl_statement_pprint() except that the
+ * statements are formatted concurrently by a pool of threads, then written
+ * in order: the output is identical to the one of osl_statement_pprint().
+ * The statements are processed by batches of OSL_STATEMENT_PRINT_BATCH to
+ * bound the memory used by the pending texts. The statements with an
+ * enabled print cache (see osl_statement_enable_print_cache) are formatted
+ * only if they changed since their previous print.
+ * \param[in] file       The file where the information has to be printed.
+ * \param[in] statement  The statement list to print.
+ * \param[in] names      The names of the constraint columns for comments.
+ * \param[in] nb_threads The number of threads to use (the number of online
+ *                       processors if it is not positive).
+ */
+void osl_statement_pprint_parallel(FILE* const file,
+                                   const osl_statement* statement,
+                                   const osl_names* const input_names,
+                                   int nb_threads) {
+  // Generate the dimension names (with a column cache) if necessary.
+  osl_names* const generated_names =
+      input_names ? NULL : osl_statement_names(statement);
+  if (generated_names)
+    osl_names_enable_cache(generated_names);
+  const osl_names* const names = input_names ? input_names : generated_names;
+  const size_t names_stamp = osl_statement_names_stamp(names);
+
+  nb_threads = osl_statement_nb_threads(nb_threads, OSL_STATEMENT_PRINT_BATCH);
 
-    fprintf(file, "# ---------------------------------------------- ");
-    fprintf(file, "%2d.4 Statement Extensions\n", number);
-    fprintf(file, "# Number of Statement Extensions\n");
-    int nb_ext = osl_generic_number(statement->extension);
-    fprintf(file, "%d\n", nb_ext);
-    if (nb_ext > 0)
-      osl_generic_print(file, statement->extension);
+  int number = 1;
+  if (nb_threads == 1) {
+    while (statement) {
+      char* owned;
+      fprintf(file, "%s",
+              osl_statement_text(statement, names, names_stamp, number,
+                                 &owned));
+      osl_allocator_free(owned);
+      statement = statement->next;
+      number++;
+    }
+    osl_names_free(generated_names);
+    return;
+  }
 
-    fprintf(file, "\n");
+  const osl_statement* batch[OSL_STATEMENT_PRINT_BATCH];
+  const char* text[OSL_STATEMENT_PRINT_BATCH];
+  char* owned[OSL_STATEMENT_PRINT_BATCH];
 
-    // If necessary, switch back iterator names.
-    if (iterators_backedup) {
-      iterators_backedup = false;
-      names->iterators = iterators_backup;
+  while (statement) {
+    struct osl_statement_print_work work = {
+        batch, text, owned, names, names_stamp, number, 0, 0};
+    for (; statement && work.size < OSL_STATEMENT_PRINT_BATCH;
+         statement = statement->next)
+      batch[work.size++] = statement;
+
+    osl_statement_run_parallel(osl_statement_print_worker, &work, work.size,
+                               nb_threads);
+
+    for (size_t i = 0; i < work.size; i++) {
+      fprintf(file, "%s", text[i]);
+      osl_allocator_free(owned[i]);
     }
-
-    statement = statement->next;
-    number++;
+    number += (int)work.size;
   }
 
-  osl_names_free(names);
+  osl_names_free(generated_names);
 }
 
 /**
@@ -364,8 +733,10 @@ void osl_statement_dispatch(osl_statement* const stmt,
   osl_relation_list* const domain_list =
       osl_relation_list_filter(list, OSL_TYPE_DOMAIN);
   const size_t nb_domains = osl_relation_list_count(domain_list);
-  if (nb_domains > 1)
+  if (nb_domains > 1) {
+    osl_relation_list_free(domain_list);
     OSL_error("more than one domain for a statement");
+  }
 
   if (domain_list) {
     stmt->domain = domain_list->elt;
@@ -379,8 +750,10 @@ void osl_statement_dispatch(osl_statement* const stmt,
   osl_relation_list* const scattering_list =
       osl_relation_list_filter(list, OSL_TYPE_SCATTERING);
   const size_t nb_scattering = osl_relation_list_count(scattering_list);
-  if (nb_scattering > 1)
+  if (nb_scattering > 1) {
+    osl_relation_list_free(scattering_list);
     OSL_error("more than one scattering relation for a statement");
+  }
 
   if (scattering_list) {
     stmt->scattering = scattering_list->elt;
@@ -413,23 +786,37 @@ void osl_statement_dispatch(osl_statement* const stmt,
 osl_statement* osl_statement_pread(FILE* const file,
                                    osl_interface* const registry,
                                    const int precision) {
+  osl_perf_mark mark;
+  OSL_perf_begin(&mark);
+  OSL_probe1(statement__read__start, precision);
+
   osl_statement* const stmt = osl_statement_malloc();
+  osl_error_protect(stmt, (osl_error_cleanup_f)osl_statement_free);
 
   if (file) {
     // Read all statement relations.
     osl_relation_list* const list = osl_relation_list_pread(file, precision);
 
     // Store relations at the right place according to their type.
+    osl_error_protect(list, (osl_error_cleanup_f)osl_relation_list_free);
     osl_statement_dispatch(stmt, list);
+    osl_error_unprotect(list);
 
     // Read the Extensions
     const int nb_ext = osl_util_read_int(file, NULL);
     for (int i = 0; i < nb_ext; i++) {
       osl_generic* const new = osl_generic_read_one(file, registry);
+      osl_error_protect(new, (osl_error_cleanup_f)osl_generic_free);
       osl_generic_add(&stmt->extension, new);
+      osl_error_unprotect(new);
     }
   }
 
+  osl_error_unprotect(stmt);
+  OSL_probe3(statement__read__done, stmt->domain ? stmt->domain->nb_rows : 0,
+             stmt->domain ? stmt->domain->nb_columns : 0,
+             osl_generic_number(stmt->extension));
+  OSL_perf_end(OSL_PERF_STATEMENT_READ, &mark);
   return stmt;
 }
 
@@ -451,6 +838,50 @@ osl_statement* osl_statement_read(FILE* const foo) {
   return statement;
 }
 
+/**
+ * Arguments and result of osl_statement_pread when run by
+ * osl_statement_pread_try.
+ */
+struct osl_statement_pread_args {
+  FILE* file;
+  osl_interface* registry;
+  int precision;
+  osl_statement* statement;
+};
+
+/**
+ * osl_statement_pread_body function:
+ * this function runs osl_statement_pread on behalf of
+ * osl_statement_pread_try.
+ * \param[in,out] data The arguments and result of osl_statement_pread.
+ */
+static void osl_statement_pread_body(void* const data) {
+  struct osl_statement_pread_args* const args = data;
+  args->statement =
+      osl_statement_pread(args->file, args->registry, args->precision);
+}
+
+/**
+ * osl_statement_pread_try function:
+ * this function is equivalent to osl_statement_pread() except that errors
+ * do not exit the program: the partially read statement is freed and the
+ * function fails (see osl_error_try).
+ * \param[in]  file      The input stream.
+ * \param[in]  registry  The list of known interfaces (others are ignored).
+ * \param[in]  precision The precision of the relation elements.
+ * \param[out] statement The statement that has been read (NULL on error).
+ * \return true if the statement has been read, false if an error occurred.
+ */
+bool osl_statement_pread_try(FILE* const file, osl_interface* const registry,
+                             const int precision,
+                             osl_statement** const statement) {
+  struct osl_statement_pread_args args = {file, registry, precision, NULL};
+  const bool success = osl_error_try(osl_statement_pread_body, &args);
+
+  *statement = args.statement;
+  return success;
+}
+
 /******************************************************************************
  *                   Memory allocation/deallocation functions                 *
  ******************************************************************************/
@@ -470,6 +901,10 @@ osl_statement* osl_statement_malloc(void) {
   statement->scattering = NULL;
   statement->access = NULL;
   statement->extension = NULL;
+  statement->extension_index = NULL;
+  statement->generation = osl_util_generation();
+  statement->list_generation = statement->generation;
+  statement->print_cache = NULL;
   statement->next = NULL;
 
   return statement;
@@ -490,12 +925,52 @@ void osl_statement_free(osl_statement* statement) {
     osl_relation_free(statement->scattering);
     osl_relation_list_free(statement->access);
     osl_generic_free(statement->extension);
+    osl_generic_index_free(statement->extension_index);
+    if (statement->print_cache) {
+      osl_allocator_free(statement->print_cache->text);
+      osl_allocator_free(statement->print_cache);
+    }
 
-    free(statement);
+    osl_allocator_free(statement);
     statement = next;
   }
 }
 
+/**
+ * osl_statement_index_build function:
+ * this function builds an array index over a statement list (see the
+ * osl_statement_index structure).
+ * \param[in] list The statement list to index.
+ * \return A pointer to the index of the list.
+ */
+osl_statement_index* osl_statement_index_build(
+    const osl_statement* const list) {
+  osl_statement_index* index;
+
+  OSL_malloc(index, osl_statement_index*, sizeof(osl_statement_index));
+  index->list = list;
+  index->generation = list ? list->list_generation : 0;
+  index->statement = NULL;
+  index->size = 0;
+  index->capacity = 0;
+  osl_statement_index_add(index, (osl_statement*)list);
+
+  return index;
+}
+
+/**
+ * osl_statement_index_free function:
+ * this function frees the allocated memory for a statement index. The
+ * indexed statement list is left untouched.
+ * \param[in] index The pointer to the index we want to free.
+ */
+void osl_statement_index_free(osl_statement_index* const index) {
+  if (index) {
+    osl_allocator_free(index->statement);
+    osl_allocator_free(index);
+  }
+}
+
 /******************************************************************************
  *                            Processing functions                            *
  ******************************************************************************/
@@ -503,15 +978,137 @@ void osl_statement_free(osl_statement* statement) {
 /**
  * osl_statement_add function:
  * this function adds a statement "statement" at the end of the statement
- * list pointed by "location".
+ * list pointed by "location", and stamps the change on the head of the list
+ * so that the indexes built over it are outdated (see
+ * osl_statement_index_is_valid).
  * \param[in,out] location  Address of the first element of the statement list.
  * \param[in]     statement The statement to add to the list.
  */
 void osl_statement_add(osl_statement** location, osl_statement* statement) {
+  osl_statement* const head = *location;
+
   while (*location)
     location = &((*location)->next);
 
   *location = statement;
+  if (head)
+    head->list_generation = osl_util_generation();
+}
+
+/**
+ * osl_statement_touch function:
+ * this function marks a single statement as modified, so that the text
+ * cached for it is not used anymore (see osl_statement_enable_print_cache).
+ * It is necessary after a direct modification of a relation (see
+ * osl_relation_touch) or of an extension of the statement, the library
+ * functions and the replacement of a part being detected. It also marks the
+ * list headed by the statement as modified, which is necessary after a
+ * direct modification of the list (see osl_statement_index_is_valid).
+ * \param[in,out] statement The statement to mark as modified.
+ */
+void osl_statement_touch(osl_statement* const statement) {
+  if (statement) {
+    statement->generation = osl_util_generation();
+    statement->list_generation = statement->generation;
+  }
+}
+
+/**
+ * osl_statement_enable_print_cache function:
+ * this function enables the print cache of each statement of a list: the
+ * text of such a statement is kept when it is printed, and printed again
+ * as long as the statement did not change (and neither its number nor the
+ * column names). The library detects the modifications through its own
+ * functions and the replacement of a statement part; the other ones (direct
+ * modifications of the fields, of the matrix elements or of the extension
+ * data) must be signaled with osl_statement_touch or osl_relation_touch.
+ * Printing a statement list with print caches modifies the caches: the
+ * same list must not be printed concurrently.
+ * \param[in,out] statement The statement list to enable the cache of.
+ */
+void osl_statement_enable_print_cache(osl_statement* statement) {
+  for (; statement; statement = statement->next) {
+    if (!statement->print_cache) {
+      osl_statement_print_cache* cache;
+      OSL_malloc(cache, osl_statement_print_cache*,
+                 sizeof(osl_statement_print_cache));
+      cache->text = NULL;
+      cache->number = 0;
+      cache->names = 0;
+      cache->stamp = 0;
+      statement->print_cache = cache;
+    }
+  }
+}
+
+/**
+ * osl_statement_index_add function:
+ * this function adds the statements of a list to the end of a statement
+ * index. The statements must have been linked at the end of the indexed list
+ * (or be the indexed list if the index is empty) to keep the index valid.
+ * The list is marked as modified, hence its other indexes are outdated.
+ * \param[in,out] index     The index to update.
+ * \param[in]     statement The statement list which has been appended.
+ */
+void osl_statement_index_add(osl_statement_index* const index,
+                             osl_statement* statement) {
+  if (index->size == 0)
+    index->list = statement;
+
+  for (; statement; statement = statement->next) {
+    if (index->size == index->capacity) {
+      index->capacity = index->capacity ? 2 * index->capacity : 16;
+      OSL_realloc(index->statement, osl_statement**,
+                  index->capacity * sizeof(osl_statement*));
+    }
+    index->statement[index->size++] = statement;
+  }
+
+  // Outdate the other indexes of the list, this one stays up to date.
+  if (index->size) {
+    index->statement[0]->list_generation = osl_util_generation();
+    index->generation = index->statement[0]->list_generation;
+  }
+}
+
+/**
+ * osl_statement_index_is_valid function:
+ * this function returns true if a statement index is up to date with a
+ * statement list, i.e., if it has been built from this list and the list has
+ * not changed since, false otherwise. The changes are detected through the
+ * stamp of the head of the list, set by osl_statement_add and
+ * osl_statement_touch: a direct modification of the list (removing,
+ * inserting or reordering statements) must be followed by
+ * osl_statement_touch on its head. Only the head of the list is read, not
+ * the indexed statements which may have been freed. It runs in constant
+ * time.
+ * \param[in] index The statement index.
+ * \param[in] list  The statement list.
+ * \return true if the index is up to date with the list, false otherwise.
+ */
+bool osl_statement_index_is_valid(const osl_statement_index* const index,
+                                  const osl_statement* const list) {
+  if (index->list != list)
+    return false;
+
+  return (list == NULL) || (list->list_generation == index->generation);
+}
+
+/**
+ * osl_statement_index_get function:
+ * this function returns the statement at a given position (from 0) of an
+ * indexed statement list, in constant time, or NULL if there is no such
+ * position. The index must be up to date (see osl_statement_index_is_valid).
+ * \param[in] index    The statement index.
+ * \param[in] position The position of the statement in the list.
+ * \return The statement at the given position, NULL if there is none.
+ */
+osl_statement* osl_statement_index_get(const osl_statement_index* const index,
+                                       const int position) {
+  if ((position < 0) || ((size_t)position >= index->size))
+    return NULL;
+
+  return index->statement[position];
 }
 
 /**
@@ -531,6 +1128,24 @@ int osl_statement_number(const osl_statement* statement) {
   return number;
 }
 
+/**
+ * osl_statement_clone_one function:
+ * this function builds and returns a "hard copy" of a statement alone (the
+ * statements following it in the list are not cloned).
+ * \param[in] statement The statement to clone.
+ * \return A clone of the statement, with no next statement.
+ */
+static osl_statement* osl_statement_clone_one(
+    const osl_statement* const statement) {
+  osl_statement* const node = osl_statement_malloc();
+  node->domain = osl_relation_clone(statement->domain);
+  node->scattering = osl_relation_clone(statement->scattering);
+  node->access = osl_relation_list_clone(statement->access);
+  node->extension = osl_generic_clone(statement->extension);
+  node->next = NULL;
+  return node;
+}
+
 /**
  * osl_statement_nclone function:
  * This function builds and returns a "hard copy" (not a pointer copy) of the
@@ -546,12 +1161,7 @@ osl_statement* osl_statement_nclone(const osl_statement* statement, int n) {
 
   bool first = true;
   while ((statement) && ((n == -1) || (i < n))) {
-    osl_statement* const node = osl_statement_malloc();
-    node->domain = osl_relation_clone(statement->domain);
-    node->scattering = osl_relation_clone(statement->scattering);
-    node->access = osl_relation_list_clone(statement->access);
-    node->extension = osl_generic_clone(statement->extension);
-    node->next = NULL;
+    osl_statement* const node = osl_statement_clone_one(statement);
 
     if (first) {
       first = false;
@@ -580,6 +1190,89 @@ osl_statement* osl_statement_clone(const osl_statement* const statement) {
   return osl_statement_nclone(statement, -1);
 }
 
+/**
+ * Work shared by the threads of osl_statement_clone_parallel and
+ * osl_statement_equal_parallel: each thread takes the next statement (or
+ * pair of statements) to clone (or to compare).
+ */
+struct osl_statement_parallel_work {
+  const osl_statement** s1; /**< Statements to clone or to compare */
+  const osl_statement** s2; /**< Statements to compare with (equal only) */
+  osl_statement** clone;    /**< Clone of each statement (clone only) */
+  size_t size;              /**< Number of statements */
+  size_t next;              /**< Next statement to process */
+  bool different;           /**< A difference has been found (equal only) */
+};
+
+/**
+ * osl_statement_parallel_array function:
+ * this function returns an array of the statements of a statement list.
+ * \param[in] statement The statement list.
+ * \param[in] size      The number of statements of the list.
+ * \return The array of the statements, to free with osl_allocator_free.
+ */
+static const osl_statement** osl_statement_parallel_array(
+    const osl_statement* statement, const size_t size) {
+  const osl_statement** array;
+  OSL_malloc(array, const osl_statement**,
+             (size ? size : 1) * sizeof(osl_statement*));
+  for (size_t i = 0; i < size; i++, statement = statement->next)
+    array[i] = statement;
+  return array;
+}
+
+/**
+ * osl_statement_clone_worker function:
+ * this function is the body of the threads of osl_statement_clone_parallel:
+ * it clones statements until there is no statement left in the work.
+ * \param[in,out] data The shared work (struct osl_statement_parallel_work).
+ * \return NULL.
+ */
+static void* osl_statement_clone_worker(void* const data) {
+  struct osl_statement_parallel_work* const work = data;
+  size_t i;
+
+  while ((i = __atomic_fetch_add(&work->next, 1, __ATOMIC_RELAXED)) <
+         work->size)
+    work->clone[i] = osl_statement_clone_one(work->s1[i]);
+  return NULL;
+}
+
+/**
+ * osl_statement_clone_parallel function:
+ * this function is equivalent to osl_statement_clone() except that the
+ * statements are cloned concurrently by a pool of threads. The result is the
+ * same linked list as the one of osl_statement_clone().
+ * \param[in] statement  The statement list to clone.
+ * \param[in] nb_threads The number of threads to use (the number of online
+ *                       processors if it is not positive).
+ * \return A pointer to the clone of the statement list.
+ */
+osl_statement* osl_statement_clone_parallel(const osl_statement* statement,
+                                            int nb_threads) {
+  const size_t size = (size_t)osl_statement_number(statement);
+  nb_threads = osl_statement_nb_threads(nb_threads, size);
+  if ((nb_threads == 1) || (size < 2))
+    return osl_statement_clone(statement);
+
+  struct osl_statement_parallel_work work;
+  work.s1 = osl_statement_parallel_array(statement, size);
+  work.s2 = NULL;
+  OSL_malloc(work.clone, osl_statement**, size * sizeof(osl_statement*));
+  work.size = size;
+  work.next = 0;
+  work.different = false;
+  osl_statement_run_parallel(osl_statement_clone_worker, &work, size,
+                             nb_threads);
+
+  for (size_t i = 0; i + 1 < size; i++)
+    work.clone[i]->next = work.clone[i + 1];
+  osl_statement* const clone = work.clone[0];
+  osl_allocator_free(work.s1);
+  osl_allocator_free(work.clone);
+  return clone;
+}
+
 /// Clone first part of the union, return NULL if input is NULL.
 osl_relation* osl_relation_clone_one_safe(const osl_relation* const relation) {
   if (!relation)
@@ -594,7 +1287,9 @@ osl_relation* osl_relation_clone_one_safe(const osl_relation* const relation) {
  * and keeps the original statement intact.  Each new statement has exactly one
  * domain union component and exactly one scattering union component.  If the
  * statement does not have the domain relation or the scattering relation, this
- * function returns \c NULL.
+ * function returns \c NULL. The access list and the extensions are copied for
+ * each new statement: osl_statement_union_iterator_next gives the same
+ * statements without any copy.
  * \param[in] statement A pointer to the statement
  * \return    A pointer to the head of the newly created statement list.
  */
@@ -635,6 +1330,80 @@ osl_statement* osl_statement_remove_unions(
   return result;
 }
 
+/**
+ * osl_statement_union_iterator_init function:
+ * this function initializes an iterator over the union-free instances of a
+ * statement list (see osl_statement_union_iterator), which are then given by
+ * osl_statement_union_iterator_next. It is the lazy alternative to
+ * osl_statement_remove_unions: the instances share their data with the
+ * statements, which must not be modified or freed while iterating.
+ * \param[out] iterator  The iterator to initialize.
+ * \param[in]  statement The statement list to iterate over.
+ */
+void osl_statement_union_iterator_init(
+    osl_statement_union_iterator* const iterator,
+    const osl_statement* const statement) {
+  iterator->origin = NULL;
+  iterator->statement = statement;
+  iterator->domain = statement ? statement->domain : NULL;
+  iterator->scattering = statement ? statement->scattering : NULL;
+}
+
+/**
+ * osl_statement_union_iterator_next function:
+ * this function returns the next union-free instance of the statement list
+ * of an iterator, or NULL if there is no instance left. Each statement gives
+ * at least one instance, even if it has no domain or scattering. The
+ * returned statement has a single domain part, a single scattering part, no
+ * next statement, and shares the rest with the original statement (given by
+ * the origin field of the iterator). It remains valid up to the next call.
+ * \param[in,out] iterator The iterator to advance.
+ * \return The next union-free statement instance, NULL if none.
+ */
+const osl_statement* osl_statement_union_iterator_next(
+    osl_statement_union_iterator* const iterator) {
+  const osl_statement* const statement = iterator->statement;
+  if (!statement)
+    return NULL;
+
+  // Build the view of the current (domain, scattering) combination.
+  osl_statement* const view = &iterator->view;
+  view->domain = NULL;
+  view->scattering = NULL;
+  if (iterator->domain) {
+    iterator->domain_part = *iterator->domain;
+    iterator->domain_part.next = NULL;
+    view->domain = &iterator->domain_part;
+  }
+  if (iterator->scattering) {
+    iterator->scattering_part = *iterator->scattering;
+    iterator->scattering_part.next = NULL;
+    view->scattering = &iterator->scattering_part;
+  }
+  view->access = statement->access;
+  view->extension = statement->extension;
+  view->extension_index = NULL;
+  view->generation = statement->generation;
+  view->list_generation = statement->generation;
+  view->print_cache = NULL;
+  view->usr = statement->usr;
+  view->next = NULL;
+  iterator->origin = statement;
+
+  // Move to the next combination, or to the next statement.
+  if (iterator->scattering && iterator->scattering->next) {
+    iterator->scattering = iterator->scattering->next;
+  } else if (iterator->domain && iterator->domain->next) {
+    iterator->domain = iterator->domain->next;
+    iterator->scattering = statement->scattering;
+  } else {
+    osl_statement_union_iterator_init(iterator, statement->next);
+    iterator->origin = statement;
+  }
+
+  return view;
+}
+
 /**
  * osl_statement_equal function:
  * this function returns true if the two statements provided as parameters
@@ -660,6 +1429,19 @@ bool osl_statement_equal(const osl_statement* const s1,
     }
   }
 
+  return osl_statement_equal_one(s1, s2);
+}
+
+/**
+ * osl_statement_equal_one function:
+ * this function returns true if two statements alone (not the statements
+ * following them in their lists) are the same, false otherwise.
+ * \param[in] s1 The first statement.
+ * \param[in] s2 The second statement.
+ * \return true if s1 and s2 are the same (content-wise), false otherwise.
+ */
+static bool osl_statement_equal_one(const osl_statement* const s1,
+                                    const osl_statement* const s2) {
   if (!osl_relation_equal(s1->domain, s2->domain)) {
     OSL_info("statement domains are not the same");
     return false;
@@ -683,6 +1465,98 @@ bool osl_statement_equal(const osl_statement* const s1,
   return true;
 }
 
+/**
+ * osl_statement_equal_worker function:
+ * this function is the body of the threads of osl_statement_equal_parallel:
+ * it compares pairs of statements until there is no pair left in the work or
+ * a difference has been found (by any thread).
+ * \param[in,out] data The shared work (struct osl_statement_parallel_work).
+ * \return NULL.
+ */
+static void* osl_statement_equal_worker(void* const data) {
+  struct osl_statement_parallel_work* const work = data;
+  size_t i;
+
+  while (!__atomic_load_n(&work->different, __ATOMIC_RELAXED) &&
+         ((i = __atomic_fetch_add(&work->next, 1, __ATOMIC_RELAXED)) <
+          work->size)) {
+    if (!osl_statement_equal_one(work->s1[i], work->s2[i]))
+      __atomic_store_n(&work->different, true, __ATOMIC_RELAXED);
+  }
+  return NULL;
+}
+
+/**
+ * osl_statement_equal_parallel function:
+ * this function is equivalent to osl_statement_equal() except that the
+ * pairs of statements are compared concurrently by a pool of threads, which
+ * all stop as soon as one of them finds a difference.
+ * \param[in] s1         The first statement list.
+ * \param[in] s2         The second statement list.
+ * \param[in] nb_threads The number of threads to use (the number of online
+ *                       processors if it is not positive).
+ * \return true if s1 and s2 are the same (content-wise), false otherwise.
+ */
+bool osl_statement_equal_parallel(const osl_statement* const s1,
+                                  const osl_statement* const s2,
+                                  int nb_threads) {
+  if (s1 == s2)
+    return true;
+
+  const size_t size = (size_t)osl_statement_number(s1);
+  if (size != (size_t)osl_statement_number(s2)) {
+    OSL_info("number of statements is not the same");
+    return false;
+  }
+
+  nb_threads = osl_statement_nb_threads(nb_threads, size);
+  if ((nb_threads == 1) || (size < 2))
+    return osl_statement_equal(s1, s2);
+
+  struct osl_statement_parallel_work work;
+  work.s1 = osl_statement_parallel_array(s1, size);
+  work.s2 = osl_statement_parallel_array(s2, size);
+  work.clone = NULL;
+  work.size = size;
+  work.next = 0;
+  work.different = false;
+  osl_statement_run_parallel(osl_statement_equal_worker, &work, size,
+                             nb_threads);
+
+  osl_allocator_free(work.s1);
+  osl_allocator_free(work.s2);
+  return !work.different;
+}
+
+/**
+ * osl_statement_memory_usage function:
+ * this function adds the memory footprint of a statement (its relations,
+ * extensions and lookup index) to a memory usage. Only the given statement
+ * is measured, not the statements following it in the list.
+ * \param[in]     statement The statement.
+ * \param[in,out] usage     The memory usage to update.
+ */
+void osl_statement_memory_usage(const osl_statement* const statement,
+                                osl_memory_usage* const usage) {
+  if (!statement)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_statement));
+  osl_relation_memory_usage(statement->domain, usage);
+  osl_relation_memory_usage(statement->scattering, usage);
+  osl_relation_list_memory_usage(statement->access, usage);
+  osl_generic_memory_usage(statement->extension, usage);
+  if (statement->extension_index)
+    osl_memory_usage_add(usage, &usage->indexes, sizeof(osl_generic_index));
+  if (statement->print_cache) {
+    osl_memory_usage_add(usage, &usage->structures,
+                         sizeof(osl_statement_print_cache));
+    if (statement->print_cache->text)
+      osl_memory_usage_add(usage, &usage->strings,
+                           strlen(statement->print_cache->text) + 1);
+  }
+}
+
 /**
  * osl_statement_integrity_check function:
  * this function checks that a statement is "well formed" according to some
@@ -826,3 +1700,36 @@ osl_body* osl_statement_get_body(const osl_statement* const statement) {
 
   return NULL;
 }
+
+/**
+ * osl_statement_extension_lookup function:
+ * this function returns the data of the extension with a given URI of a
+ * statement and NULL if there is no such extension. It relies on a lookup
+ * index which is built on the first call, hence it runs in constant time for
+ * the URIs of the default registry. It may be called concurrently on the
+ * same statement (see osl_generic_index_cached_lookup). After
+ * osl_generic_add or osl_generic_remove on the extension list, the lookups
+ * are linear until osl_statement_extension_invalidate is called. If the list
+ * is modified directly, osl_statement_extension_invalidate must be called
+ * before the next lookup.
+ * \param[in,out] statement The statement where to search a given URI.
+ * \param[in]     URI       The URI of the extension we are looking for.
+ * \return The data of the extension with the requested URI in the statement.
+ */
+void* osl_statement_extension_lookup(osl_statement* const statement,
+                                     const char* const URI) {
+  return osl_generic_index_cached_lookup(&statement->extension_index,
+                                         statement->extension, URI);
+}
+
+/**
+ * osl_statement_extension_invalidate function:
+ * this function drops the extension lookup index of a statement (see
+ * osl_statement_extension_lookup). It has to be called each time the
+ * extension list of the statement is modified directly.
+ * \param[in,out] statement The statement whose extension index is outdated.
+ */
+void osl_statement_extension_invalidate(osl_statement* const statement) {
+  osl_generic_index_free(statement->extension_index);
+  statement->extension_index = NULL;
+}
@@ -128,8 +128,7 @@ char* osl_strings_sprint(const osl_strings* strings) {
   if (strings) {
     size_t i;
     for (i = 0; i < osl_strings_size(strings); i++) {
-      sprintf(buffer, "%s", strings->string[i]);
-      osl_util_safe_strcat(&string, buffer, &high_water_mark);
+      osl_util_safe_strcat(&string, strings->string[i], &high_water_mark);
       if (i < osl_strings_size(strings) - 1)
         osl_util_safe_strcat(&string, " ", &high_water_mark);
     }
@@ -154,7 +153,7 @@ void osl_strings_print(FILE* const file, const osl_strings* const strings) {
   char* const string = osl_strings_sprint(strings);
   if (string) {
     fprintf(file, "%s", string);
-    free(string);
+    osl_allocator_free(string);
   }
 }
 
@@ -203,15 +202,16 @@ osl_strings* osl_strings_sread(char** const input) {
     OSL_malloc(string, char**, sizeof(char*) * (nb_strings + 1));
     string[nb_strings] = NULL;
 
-    // Read the desired number of strings.
+    // Read the desired number of strings (of any length).
     s = *input;
-    char tmp[OSL_MAX_STRING];
     for (size_t i = 0; i < nb_strings; i++) {
       size_t count;
-      for (count = 0; *s && !isspace(*s) && *s != '#'; count++)
-        tmp[count] = *(s++);
-      tmp[count] = '\0';
-      OSL_strdup(string[i], tmp);
+      for (count = 0; s[count] && !isspace(s[count]) && s[count] != '#';)
+        count++;
+      OSL_malloc(string[i], char*, (count + 1) * sizeof(char));
+      memcpy(string[i], s, count);
+      string[i][count] = '\0';
+      s += count;
       if (*s != '#')
         s++;
     }
@@ -221,7 +221,7 @@ osl_strings* osl_strings_sread(char** const input) {
 
     // Build the strings structure
     strings = osl_strings_malloc();
-    free(strings->string);
+    osl_allocator_free(strings->string);
     strings->string = string;
   }
 
@@ -240,6 +240,11 @@ osl_strings* osl_strings_sread(char** const input) {
 osl_strings* osl_strings_read(FILE* const file) {
   char buffer[OSL_MAX_STRING];
   char* start = osl_util_skip_blank_and_comments(file, buffer);
+
+  // Nothing left to read: return an empty strings structure.
+  if (start == NULL)
+    return osl_strings_malloc();
+
   osl_strings* strings = osl_strings_sread(&start);
 
   return strings;
@@ -263,6 +268,8 @@ osl_strings* osl_strings_malloc(void) {
   OSL_malloc(strings, osl_strings*, sizeof(struct osl_strings));
   OSL_malloc(strings->string, char**, sizeof(char*));
   strings->string[0] = NULL;
+  strings->index = NULL;
+  strings->generation = osl_util_generation();
 
   return strings;
 }
@@ -277,12 +284,115 @@ void osl_strings_free(osl_strings* const strings) {
     if (strings->string) {
       size_t i = 0;
       while (strings->string[i]) {
-        free(strings->string[i]);
+        osl_allocator_free(strings->string[i]);
         i++;
       }
-      free(strings->string);
+      osl_allocator_free(strings->string);
     }
-    free(strings);
+    osl_strings_free_index(strings);
+    osl_allocator_free(strings);
+  }
+}
+
+/**
+ * osl_strings_index_insert function:
+ * this function records the position of a string of the indexed array in
+ * the hash index.
+ * \param[in,out] index    The hash index.
+ * \param[in]     position The position of the string in the indexed array.
+ */
+static void osl_strings_index_insert(osl_strings_index* const index,
+                                     const size_t position) {
+  const size_t mask = index->nb_buckets - 1;
+  size_t bucket = osl_util_hash(index->string[position]) & mask;
+
+  while (index->bucket[bucket])
+    bucket = (bucket + 1) & mask;
+  index->bucket[bucket] = position + 1;
+}
+
+/**
+ * osl_strings_index_rehash function:
+ * this function rebuilds the buckets of a hash index with a new number of
+ * buckets.
+ * \param[in,out] index      The hash index.
+ * \param[in]     nb_buckets The new number of buckets (a power of two).
+ */
+static void osl_strings_index_rehash(osl_strings_index* const index,
+                                     const size_t nb_buckets) {
+  osl_allocator_free(index->bucket);
+  index->nb_buckets = nb_buckets;
+  OSL_malloc(index->bucket, size_t*, nb_buckets * sizeof(size_t));
+  for (size_t i = 0; i < nb_buckets; i++)
+    index->bucket[i] = 0;
+
+  for (size_t i = 0; i < index->size; i++)
+    osl_strings_index_insert(index, i);
+}
+
+/**
+ * osl_strings_index_is_valid function:
+ * this function checks whether the hash index of a strings structure is
+ * still consistent with its array, i.e., the array has not been replaced
+ * and the strings structure has not been marked as modified (see
+ * osl_strings_touch) since the index has been built or updated by
+ * osl_strings_add. The array itself is not read, as it may have been shrunk.
+ * \param[in] strings The strings structure to check.
+ * \return true if the strings structure has an up-to-date index.
+ */
+static bool osl_strings_index_is_valid(const osl_strings* const strings) {
+  const osl_strings_index* const index = strings->index;
+
+  return index && (strings->string == index->string) &&
+         (strings->generation == index->generation);
+}
+
+/**
+ * osl_strings_build_index function:
+ * this function attaches a hash index to a strings structure (replacing
+ * the existing one, if any). Then osl_strings_find and osl_strings_add run
+ * in (amortized) constant time. The index follows the modifications done
+ * through osl_strings_add and is rebuilt there if the array has been
+ * replaced. Any other modification of the array (replacing, adding or
+ * removing strings in place) must be followed by osl_strings_touch while the
+ * index is attached.
+ * \param[in,out] strings The strings structure to index.
+ */
+void osl_strings_build_index(osl_strings* const strings) {
+  osl_strings_index* index;
+
+  osl_strings_free_index(strings);
+  if (!strings->string) {
+    OSL_malloc(strings->string, char**, sizeof(char*));
+    strings->string[0] = NULL;
+  }
+
+  OSL_malloc(index, osl_strings_index*, sizeof(osl_strings_index));
+  index->string = strings->string;
+  index->generation = strings->generation;
+  index->size = osl_strings_size(strings);
+  index->capacity = index->size + 1;
+  index->bucket = NULL;
+
+  size_t nb_buckets = 16;
+  while (nb_buckets < 2 * index->capacity)
+    nb_buckets *= 2;
+  osl_strings_index_rehash(index, nb_buckets);
+
+  strings->index = index;
+}
+
+/**
+ * osl_strings_free_index function:
+ * this function detaches and frees the hash index of a strings structure,
+ * if any.
+ * \param[in,out] strings The strings structure to drop the index from.
+ */
+void osl_strings_free_index(osl_strings* const strings) {
+  if (strings->index) {
+    osl_allocator_free(strings->index->bucket);
+    osl_allocator_free(strings->index);
+    strings->index = NULL;
   }
 }
 
@@ -303,29 +413,52 @@ osl_strings* osl_strings_clone(const osl_strings* const strings) {
 
   osl_strings* const clone = osl_strings_malloc();
   const size_t nb_strings = osl_strings_size(strings);
-  if (!nb_strings)
+  if (!nb_strings) {
+    if (strings->index)
+      osl_strings_build_index(clone);
     return clone;
+  }
 
-  free(clone->string);
+  osl_allocator_free(clone->string);
   OSL_malloc(clone->string, char**, (nb_strings + 1) * sizeof(char*));
   clone->string[nb_strings] = NULL;
   for (size_t i = 0; i < nb_strings; i++)
     OSL_strdup(clone->string[i], strings->string[i]);
 
+  if (strings->index)
+    osl_strings_build_index(clone);
+
   return clone;
 }
 
 /**
  * osl_strings_find function.
- * this function finds the string in the strings.
+ * this function finds the string in the strings. It runs in constant time
+ * if the strings structure has an up-to-date hash index (see
+ * osl_strings_build_index), in linear time otherwise.
  * \param[in,out] strings The strings structure.
  * \param[in]     string  The string to find in strings.
  * \return the index where is the string, osl_strings_size if not found
  */
 size_t osl_strings_find(const osl_strings* const strings,
                         char const* const string) {
+  if (osl_strings_index_is_valid(strings)) {
+    const osl_strings_index* const index = strings->index;
+    const size_t mask = index->nb_buckets - 1;
+    size_t bucket = osl_util_hash(string) & mask;
+
+    while (index->bucket[bucket]) {
+      const size_t position = index->bucket[bucket] - 1;
+      if (strcmp(strings->string[position], string) == 0)
+        return position;
+      bucket = (bucket + 1) & mask;
+    }
+    return index->size;
+  }
+
   size_t i;
-  for (i = 0; i < osl_strings_size(strings); ++i) {
+  const size_t size = osl_strings_size(strings);
+  for (i = 0; i < size; ++i) {
     if (strcmp(strings->string[i], string) == 0) {
       return i;
     }
@@ -335,16 +468,54 @@ size_t osl_strings_find(const osl_strings* const strings,
 
 /**
  * osl_strings_add function.
- * this function adds a copy of the string in the strings.
+ * this function adds a copy of the string in the strings. If the strings
+ * structure has a hash index (see osl_strings_build_index), the array grows
+ * geometrically and the index is updated.
  * \param[in,out] strings The strings structure.
  * \param[in]     string  The string to add in strings.
  */
 void osl_strings_add(osl_strings* const strings, char const* const string) {
-  const size_t original_size = osl_strings_size(strings);
-  OSL_realloc(strings->string, char**, sizeof(char*) * (original_size + 1 + 1));
-  strings->string[original_size + 1] = NULL;
-  strings->string[original_size] = malloc(sizeof(char) * (strlen(string) + 1));
-  strcpy(strings->string[original_size], string);
+  if (strings->index && !osl_strings_index_is_valid(strings))
+    osl_strings_build_index(strings);
+
+  osl_strings_index* const index = strings->index;
+  if (!index) {
+    const size_t original_size = osl_strings_size(strings);
+    OSL_realloc(strings->string, char**,
+                sizeof(char*) * (original_size + 1 + 1));
+    strings->string[original_size + 1] = NULL;
+    strings->string[original_size] =
+        osl_allocator_malloc(sizeof(char) * (strlen(string) + 1));
+    strcpy(strings->string[original_size], string);
+    return;
+  }
+
+  if (index->size + 2 > index->capacity) {
+    index->capacity = OSL_max(2 * index->capacity, index->size + 2);
+    OSL_realloc(strings->string, char**, sizeof(char*) * index->capacity);
+    index->string = strings->string;
+  }
+  strings->string[index->size] =
+      osl_allocator_malloc(sizeof(char) * (strlen(string) + 1));
+  strcpy(strings->string[index->size], string);
+  strings->string[index->size + 1] = NULL;
+  osl_strings_index_insert(index, index->size);
+  index->size++;
+
+  if (2 * index->size > index->nb_buckets)
+    osl_strings_index_rehash(index, 2 * index->nb_buckets);
+}
+
+/**
+ * osl_strings_touch function:
+ * this function marks a strings structure as modified, so that its hash
+ * index is not used anymore (see osl_strings_build_index), and rebuilt by
+ * the next osl_strings_add. It is necessary after a direct modification of
+ * the array while an index is attached.
+ * \param[in,out] strings The strings structure to mark as modified.
+ */
+void osl_strings_touch(osl_strings* const strings) {
+  strings->generation = osl_util_generation();
 }
 
 /**
@@ -378,13 +549,17 @@ bool osl_strings_equal(const osl_strings* const s1,
 /**
  * osl_strings_size function:
  * this function returns the number of elements in the NULL-terminated
- * strings array of the strings structure.
+ * strings array of the strings structure (in constant time if the strings
+ * structure has an up-to-date hash index).
  * \param[in] strings The strings structure we need to know the size.
  * \return The number of strings in the strings structure.
  */
 size_t osl_strings_size(const osl_strings* const strings) {
   size_t size = 0;
 
+  if (strings && osl_strings_index_is_valid(strings))
+    return strings->index->size;
+
   if (strings && strings->string) {
     while (strings->string[size]) {
       size++;
@@ -394,6 +569,35 @@ size_t osl_strings_size(const osl_strings* const strings) {
   return size;
 }
 
+/**
+ * osl_strings_memory_usage function:
+ * this function adds the memory footprint of a strings structure (its
+ * array, strings and hash index) to a memory usage.
+ * \param[in]     strings The strings structure.
+ * \param[in,out] usage   The memory usage to update.
+ */
+void osl_strings_memory_usage(const osl_strings* const strings,
+                              osl_memory_usage* const usage) {
+  if (!strings)
+    return;
+
+  osl_memory_usage_add(usage, &usage->structures, sizeof(osl_strings));
+  const size_t nb_strings = osl_strings_size(strings);
+  if (strings->string) {
+    size_t nb_slots = nb_strings + 1;
+    if (osl_strings_index_is_valid(strings))
+      nb_slots = OSL_max(nb_slots, strings->index->capacity);
+    osl_memory_usage_add(usage, &usage->strings, nb_slots * sizeof(char*));
+    for (size_t i = 0; i < nb_strings; i++)
+      osl_memory_usage_string(usage, strings->string[i]);
+  }
+  if (strings->index) {
+    osl_memory_usage_add(usage, &usage->indexes, sizeof(osl_strings_index));
+    osl_memory_usage_add(usage, &usage->indexes,
+                         strings->index->nb_buckets * sizeof(size_t));
+  }
+}
+
 /**
  * osl_strings_encapsulate function:
  * this function builds a new strings structure to encapsulate the string
@@ -403,7 +607,7 @@ size_t osl_strings_size(const osl_strings* const strings) {
  */
 osl_strings* osl_strings_encapsulate(char* const string) {
   osl_strings* const capsule = osl_strings_malloc();
-  free(capsule->string);
+  osl_allocator_free(capsule->string);
   OSL_malloc(capsule->string, char**, 2 * sizeof(char*));
   capsule->string[0] = string;
   capsule->string[1] = NULL;
@@ -428,6 +632,7 @@ osl_interface* osl_strings_interface(void) {
   interface->free = (osl_free_f)osl_strings_free;
   interface->clone = (osl_clone_f)osl_strings_clone;
   interface->equal = (osl_equal_f)osl_strings_equal;
+  interface->size = (osl_size_f)osl_strings_memory_usage;
 
   return interface;
 }
@@ -456,7 +661,7 @@ osl_strings* osl_strings_generate(const char* prefix, const int nb_strings) {
   }
 
   osl_strings* const generated = osl_strings_malloc();
-  free(generated->string);
+  osl_allocator_free(generated->string);
   generated->string = strings;
   return generated;
 }
@@ -474,10 +679,16 @@ void osl_strings_add_strings(osl_strings** const dest,
                              const osl_strings* const str2) {
   size_t i = 0;
   osl_strings* const res = osl_strings_clone(str1);
+  const bool indexed = (res->index != NULL);
+  // Index the result while adding strings to get amortized growth.
+  if (!indexed)
+    osl_strings_build_index(res);
   while (str2->string[i]) {
     osl_strings_add(res, str2->string[i]);
     i++;
   }
+  if (!indexed)
+    osl_strings_free_index(res);
 
   *dest = res;
 }
@@ -60,6 +60,7 @@
 
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -140,7 +141,7 @@ int osl_util_read_int(FILE* const file, char** str) {
   if (file) {
     // Parse from a file.
     char* const start = osl_util_skip_blank_and_comments(file, s);
-    if (sscanf(start, " %d", &res) != 1)
+    if (!start || sscanf(start, " %d", &res) != 1)
       OSL_error("an int was expected");
   } else {
     // Parse from a string.
@@ -180,8 +181,10 @@ char* osl_util_read_string(FILE* const file, char** str) {
   if (file != NULL) {
     // Parse from a file.
     char* const start = osl_util_skip_blank_and_comments(file, s);
-    if (sscanf(start, " %s", res) != 1)
+    if (!start || sscanf(start, " %s", res) != 1) {
+      osl_allocator_free(res);
       OSL_error("a string was expected");
+    }
   } else {
     // Parse from a string.
     // Skip blank/commented lines.
@@ -192,8 +195,10 @@ char* osl_util_read_string(FILE* const file, char** str) {
     while (**str && !isspace(**str) && **str != '\n' && **str != '#')
       s[i++] = *((*str)++);
     s[i] = '\0';
-    if (sscanf(s, "%s", res) != 1)
+    if (sscanf(s, "%s", res) != 1) {
+      osl_allocator_free(res);
       OSL_error("a string was expected");
+    }
   }
 
   OSL_realloc(res, char*, strlen(res) + 1);
@@ -224,12 +229,13 @@ char* osl_util_read_line(FILE* const file, char** str) {
   if (file) {
     // Parse from a file.
     char* start = osl_util_skip_blank_and_comments(file, s);
-    while (*start && *start != '\n' && *start != '#' && i < OSL_MAX_STRING)
+    while (start && *start && *start != '\n' && *start != '#' &&
+           i < OSL_MAX_STRING - 1)
       res[i++] = *start++;
   } else {
     // Parse from a string.
     osl_util_sskip_blank_and_comments(str);
-    while (**str && **str != '\n' && **str != '#' && i < OSL_MAX_STRING)
+    while (**str && **str != '\n' && **str != '#' && i < OSL_MAX_STRING - 1)
       res[i++] = *((*str)++);
   }
 
@@ -271,7 +277,7 @@ char* osl_util_read_tag(FILE* const file, char** str) {
   }
 
   // If the end of the input has been reached, return NULL.
-  if ((file && (feof(file))) || (str && (**str == '\0')))
+  if ((file && (feof(file) || !start)) || (str && (**str == '\0')))
     return NULL;
 
   // Pass the starting '<'.
@@ -290,13 +296,16 @@ char* osl_util_read_tag(FILE* const file, char** str) {
       res[i++] = *((*str)++);
       res[i] = '\0';
     } else {
+      osl_allocator_free(res);
       OSL_error("illegal character in the tag name");
     }
   }
 
   // Check we actually end up with a '>' and pass it.
-  if (**str != '>')
+  if (**str != '>') {
+    osl_allocator_free(res);
     OSL_error("a \">\" to end a tag was expected");
+  }
   (*str)++;
 
   return res;
@@ -348,7 +357,7 @@ char* osl_util_read_uptoflag(FILE* const file, char** str,
 
   if (!flag_found) {
     OSL_debug("flag was not found, end of input reached");
-    free(res);
+    osl_allocator_free(res);
     return NULL;
   }
 
@@ -490,6 +499,36 @@ char* osl_util_strdup(char const* str) {
   return dup;
 }
 
+/**
+ * osl_util_hash function:
+ * this function returns a hash value for the string str (FNV-1a hash), to be
+ * used by the hash tables of the library.
+ * \param[in] str The string to hash.
+ * \return The hash value of the string.
+ */
+size_t osl_util_hash(char const* str) {
+  uint32_t hash = 2166136261u;
+
+  for (; *str; str++) {
+    hash ^= (unsigned char)*str;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * osl_util_generation function:
+ * this function returns a new value of a process-wide counter, to be used
+ * as the modification counter of a structure (see osl_relation_touch). Two
+ * calls never return the same value, even from different threads, so a
+ * structure freed then reallocated at the same address has another value.
+ * \return A value never returned before.
+ */
+size_t osl_util_generation(void) {
+  static size_t generation = 0;
+  return __atomic_add_fetch(&generation, 1, __ATOMIC_RELAXED);
+}
+
 /**
  * osl_util_get_precision function:
  * this function returns the precision defined by the precision environment
@@ -544,48 +583,15 @@ void osl_util_print_provided(FILE* const file, const bool provided,
 }
 
 /**
- * osl_util_identifier_is_here function:
- * this function returns 1 if the input "identifier" is found at the
- * "index" position in the "expression" input string, 0 otherwise.
- * \param[in] expression The input expression.
- * \param[in] identifier The identifier to look for.
- * \param[in] index      The position in the expression where to look.
- * \return 1 if the identifier is found at the position in the expression.
+ * osl_util_is_identifier_char function:
+ * this function returns true if the character c may be part of an
+ * identifier, i.e., if it is in [A-Za-z0-9_], false otherwise.
+ * \param[in] c The character to check.
+ * \return true if c is an identifier character, false otherwise.
  */
-static int osl_util_identifier_is_here(const char* const expression,
-                                       const char* const identifier,
-                                       const size_t index) {
-  const size_t identifier_len = strlen(identifier);
-  const size_t expression_len = strlen(expression);
-
-  // If there is no space enough to find the identifier: no.
-  if (identifier_len + index > expression_len)
-    return 0;
-
-  // If there is a character before and it is in [A-Za-z0-9_]: no.
-  if ((index > 0) &&
-      (((expression[index - 1] >= 'A') && (expression[index - 1] <= 'Z')) ||
-       ((expression[index - 1] >= 'a') && (expression[index - 1] <= 'z')) ||
-       ((expression[index - 1] >= '0') && (expression[index - 1] <= '9')) ||
-       (expression[index - 1] == '_')))
-    return 0;
-
-  // If there is a character after and it is in [A-Za-z0-9_]: no.
-  if ((identifier_len + index < expression_len) &&
-      (((expression[identifier_len + index] >= 'A') &&
-        (expression[identifier_len + index] <= 'Z')) ||
-       ((expression[identifier_len + index] >= 'a') &&
-        (expression[identifier_len + index] <= 'z')) ||
-       ((expression[identifier_len + index] >= '0') &&
-        (expression[identifier_len + index] <= '9')) ||
-       (expression[identifier_len + index] == '_')))
-    return 0;
-
-  // If the identifier string is not here: no.
-  if (strncmp(expression + index, identifier, identifier_len))
-    return 0;
-
-  return 1;
+static bool osl_util_is_identifier_char(const char c) {
+  return ((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) ||
+         ((c >= '0') && (c <= '9')) || (c == '_');
 }
 
 /**
@@ -597,17 +603,16 @@ static int osl_util_identifier_is_here(const char* const expression,
  * "A[2*i]". This function is lazy in the sense that it just check obvious
  * cases, not all of them. The identifier must already be at the indicated
  * position, this function does not check that.
- * \param[in] expression The input expression.
- * \param[in] identifier The identifier to check.
- * \param[in] index      The position of the identifier in the expression.
+ * \param[in] expression     The input expression.
+ * \param[in] expression_len The length of the input expression.
+ * \param[in] index          The position of the identifier in the expression.
+ * \param[in] identifier_len The length of the identifier.
  * \return 1 if the identifier is isolated, 0 if unsure.
  */
 static int osl_util_lazy_isolated_identifier(const char* const expression,
-                                             const char* const identifier,
-                                             const size_t index) {
-  const size_t expression_len = strlen(expression);
-  const size_t identifier_len = strlen(identifier);
-
+                                             const size_t expression_len,
+                                             const size_t index,
+                                             const size_t identifier_len) {
   // If the first non-space character before is not in [\[(,\+=]: no.
   size_t look = index - 1;
   while (look < index) {
@@ -649,45 +654,99 @@ static int osl_util_lazy_isolated_identifier(const char* const expression,
  * the identifier can be replaced with an arbitrary expression without the
  * need of parentheses. For instance, let us consider the input expression
  * "C[i+j]+=A[2*i]*B[j];" and the array of strings {"i", "j"}: the resulting
- * string would be "C[@0@+@1@]+=A[2*(@0@)]*B[@1@];".
+ * string would be "C[@0@+@1@]+=A[2*(@0@)]*B[@1@];". Identifiers are made of
+ * characters in [A-Za-z0-9_] and they are only replaced when they are not
+ * part of a longer identifier. The expression is scanned once: each maximal
+ * sequence of identifier characters is looked up in a hash table of the
+ * identifiers, hence the substitution is linear in the expression length.
  * \param[in] expression The original expression.
  * \param[in] identifiers NULL-terminated array of identifiers.
  * \return A new string where the ith identifier is replaced by \@i\@.
  */
 char* osl_util_identifier_substitution(const char* const expression,
                                        char** identifiers) {
-  size_t high_water_mark = OSL_MAX_STRING;
-  char buffer[OSL_MAX_STRING];
+  // Build an open addressing hash table of the identifier ranks (the first
+  // rank is kept if an identifier appears several times).
+  size_t nb_identifiers = 0;
+  while (identifiers[nb_identifiers])
+    nb_identifiers++;
+
+  size_t table_size = 1;
+  while (table_size < 2 * nb_identifiers)
+    table_size *= 2;
+
+  size_t* table;
+  OSL_malloc(table, size_t*, table_size * sizeof(size_t));
+  for (size_t k = 0; k < table_size; k++)
+    table[k] = SIZE_MAX;
+
+  for (size_t j = 0; j < nb_identifiers; j++) {
+    size_t k = osl_util_hash(identifiers[j]) & (table_size - 1);
+    while ((table[k] != SIZE_MAX) && strcmp(identifiers[table[k]],
+                                            identifiers[j]))
+      k = (k + 1) & (table_size - 1);
+    if (table[k] == SIZE_MAX)
+      table[k] = j;
+  }
+
+  // Scan the expression.
+  const size_t expression_len = strlen(expression);
+  size_t high_water_mark = expression_len + OSL_MAX_STRING;
+  size_t length = 0;
   char* string;
 
   OSL_malloc(string, char*, high_water_mark * sizeof(char));
-  string[0] = '\0';
 
   size_t index = 0;
-  while (index < strlen(expression)) {
-    size_t j = 0;
-    bool found = false;
-    while (identifiers[j]) {
-      if (osl_util_identifier_is_here(expression, identifiers[j], index)) {
-        if (osl_util_lazy_isolated_identifier(expression, identifiers[j],
-                                              index))
-          sprintf(buffer, "@%zu@", j);
-        else
-          sprintf(buffer, "(@%zu@)", j);
-        osl_util_safe_strcat(&string, buffer, &high_water_mark);
-        index += strlen(identifiers[j]);
-        found = true;
-        break;
+  while (index < expression_len) {
+    // Copy non-identifier characters as they are.
+    if (!osl_util_is_identifier_char(expression[index])) {
+      string[length++] = expression[index++];
+    } else {
+      // Find the end of the identifier and look it up.
+      size_t end = index;
+      uint32_t hash = 2166136261u;
+      while ((end < expression_len) &&
+             osl_util_is_identifier_char(expression[end])) {
+        hash ^= (unsigned char)expression[end];
+        hash *= 16777619u;
+        end++;
       }
-      j++;
+
+      const size_t identifier_len = end - index;
+      size_t j = SIZE_MAX;
+      size_t k = (size_t)hash & (table_size - 1);
+      while (table[k] != SIZE_MAX) {
+        if (!strncmp(identifiers[table[k]], expression + index,
+                     identifier_len) &&
+            (identifiers[table[k]][identifier_len] == '\0')) {
+          j = table[k];
+          break;
+        }
+        k = (k + 1) & (table_size - 1);
+      }
+
+      if (j == SIZE_MAX) {
+        memcpy(string + length, expression + index, identifier_len);
+        length += identifier_len;
+      } else if (osl_util_lazy_isolated_identifier(expression, expression_len,
+                                                   index, identifier_len)) {
+        length += sprintf(string + length, "@%zu@", j);
+      } else {
+        length += sprintf(string + length, "(@%zu@)", j);
+      }
+      index = end;
     }
-    if (!found) {
-      sprintf(buffer, "%c", expression[index]);
-      osl_util_safe_strcat(&string, buffer, &high_water_mark);
-      index++;
+
+    // Keep room for the next identifier substitution or a whole identifier.
+    if (length + (expression_len - index) + OSL_MIN_STRING > high_water_mark) {
+      high_water_mark = 2 * high_water_mark + (expression_len - index);
+      OSL_realloc(string, char*, high_water_mark * sizeof(char));
     }
   }
+  string[length] = '\0';
 
+  osl_allocator_free(table);
   return string;
 }
 
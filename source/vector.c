@@ -175,9 +175,9 @@ void osl_vector_free(osl_vector* const vector) {
       for (int i = 0; i < vector->size; i++)
         osl_int_clear(vector->precision, &vector->v[i]);
 
-      free(vector->v);
+      osl_allocator_free(vector->v);
     }
-    free(vector);
+    osl_allocator_free(vector);
   }
 }
 
@@ -0,0 +1,317 @@
+// (3-clause BSD license)
+// Redistribution and use in source  and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/allocator.h>
+#include <osl/int.h>
+#include <osl/interface.h>
+#include <osl/macros.h>
+#include <osl/memory.h>
+#include <osl/scop.h>
+
+#define TEST_MAGIC 0x05105105u
+
+// Every block of the counting allocator starts with this header, so that a
+// block that did not come from it is detected when it is freed.
+typedef union {
+  struct {
+    unsigned magic;
+    size_t size;
+  } info;
+  max_align_t align;
+} test_header;
+
+typedef struct {
+  size_t nb_mallocs; // Number of blocks allocated
+  size_t nb_live;    // Number of blocks not freed yet
+  size_t nb_bytes;   // Number of bytes not freed yet
+  size_t nb_foreign; // Number of freed blocks not from this allocator
+} test_counters;
+
+static void* test_malloc(size_t size, void* user) {
+  test_counters* const counters = user;
+  test_header* const header = malloc(sizeof(test_header) + size);
+  if (header == NULL)
+    return NULL;
+  header->info.magic = TEST_MAGIC;
+  header->info.size = size;
+  counters->nb_mallocs++;
+  counters->nb_live++;
+  counters->nb_bytes += size;
+  return header + 1;
+}
+
+static void test_free(void* ptr, void* user) {
+  test_counters* const counters = user;
+  test_header* const header = (test_header*)ptr - 1;
+  if (header->info.magic != TEST_MAGIC) {
+    counters->nb_foreign++;
+    return;
+  }
+  header->info.magic = 0;
+  counters->nb_live--;
+  counters->nb_bytes -= header->info.size;
+  free(header);
+}
+
+static void* test_realloc(void* ptr, size_t size, void* user) {
+  if (ptr == NULL)
+    return test_malloc(size, user);
+
+  test_header* const header = (test_header*)ptr - 1;
+  void* const copy = test_malloc(size, user);
+  if (copy == NULL)
+    return NULL;
+  memcpy(copy, ptr, header->info.size < size ? header->info.size : size);
+  test_free(ptr, user);
+  return copy;
+}
+
+#ifdef OSL_GMP_IS_HERE
+// Memory functions of GMP set by the program, with their own counters
+static test_counters test_gmp_counters;
+
+static void* test_gmp_malloc(size_t size) {
+  return test_malloc(size, &test_gmp_counters);
+}
+
+static void* test_gmp_realloc(void* ptr, size_t old_size, size_t new_size) {
+  (void)old_size;
+  return test_realloc(ptr, new_size, &test_gmp_counters);
+}
+
+static void test_gmp_free(void* ptr, size_t size) {
+  (void)size;
+  test_free(ptr, &test_gmp_counters);
+}
+
+// Prints a GMP integer while GMP uses the memory functions of the program:
+// the strings made by GMP must go back to these functions
+static int check_gmp_print(const char* const when) {
+  char string[OSL_MAX_STRING];
+  char string_txt[OSL_MAX_STRING];
+  osl_int value;
+  int nb_fail = 0;
+
+  osl_int_init_set_si(OSL_PRECISION_MP, &value, 42);
+  osl_int_sprint(string, OSL_PRECISION_MP, value);
+  osl_int_sprint_txt(string_txt, OSL_PRECISION_MP, value);
+  osl_int_clear(OSL_PRECISION_MP, &value);
+
+  if (!strstr(string, "42") || strcmp(string_txt, "42")) {
+    printf("GMP integer printed as \"%s\" and \"%s\" %s\n", string,
+           string_txt, when);
+    ++nb_fail;
+  }
+  if (test_gmp_counters.nb_live || test_gmp_counters.nb_foreign) {
+    printf("GMP strings not freed by GMP %s\n", when);
+    ++nb_fail;
+  }
+  return nb_fail;
+}
+
+// Checks that GMP uses the memory functions of the program
+static int check_gmp_functions(const char* const when) {
+  void* (*gmp_malloc)(size_t);
+  void* (*gmp_realloc)(void*, size_t, size_t);
+  void (*gmp_free)(void*, size_t);
+  mp_get_memory_functions(&gmp_malloc, &gmp_realloc, &gmp_free);
+
+  if ((gmp_malloc != test_gmp_malloc) || (gmp_realloc != test_gmp_realloc) ||
+      (gmp_free != test_gmp_free)) {
+    printf("The GMP memory functions are not restored %s\n", when);
+    return 1;
+  }
+  return 0;
+}
+#endif
+
+static const char test_scop[] =
+    "<OpenScop>\n"
+    "# =============================================== Global\n"
+    "# Language\n"
+    "C\n"
+    "# Context\n"
+    "CONTEXT\n"
+    "1 3 0 0 0 1\n"
+    "# e/i| N | 1\n"
+    "   1   1  -1\n"
+    "# Parameters are provided\n"
+    "1\n"
+    "<strings>\n"
+    "N\n"
+    "</strings>\n"
+    "# Number of statements\n"
+    "1\n"
+    "# =============================================== Statement 1\n"
+    "# Number of relations describing the statement:\n"
+    "3\n"
+    "DOMAIN\n"
+    "2 4 1 0 0 1\n"
+    "# e/i| i | N | 1\n"
+    "   1   1   0   0\n"
+    "   1  -1   1  -1\n"
+    "SCATTERING\n"
+    "3 7 3 1 0 1\n"
+    "# e/i| c1  c2  c3 | i | N | 1\n"
+    "   0  -1   0   0    0   0   0\n"
+    "   0   0  -1   0    1   0   0\n"
+    "   0   0   0  -1    0   0   0\n"
+    "WRITE\n"
+    "2 6 2 1 0 1\n"
+    "# e/i| Arr  [1]| i | N | 1\n"
+    "   0    -1    0   0   0   1\n"
+    "   0     0   -1   1   0   0\n"
+    "# Statement Extensions\n"
+    "1\n"
+    "<body>\n"
+    "1\n"
+    "i\n"
+    "A[i] = 123456789012345678901234567890;\n"
+    "</body>\n"
+    "# =============================================== Extensions\n"
+    "<arrays>\n"
+    "1\n"
+    "1 A\n"
+    "</arrays>\n"
+    "</OpenScop>\n";
+
+// Reads, prints, clones and frees the test scop at a given precision, and
+// checks its memory usage against the bytes it holds
+static int test_round(const int precision, const test_counters* counters) {
+  const size_t nb_bytes = counters->nb_bytes;
+  FILE* const input = fmemopen((void*)test_scop, strlen(test_scop), "r");
+  osl_interface* const registry = osl_interface_get_default_registry();
+  osl_scop* const scop = osl_scop_pread(input, registry, precision);
+  fclose(input);
+  osl_interface_free(registry);
+
+  osl_memory_usage usage;
+  osl_memory_usage_init(&usage);
+  osl_scop_memory_usage(scop, &usage);
+  const size_t nb_used = osl_memory_usage_total(&usage) - usage.overhead;
+  int nb_fail = 0;
+
+  if (nb_used != counters->nb_bytes - nb_bytes) {
+    printf("Memory usage at precision %d is %zu bytes instead of %zu\n",
+           precision, nb_used, counters->nb_bytes - nb_bytes);
+    ++nb_fail;
+  }
+
+  osl_scop* const clone = osl_scop_clone(scop);
+  char* string = NULL;
+  size_t size = 0;
+  FILE* const output = open_memstream(&string, &size);
+  osl_scop_print(output, clone);
+  fclose(output);
+
+  if (!osl_scop_equal(scop, clone) || strstr(string, "Arr") == NULL) {
+    printf("Round trip at precision %d failed\n", precision);
+    ++nb_fail;
+  }
+
+  free(string);
+  osl_scop_free(clone);
+  osl_scop_free(scop);
+  return nb_fail;
+}
+
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) { printf("argv are ignored\n"); }
+
+  int nb_fail = 0;
+#ifdef OSL_GMP_IS_HERE
+  // Setting the default allocator keeps the GMP functions of the program.
+  mp_set_memory_functions(test_gmp_malloc, test_gmp_realloc, test_gmp_free);
+  osl_allocator_set(NULL);
+  nb_fail += check_gmp_functions("without an allocator");
+  nb_fail += check_gmp_print("without an allocator");
+#endif
+
+  test_counters counters = {0, 0, 0, 0};
+  osl_allocator allocator;
+  allocator.malloc = test_malloc;
+  allocator.realloc = test_realloc;
+  allocator.free = test_free;
+  allocator.user = &counters;
+  osl_allocator_set(&allocator);
+
+  // The default registry is built once and kept.
+  osl_interface_free(osl_interface_get_default_registry());
+  const size_t nb_kept = counters.nb_live;
+  const size_t nb_mallocs = counters.nb_mallocs;
+
+  nb_fail += test_round(OSL_PRECISION_DP, &counters);
+  nb_fail += test_round(OSL_PRECISION_MP, &counters);
+  if (counters.nb_mallocs == nb_mallocs) {
+    printf("The allocator is not used\n");
+    ++nb_fail;
+  }
+  if (counters.nb_live != nb_kept) {
+    printf("%zu block(s) leaked or freed elsewhere\n",
+           counters.nb_live - nb_kept);
+    ++nb_fail;
+  }
+
+#ifdef OSL_GMP_IS_HERE
+  // The value of a GMP integer is allocated by GMP.
+  osl_int value;
+  const size_t nb_before = counters.nb_mallocs;
+  osl_int_init_set_si(OSL_PRECISION_MP, &value, 42);
+  if (counters.nb_mallocs - nb_before < 2) {
+    printf("GMP does not use the allocator\n");
+    ++nb_fail;
+  }
+  osl_int_clear(OSL_PRECISION_MP, &value);
+
+  // The program may set its own GMP functions again.
+  mp_set_memory_functions(test_gmp_malloc, test_gmp_realloc, test_gmp_free);
+  nb_fail += check_gmp_print("with an allocator");
+  osl_allocator_set(&allocator);
+#endif
+
+  if (counters.nb_foreign) {
+    printf("%zu block(s) freed but not allocated by the allocator\n",
+           counters.nb_foreign);
+    ++nb_fail;
+  }
+
+  osl_allocator_set(NULL);
+#ifdef OSL_GMP_IS_HERE
+  nb_fail += check_gmp_functions("after the allocator");
+#endif
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+  printf("\n");
+
+  return nb_fail;
+}
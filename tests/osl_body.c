@@ -0,0 +1,104 @@
+// (3-clause BSD license)
+// Redistribution and use in source  and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/body.h>
+#include <osl/strings.h>
+#include <osl/util.h>
+
+
+// Checks the substitution of the identifiers in the expression
+static int check_substitution(const char* const expression,
+                              char** identifiers, const char* const expected) {
+  char* const string = osl_util_identifier_substitution(expression,
+                                                        identifiers);
+  int nb_fail = 0;
+
+  if (strcmp(string, expected)) {
+    printf("Substitution of \"%s\" gives \"%s\" instead of \"%s\"\n",
+           expression, string, expected);
+    ++nb_fail;
+  }
+
+  free(string);
+  return nb_fail;
+}
+
+// Checks the instantiation of a compiled body with new iterator names
+static int check_template(const osl_body* const body, char** names,
+                          const char* const expected) {
+  osl_body_template* const template = osl_body_template_compile(body);
+  char* const string = osl_body_template_instantiate(template, names);
+  int nb_fail = 0;
+
+  if (strcmp(string, expected)) {
+    printf("Instantiation gives \"%s\" instead of \"%s\"\n", string,
+           expected);
+    ++nb_fail;
+  }
+
+  free(string);
+  osl_body_template_free(template);
+  return nb_fail;
+}
+
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) { printf("argv are ignored\n"); }
+
+  int nb_fail = 0;
+  char* ij[] = {"i", "j", NULL};
+  char* nested[] = {"i", "ii", "i_1", NULL};
+
+  nb_fail += check_substitution("C[i+j]+=A[2*i]*B[j];", ij,
+                                "C[@0@+@1@]+=A[2*(@0@)]*B[@1@];");
+  nb_fail += check_substitution("", ij, "");
+  nb_fail += check_substitution("x = ij + ji;", ij, "x = ij + ji;");
+  nb_fail += check_substitution("A[ii][i_1] = i;", nested,
+                                "A[@1@][@2@] = @0@;");
+  nb_fail += check_substitution("S(i, j , 2i)", ij, "S(@0@, @1@ , 2i)");
+
+  osl_body* const body = osl_body_malloc();
+  body->iterators = osl_strings_encapsulate(osl_util_strdup("i"));
+  osl_strings_add(body->iterators, "j");
+  body->expression = osl_strings_encapsulate(osl_util_strdup("C[i+j] = 2*i + @x;"));
+
+  char* renamed[] = {"c1", "c2+1", NULL};
+  char* partial[] = {"t", NULL};
+  nb_fail += check_template(body, renamed, "C[c1+c2+1] = 2*(c1) + @x;");
+  nb_fail += check_template(body, partial, "C[t+@1@] = 2*(t) + @x;");
+  nb_fail += check_template(body, NULL, "C[@0@+@1@] = 2*(@0@) + @x;");
+
+  osl_body_free(body);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+  printf("\n");
+
+  return nb_fail;
+}
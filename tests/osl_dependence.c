@@ -0,0 +1,516 @@
+// (3-clause BSD license)
+// Redistribution and use in source  and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/generic.h>
+#include <osl/int.h>
+#include <osl/macros.h>
+#include <osl/memory.h>
+#include <osl/relation_list.h>
+#include <osl/scop.h>
+#include <osl/statement.h>
+#include <osl/extensions/dependence.h>
+
+
+#define NB_DEPENDENCES 2000
+#define NB_LABELS      20
+#define NB_TYPES       5
+#define NB_DEPTHS      5
+
+// Returns a pseudo-random integer in [0, n)
+static int next_random(unsigned int* const seed, const int n) {
+  *seed = *seed * 1103515245u + 12345u;
+  return (int)((*seed >> 16) % (unsigned int)n);
+}
+
+// Builds a dependence list with pseudo-random labels, types and depths
+static osl_dependence* random_dependences(const int nb) {
+  osl_dependence* list = NULL;
+  osl_dependence** last = &list;
+  unsigned int seed = 42;
+
+  for (int i = 0; i < nb; i++) {
+    *last = osl_dependence_malloc();
+    (*last)->label_source = next_random(&seed, NB_LABELS);
+    (*last)->label_target = next_random(&seed, NB_LABELS);
+    (*last)->type = next_random(&seed, NB_TYPES + 1);
+    (*last)->depth = next_random(&seed, NB_DEPTHS + 1) - 1;
+    if ((*last)->type == 0)
+      (*last)->type = OSL_UNDEFINED;
+    last = &(*last)->next;
+  }
+
+  return list;
+}
+
+// Checks if a dependence matches the criteria (OSL_UNDEFINED for any value)
+static int match(const osl_dependence* const d, const int label_source,
+                 const int label_target, const int type, const int depth) {
+  return ((label_source == OSL_UNDEFINED) ||
+          (d->label_source == label_source)) &&
+         ((label_target == OSL_UNDEFINED) ||
+          (d->label_target == label_target)) &&
+         ((type == OSL_UNDEFINED) || (d->type == type)) &&
+         ((depth == OSL_UNDEFINED) || (d->depth == depth));
+}
+
+// Checks a slice of the graph against a scan of the list
+static int check_slice(const osl_dependence* const list,
+                       const osl_dependence* const* slice, const int nb,
+                       const int label_source, const int label_target,
+                       const int type, const int depth) {
+  int i = 0;
+
+  for (const osl_dependence* d = list; d; d = d->next) {
+    if (match(d, label_source, label_target, type, depth)) {
+      if ((i >= nb) || (slice[i] != d)) {
+        printf("Slice (%d, %d, %d, %d) differs at %d\n", label_source,
+               label_target, type, depth, i);
+        return 1;
+      }
+      i++;
+    }
+  }
+
+  if (i != nb) {
+    printf("Slice (%d, %d, %d, %d) has %d dependences instead of %d\n",
+           label_source, label_target, type, depth, nb, i);
+    return 1;
+  }
+  return 0;
+}
+
+// Checks an iterator of the graph against a scan of the list
+static int check_iterator(const osl_dependence* const list,
+                          const osl_dependence_graph* const graph,
+                          const int label_source, const int label_target,
+                          const int type, const int depth) {
+  osl_dependence_iterator iterator;
+  const osl_dependence* d = list;
+
+  osl_dependence_iterator_init(&iterator, graph, label_source, label_target,
+                               type, depth);
+  for (const osl_dependence* e = osl_dependence_iterator_next(&iterator); e;
+       e = osl_dependence_iterator_next(&iterator)) {
+    while (d && !match(d, label_source, label_target, type, depth))
+      d = d->next;
+    if (e != d) {
+      printf("Iterator (%d, %d, %d, %d) differs from the list\n",
+             label_source, label_target, type, depth);
+      return 1;
+    }
+    d = d->next;
+  }
+
+  while (d && !match(d, label_source, label_target, type, depth))
+    d = d->next;
+  if (d) {
+    printf("Iterator (%d, %d, %d, %d) misses dependences\n", label_source,
+           label_target, type, depth);
+    return 1;
+  }
+  return 0;
+}
+
+// Builds a scop with statements having 1 + i % 4 accesses each
+static osl_scop* statements_with_accesses(const int nb) {
+  osl_scop* const scop = osl_scop_malloc();
+
+  for (int i = 0; i < nb; i++) {
+    osl_statement* const statement = osl_statement_malloc();
+    for (int j = 0; j <= i % 4; j++) {
+      osl_relation_list* const access = osl_relation_list_malloc();
+      access->elt = osl_relation_malloc(1, 3);
+      osl_relation_list_add(&statement->access, access);
+    }
+    osl_scop_statement_add(scop, statement);
+  }
+
+  return scop;
+}
+
+// Checks the pointers of a resolved dependence list by walking the lists
+static int check_resolve(osl_dependence* const list,
+                         const osl_scop* const scop) {
+  int nb_unresolved = 0;
+
+  for (const osl_dependence* d = list; d; d = d->next) {
+    const int labels[] = {d->label_source, d->label_target};
+    const int refs[] = {d->ref_source, d->ref_target};
+    const osl_statement* const statements[] = {d->stmt_source_ptr,
+                                               d->stmt_target_ptr};
+    const osl_relation* const accesses[] = {d->ref_source_access_ptr,
+                                            d->ref_target_access_ptr};
+    int resolved = 1;
+
+    for (int side = 0; side < 2; side++) {
+      const osl_statement* statement = scop->statement;
+      const osl_relation_list* access = NULL;
+      for (int i = 0; statement && (i < labels[side]); i++)
+        statement = statement->next;
+      if (labels[side] < 0)
+        statement = NULL;
+      if (statement && (refs[side] >= 0)) {
+        access = statement->access;
+        for (int i = 0; access && (i < refs[side]); i++)
+          access = access->next;
+      }
+
+      if ((statements[side] != statement) ||
+          (accesses[side] != (access ? access->elt : NULL))) {
+        printf("Dependence (%d, %d) is not correctly resolved\n",
+               d->label_source, d->label_target);
+        return 1;
+      }
+      resolved = resolved && access;
+    }
+    nb_unresolved += !resolved;
+  }
+
+  return nb_unresolved;
+}
+
+// Builds a dependence list whose domains are one of nb_domains relations
+static osl_dependence* dependences_with_domains(const int nb,
+                                                const int nb_domains) {
+  osl_dependence* list = NULL;
+  osl_dependence** last = &list;
+
+  for (int i = 0; i < nb; i++) {
+    *last = osl_dependence_malloc();
+    (*last)->type = 1 + i % NB_TYPES;
+    (*last)->depth = i % NB_DEPTHS;
+    (*last)->label_source = i % 3;
+    (*last)->label_target = i % 5;
+    (*last)->ref_source = 0;
+    (*last)->ref_target = 0;
+    (*last)->domain = osl_relation_malloc(2, 4);
+    (*last)->domain->type = OSL_TYPE_DOMAIN;
+    osl_relation_set_attributes((*last)->domain, 2, 0, 0, 0);
+    osl_int_set_si((*last)->domain->precision, &(*last)->domain->m[0][0], 1);
+    osl_int_set_si((*last)->domain->precision, &(*last)->domain->m[1][3],
+                   i % nb_domains);
+    last = &(*last)->next;
+  }
+
+  return list;
+}
+
+// Checks that the dependences with identical domains share them
+static int check_shared(const osl_dependence* const list,
+                        const int nb_domains) {
+  const osl_dependence* first[16] = {NULL};
+  int i = 0;
+
+  for (const osl_dependence* d = list; d; d = d->next, i++) {
+    const int k = i % nb_domains;
+    if (!first[k]) {
+      for (int j = 0; j < k; j++) {
+        if (first[j]->domain == d->domain) {
+          printf("Different domains are shared\n");
+          return 1;
+        }
+      }
+      first[k] = d;
+    } else if ((d->domain != first[k]->domain) || !d->shared_domain ||
+               (d->shared_domain != first[k]->shared_domain)) {
+      printf("Identical domains are not shared\n");
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+// Checks that the dependences of a list own their domains
+static int check_owned(const osl_dependence* const list) {
+  for (const osl_dependence* d = list; d; d = d->next) {
+    if (d->shared_domain || (d->next && (d->domain == d->next->domain))) {
+      printf("Domains are shared without being asked for\n");
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+// Checks a graph with huge labels, which keeps one slot per label in use
+static int check_sparse(void) {
+  const int huge[] = {INT_MAX, INT_MAX - 1, 1 << 30};
+  osl_dependence* const list = random_dependences(NB_DEPENDENCES);
+  int nb_fail = 0;
+  int i = 0;
+  int nb;
+
+  for (osl_dependence* d = list; d; d = d->next, i++) {
+    if (i % 7 == 0)
+      d->label_source = huge[i % 3];
+    if (i % 5 == 0)
+      d->label_target = huge[(i + 1) % 3];
+  }
+
+  osl_dependence_graph* const graph = osl_dependence_graph_build(list);
+  if ((graph->source.size > NB_DEPENDENCES) ||
+      (graph->target.size > NB_DEPENDENCES)) {
+    printf("Sparse labels have %d and %d slots\n", graph->source.size,
+           graph->target.size);
+    ++nb_fail;
+  }
+  for (int k = 0; k < NB_LABELS + 3; k++) {
+    const int label = (k < NB_LABELS) ? k : huge[k - NB_LABELS];
+    const osl_dependence* const* slice =
+        osl_dependence_graph_from(graph, label, &nb);
+    nb_fail += check_slice(list, slice, nb, label, OSL_UNDEFINED,
+                           OSL_UNDEFINED, OSL_UNDEFINED);
+    slice = osl_dependence_graph_to(graph, label, &nb);
+    nb_fail += check_slice(list, slice, nb, OSL_UNDEFINED, label,
+                           OSL_UNDEFINED, OSL_UNDEFINED);
+    nb_fail += check_iterator(list, graph, label, huge[0], OSL_UNDEFINED,
+                              OSL_UNDEFINED);
+  }
+  if (osl_dependence_graph_from(graph, INT_MAX - 2, &nb) || nb) {
+    printf("An unused huge label has dependences\n");
+    ++nb_fail;
+  }
+
+  osl_dependence_graph_free(graph);
+  osl_dependence_free(list);
+  return nb_fail;
+}
+
+// Checks that sharing the domains is opt-in, then sharing and unsharing
+static int check_sharing(void) {
+  int nb_fail = 0;
+  osl_dependence* const list = dependences_with_domains(300, 3);
+  char* const text = osl_dependence_sprint(list);
+  char* input = text;
+  osl_dependence* const read = osl_dependence_sread(&input);
+  osl_memory_usage owned = {0};
+  osl_memory_usage shared = {0};
+
+  // Read lists own their domains, which may be replaced as usual
+  nb_fail += check_owned(read);
+  osl_relation_free(read->domain);
+  read->domain = osl_relation_clone(list->domain);
+
+  osl_dependence_share_domains(read);
+  nb_fail += check_shared(read, 3);
+  osl_dependence* const clone = osl_dependence_clone(read);
+  nb_fail += check_owned(clone);
+  if (!osl_dependence_equal(list, read) || !osl_dependence_equal(read, clone)) {
+    printf("Shared domains change the dependences\n");
+    ++nb_fail;
+  }
+
+  osl_dependence_memory_usage(list, &owned);
+  osl_dependence_memory_usage(read, &shared);
+  if (3 * osl_memory_usage_total(&shared) >= osl_memory_usage_total(&owned)) {
+    printf("Shared domains take %zu bytes instead of %zu\n",
+           osl_memory_usage_total(&shared), osl_memory_usage_total(&owned));
+    ++nb_fail;
+  }
+
+  osl_dependence_share_domains(list);
+  nb_fail += check_shared(list, 3);
+
+  // Modifying an unshared domain leaves the others untouched
+  osl_dependence_unshare_domain(read->next);
+  osl_int_set_si(read->next->domain->precision, &read->next->domain->m[0][1],
+                 7);
+  if (osl_dependence_equal(list, read) || (read->next->shared_domain) ||
+      (read->next->domain == read->next->next->next->next->domain)) {
+    printf("Unsharing a domain failed\n");
+    ++nb_fail;
+  }
+
+  free(text);
+  osl_dependence_free(clone);
+  osl_dependence_free(read);
+  osl_dependence_free(list);
+  return nb_fail;
+}
+
+// Checks a cursor over some input against a filtered read of the whole
+// dependence list
+static int check_cursor(char* const text, char* const cursor_input,
+                        const int label_source,
+                        const int label_target, const int type,
+                        const int depth) {
+  int nb_fail = 0;
+  char* input = text;
+  osl_dependence* expected = osl_dependence_sread(&input);
+  osl_dependence* read = NULL;
+  osl_dependence** last = &read;
+  osl_dependence_cursor cursor;
+
+  for (osl_dependence** d = &expected; *d;) {
+    if (!match(*d, label_source, label_target, type, depth)) {
+      osl_dependence* const next = (*d)->next;
+      (*d)->next = NULL;
+      osl_dependence_free(*d);
+      *d = next;
+    } else {
+      d = &(*d)->next;
+    }
+  }
+
+  osl_dependence_cursor_init(&cursor, cursor_input, label_source, label_target,
+                             type, depth);
+  while ((*last = osl_dependence_cursor_next(&cursor)))
+    last = &(*last)->next;
+
+  if ((!expected != !read) ||
+      (expected && !osl_dependence_equal(expected, read))) {
+    printf("Cursor (%d, %d, %d, %d) differs from the list\n", label_source,
+           label_target, type, depth);
+    ++nb_fail;
+  }
+
+  osl_dependence_free(expected);
+  osl_dependence_free(read);
+  return nb_fail;
+}
+
+// Checks the cursors over a textual dependence list with unions
+static int check_cursors(void) {
+  int nb_fail = 0;
+  osl_dependence* const list = dependences_with_domains(60, 4);
+  char* text;
+  char* tagged;
+
+  for (osl_dependence* d = list; d; d = d->next)
+    if (d->depth == 2)
+      d->domain->next = osl_relation_clone(d->domain);
+  text = osl_dependence_sprint(list);
+  tagged = malloc(strlen(text) + 32);
+  sprintf(tagged, "<dependence>\n%s", text);
+
+  for (int s = -1; s < 3; s++)
+    for (int type = -1; type <= NB_TYPES; type++)
+      for (int depth = -1; depth < NB_DEPTHS; depth++)
+        nb_fail += check_cursor(text, text, s, OSL_UNDEFINED, type, depth);
+  for (int t = -1; t < 5; t++)
+    nb_fail += check_cursor(text, tagged, 1, t, OSL_UNDEFINED,
+                            OSL_UNDEFINED);
+
+  free(tagged);
+  free(text);
+  osl_dependence_free(list);
+  return nb_fail;
+}
+
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) { printf("argv are ignored\n"); }
+
+  int nb_fail = 0;
+  int nb;
+  osl_dependence* const list = random_dependences(NB_DEPENDENCES);
+  osl_dependence_graph* graph = osl_dependence_graph_build(list);
+  const osl_dependence* const* slice;
+
+  if (graph->nb_dependences != NB_DEPENDENCES) {
+    printf("Graph has %d dependences\n", graph->nb_dependences);
+    ++nb_fail;
+  }
+
+  // Slices, including keys out of range
+  for (int k = -2; k <= NB_LABELS; k++) {
+    slice = osl_dependence_graph_from(graph, k, &nb);
+    nb_fail += check_slice(list, slice, nb, k < 0 ? -2 : k, OSL_UNDEFINED,
+                           OSL_UNDEFINED, OSL_UNDEFINED);
+    slice = osl_dependence_graph_to(graph, k, &nb);
+    nb_fail += check_slice(list, slice, nb, OSL_UNDEFINED, k < 0 ? -2 : k,
+                           OSL_UNDEFINED, OSL_UNDEFINED);
+  }
+  for (int k = 0; k <= NB_TYPES + 1; k++) {
+    slice = osl_dependence_graph_of_type(graph, k, &nb);
+    nb_fail += check_slice(list, slice, nb, OSL_UNDEFINED, OSL_UNDEFINED, k,
+                           OSL_UNDEFINED);
+  }
+  for (int k = 0; k <= NB_DEPTHS; k++) {
+    slice = osl_dependence_graph_at_depth(graph, k, &nb);
+    nb_fail += check_slice(list, slice, nb, OSL_UNDEFINED, OSL_UNDEFINED,
+                           OSL_UNDEFINED, k);
+  }
+
+  // Iterators over every combination of criteria
+  for (int s = -1; s <= NB_LABELS; s++)
+    for (int t = -1; t < 3; t++)
+      for (int type = -1; type <= NB_TYPES; type++)
+        for (int depth = -1; depth < NB_DEPTHS; depth++)
+          nb_fail += check_iterator(list, graph, s, t, type, depth);
+
+  // Empty list
+  osl_dependence_graph_free(graph);
+  graph = osl_dependence_graph_build(NULL);
+  nb_fail += check_iterator(NULL, graph, OSL_UNDEFINED, OSL_UNDEFINED,
+                            OSL_UNDEFINED, OSL_UNDEFINED);
+  nb_fail += check_iterator(NULL, graph, 1, OSL_UNDEFINED, OSL_UNDEFINED, 0);
+  slice = osl_dependence_graph_from(graph, 0, &nb);
+  if (slice || nb) {
+    printf("Empty graph has dependences\n");
+    ++nb_fail;
+  }
+
+  osl_dependence_graph_free(graph);
+
+  // Resolution of the statement and access pointers, with labels and
+  // references out of range
+  osl_scop* const scop = statements_with_accesses(NB_LABELS - 2);
+  osl_generic_add(&scop->extension,
+                  osl_generic_shell(list, osl_dependence_interface()));
+  for (osl_dependence* d = list; d; d = d->next) {
+    d->ref_source = d->depth;
+    d->ref_target = d->label_source % 3;
+  }
+  nb = osl_scop_resolve_dependences(scop);
+  if (nb != check_resolve(list, scop)) {
+    printf("%d dependences are not resolved instead of %d\n", nb,
+           check_resolve(list, scop));
+    ++nb_fail;
+  }
+
+  osl_scop_free(scop);
+
+  // Sparse labels
+  nb_fail += check_sparse();
+
+  // Shared domains
+  nb_fail += check_sharing();
+
+  // Streaming reads
+  nb_fail += check_cursors();
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+  printf("\n");
+
+  return nb_fail;
+}
@@ -0,0 +1,273 @@
+// (3-clause BSD license)
+// Redistribution and use in source  and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/delta.h>
+#include <osl/error.h>
+#include <osl/interface.h>
+#include <osl/relation.h>
+#include <osl/scop.h>
+#include <osl/macros.h>
+
+
+static void count_handler(const char* message, const char* function,
+                          void* user) {
+  (void)message;
+  (void)function;
+  ++*(int*)user;
+}
+
+// Reads the input with osl_relation_psread_try and checks the outcome
+static int check_read(const char* const input, const bool expected) {
+  char* const string = malloc(strlen(input) + 1);
+  strcpy(string, input);
+  char* p_string = string;
+
+  osl_relation* relation = NULL;
+  const bool success =
+      osl_relation_psread_try(&p_string, OSL_PRECISION_MP, &relation);
+  int nb_fail = 0;
+
+  if (success != expected) {
+    printf("Unexpected result for:\n%s\n", input);
+    ++nb_fail;
+  }
+  if (success && relation == NULL) {
+    printf("Successful read without relation\n");
+    ++nb_fail;
+  }
+  if (!success && (relation != NULL || osl_error_message()[0] == '\0')) {
+    printf("Failed read without a clean state or an error message\n");
+    ++nb_fail;
+  }
+
+  osl_relation_free(relation);
+  free(string);
+  return nb_fail;
+}
+
+// Reads a scop with no statement and the given extensions, or with one
+// statement and the given statement extensions, with osl_scop_read_try and
+// checks the outcome (leaks are reported by the sanitizers)
+static int check_scop_read(const char* const extensions,
+                           const char* const statement_extensions,
+                           const bool expected) {
+  char* string = NULL;
+  size_t size = 0;
+  FILE* file = open_memstream(&string, &size);
+
+  fprintf(file, "<OpenScop>\nC\nCONTEXT\n0 2 0 0 0 0\n0\n");
+  if (statement_extensions)
+    fprintf(file, "1\n0\n1\n%s\n", statement_extensions);
+  else
+    fprintf(file, "0\n");
+  fprintf(file, "%s\n</OpenScop>\n", extensions);
+  fclose(file);
+
+  file = fmemopen(string, size, "r");
+  osl_scop* scop = NULL;
+  const bool success = osl_scop_read_try(file, &scop);
+  int nb_fail = 0;
+  fclose(file);
+
+  if (success != expected) {
+    printf("Unexpected result for:\n%s\n", string);
+    ++nb_fail;
+  }
+  if (!success && (scop != NULL || osl_error_message()[0] == '\0')) {
+    printf("Failed scop read without a clean state or an error message\n");
+    ++nb_fail;
+  }
+
+  osl_scop_free(scop);
+  free(string);
+  return nb_fail;
+}
+
+// Closes a file, as a cleanup function
+static void close_file(void* const file) {
+  fclose(file);
+}
+
+// Arguments and result of read_delta
+struct delta_read {
+  const char* input;
+  bool from_file;
+  osl_scop_delta* delta;
+};
+
+// Reads scop deltas from a string or a file, on behalf of check_delta_read
+static void read_delta(void* const data) {
+  struct delta_read* const args = data;
+  osl_interface* const registry = osl_interface_get_default_registry();
+
+  osl_error_protect(registry, (osl_error_cleanup_f)osl_interface_free);
+  if (args->from_file) {
+    FILE* const file =
+        fmemopen((void*)args->input, strlen(args->input), "r");
+    osl_error_protect(file, close_file);
+    args->delta = osl_scop_delta_pread(file, registry, OSL_PRECISION_MP);
+    osl_error_unprotect(file);
+    fclose(file);
+  } else {
+    char* string = malloc(strlen(args->input) + 1);
+    strcpy(string, args->input);
+    char* p_string = string;
+    osl_error_protect(string, free);
+    args->delta = osl_scop_delta_psread(&p_string, registry,
+                                        OSL_PRECISION_MP);
+    osl_error_unprotect(string);
+    free(string);
+  }
+  osl_error_unprotect(registry);
+  osl_interface_free(registry);
+}
+
+// Reads scop deltas from a string and from a file with osl_error_try and
+// checks the outcome (leaks are reported by the sanitizers)
+static int check_delta_read(const char* const input, const bool expected) {
+  int nb_fail = 0;
+
+  for (int from_file = 0; from_file < 2; from_file++) {
+    struct delta_read args = {input, from_file, NULL};
+    const bool success = osl_error_try(read_delta, &args);
+
+    if (success != expected) {
+      printf("Unexpected result for:\n%s\n", input);
+      ++nb_fail;
+    }
+    if (success && args.delta == NULL) {
+      printf("Successful delta read without delta\n");
+      ++nb_fail;
+    }
+    osl_scop_delta_free(args.delta);
+  }
+  return nb_fail;
+}
+
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) { printf("argv are ignored\n"); }
+
+  int nb_fail = 0;
+  int handler_calls = 0;
+
+  osl_error_set_handler(count_handler, &handler_calls);
+
+  // Well-formed unions
+  nb_fail += check_read(
+      "DOMAIN\n"
+      "2\n"
+      "2 3 1 0 0 1\n"
+      "1  1  0\n"
+      "1 -1  9\n"
+      "1 3 1 0 0 1\n"
+      "0  1 -2\n", true);
+
+  // Bad relation type
+  nb_fail += check_read("FOO\n1 3 1 0 0 1\n0 1 -2\n", false);
+
+  // Missing rows in the second part of a union (the first part is freed)
+  nb_fail += check_read(
+      "DOMAIN\n"
+      "2\n"
+      "1 3 1 0 0 1\n"
+      "0  1 -2\n"
+      "3 3 1 0 0 1\n"
+      "0  1 -2\n", false);
+
+  // Inconsistent column number
+  nb_fail += check_read("DOMAIN\n1 7 1 0 0 1\n0 1 -2\n", false);
+
+  // Well-formed extensions, and a stray closing tag which is ignored
+  nb_fail += check_scop_read(
+      "<loop>\n1\nt2\n1\n1\n(null)\n0\n</loop>\n"
+      "<coordinates>\nfile.c\n1 2 3 4\n0\n</coordinates>", NULL, true);
+  nb_fail += check_scop_read("</loop>", NULL, true);
+
+  // Malformed extensions (the partial structures are freed)
+  nb_fail += check_scop_read("<loop>\n2\nt2\n1\n1\n(null)\n0\nt3\nx\n</loop>",
+                             NULL, false);
+  nb_fail += check_scop_read(
+      "<symbols>\n1\nIterator\n0\n1\n<strings>\ni\n</strings>\nx\n"
+      "</symbols>", NULL, false);
+  nb_fail += check_scop_read("<coordinates>\nfile.c\n1 2 x\n</coordinates>",
+                             NULL, false);
+  nb_fail += check_scop_read("<dependence>\n1\nRAW\n1\n1\nx\n</dependence>",
+                             NULL, false);
+  nb_fail += check_scop_read("<pluto_unroll>\n1\ni\nx\n</pluto_unroll>", NULL,
+                             false);
+  nb_fail += check_scop_read(
+      "", "<extbody>\n2\n0 3\n6 x\n</extbody>", false);
+
+  // Well-formed scop deltas: a new statement, then the same scop
+  const char* const delta_begin = "<OpenScop-delta>\n1\n1\nC\n0\n-1\n";
+  const char* const delta_end = "1\nstrings\n-1\n</OpenScop-delta>\n";
+  const char* const delta_same =
+      "<OpenScop-delta>\n1\n-1\n0\n-1\n0\n-1\n-1\n</OpenScop-delta>\n";
+  char delta[1024];
+  snprintf(delta, sizeof(delta),
+           "%s1\n-1\n1\n1\n-1 1 3\n-1\n-1 -1 -1\n"
+           "DOMAIN\n1 3 1 0 0 0\n1 1 0\n0\n0\n-1\n%s%s",
+           delta_begin, delta_end, delta_same);
+  nb_fail += check_delta_read(delta, true);
+
+  // Malformed scop deltas (the partial structures are freed)
+  snprintf(delta, sizeof(delta),
+           "%s1\n-1\n1\n1\n-1 1 3\n-1\n-1 x\n",
+           delta_begin);
+  nb_fail += check_delta_read(delta, false);
+  snprintf(delta, sizeof(delta),
+           "%s%s1\n-1\n1\n1\n-1 1 4\n-1\n-1 -1 -1 -1\n"
+           "DOMAIN\n1 3 1 0 0 0\n1 1 0\n</OpenScop-delta>\n",
+           delta_same, delta_begin);
+  nb_fail += check_delta_read(delta, false);
+  snprintf(delta, sizeof(delta),
+           "%s1\n-1\n0\n0\n1\n1\n-1 x\n</OpenScop-delta>\n",
+           delta_begin);
+  nb_fail += check_delta_read(delta, false);
+  snprintf(delta, sizeof(delta), "%s0\n2\nstrings\nbody\n2\n0 x\n"
+           "</OpenScop-delta>\n", delta_begin);
+  nb_fail += check_delta_read(delta, false);
+  snprintf(delta, sizeof(delta), "%s%s0\n-1\n1\n-1\n<unknown>\n"
+           "</unknown>\n</OpenScop-delta>\n", delta_same, delta_begin);
+  nb_fail += check_delta_read(delta, false);
+
+  if (handler_calls != 19) {
+    printf("The error handler has been called %d times\n", handler_calls);
+    ++nb_fail;
+  }
+
+  osl_error_set_handler(NULL, NULL);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+  printf("\n");
+
+  return nb_fail;
+}
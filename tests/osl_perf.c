@@ -0,0 +1,151 @@
+// (3-clause BSD license)
+// Redistribution and use in source  and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/interface.h>
+#include <osl/macros.h>
+#include <osl/perf.h>
+#include <osl/relation.h>
+#include <osl/scop.h>
+
+static const char test_scop[] =
+    "<OpenScop>\n"
+    "C\n"
+    "CONTEXT\n"
+    "0 2 0 0 0 0\n"
+    "0\n"
+    "1\n"
+    "2\n"
+    "DOMAIN\n"
+    "2 3 1 0 0 0\n"
+    "1  1  0\n"
+    "1 -1  9\n"
+    "SCATTERING\n"
+    "1 4 1 1 0 0\n"
+    "0 -1  1  0\n"
+    "1\n"
+    "<body>\n"
+    "1\n"
+    "i\n"
+    "x += i;\n"
+    "</body>\n"
+    "</OpenScop>\n";
+
+// Reads, prints, clones and compares the test scop
+static void test_round(void) {
+  FILE* const input = fmemopen((void*)test_scop, strlen(test_scop), "r");
+  osl_interface* const registry = osl_interface_get_default_registry();
+  osl_scop* const scop = osl_scop_pread(input, registry, OSL_PRECISION_DP);
+  fclose(input);
+  osl_interface_free(registry);
+
+  osl_scop* const clone = osl_scop_clone(scop);
+  osl_relation_set_precision(OSL_PRECISION_SP, clone->context);
+  if (!osl_scop_equal(scop, scop))
+    printf("A scop is not equal to itself\n");
+
+  char* string = NULL;
+  size_t size = 0;
+  FILE* const output = open_memstream(&string, &size);
+  osl_scop_print(output, clone);
+  fclose(output);
+
+  free(string);
+  osl_scop_free(clone);
+  osl_scop_free(scop);
+}
+
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) { printf("argv are ignored\n"); }
+
+  int nb_fail = 0;
+  osl_perf_counter counter;
+
+  // Nothing is measured while the counters are disabled.
+  osl_perf_enable(false);
+  test_round();
+  for (int i = 0; i < OSL_PERF_NB_PHASES; i++) {
+    osl_perf_get(i, &counter);
+    if (counter.calls || counter.bytes_requested || counter.nanoseconds) {
+      printf("Phase %s measured while disabled\n", osl_perf_phase_name(i));
+      ++nb_fail;
+    }
+  }
+
+  osl_perf_enable(true);
+  test_round();
+  test_round();
+  osl_perf_enable(false);
+
+  // Each round reads the body and then the closing tag ending the extensions.
+  const int expected[][2] = {
+    {OSL_PERF_RELATION_READ, 6},  {OSL_PERF_GENERIC_READ, 4},
+    {OSL_PERF_STATEMENT_READ, 2}, {OSL_PERF_SCOP_READ, 2},
+    {OSL_PERF_SCOP_PRINT, 2},     {OSL_PERF_SCOP_CLONE, 2},
+    {OSL_PERF_SCOP_EQUAL, 2},     {OSL_PERF_PRECISION, 2},
+  };
+  for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+    osl_perf_get(expected[i][0], &counter);
+    if (counter.calls != (unsigned long long)expected[i][1]) {
+      printf("Phase %s: %llu call(s) instead of %d\n",
+             osl_perf_phase_name(expected[i][0]), counter.calls,
+             expected[i][1]);
+      ++nb_fail;
+    }
+  }
+  osl_perf_get(OSL_PERF_SCOP_READ, &counter);
+  if (counter.bytes_requested == 0 || counter.nanoseconds == 0) {
+    printf("The scop read has no allocation or no time\n");
+    ++nb_fail;
+  }
+
+  char* const json = osl_perf_sprint_json();
+  for (int i = 0; i < OSL_PERF_NB_PHASES; i++) {
+    if (strstr(json, osl_perf_phase_name(i)) == NULL) {
+      printf("Phase %s missing in the JSON output\n", osl_perf_phase_name(i));
+      ++nb_fail;
+    }
+  }
+  free(json);
+
+  osl_perf_reset();
+  osl_perf_get(OSL_PERF_SCOP_READ, &counter);
+  if (counter.calls) {
+    printf("The counters are not reset\n");
+    ++nb_fail;
+  }
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+  printf("\n");
+
+  return nb_fail;
+}
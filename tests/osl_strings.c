@@ -0,0 +1,149 @@
+// (3-clause BSD license)
+// Redistribution and use in source  and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. The name of the author may not be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/strings.h>
+#include <osl/util.h>
+
+
+// Checks the position of each string and the size of the strings structure
+static int check_find(const osl_strings* const strings, char** expected,
+                      const size_t size) {
+  int nb_fail = 0;
+
+  if (osl_strings_size(strings) != size) {
+    printf("Size %zu instead of %zu\n", osl_strings_size(strings), size);
+    ++nb_fail;
+  }
+  for (size_t i = 0; expected[i]; i++) {
+    const size_t position = osl_strings_find(strings, expected[i]);
+    if (position != i) {
+      printf("\"%s\" found at %zu instead of %zu\n", expected[i], position, i);
+      ++nb_fail;
+    }
+  }
+  if (osl_strings_find(strings, "missing") != size) {
+    printf("A missing string is found\n");
+    ++nb_fail;
+  }
+  return nb_fail;
+}
+
+// Checks that the strings structure has an index over its current array
+static int check_indexed(const osl_strings* const strings) {
+  const osl_strings_index* const index = strings->index;
+
+  if (!index || (index->string != strings->string) ||
+      (index->size != osl_strings_size(strings)) ||
+      (index->capacity < index->size + 1) ||
+      (index->nb_buckets < 2 * index->size)) {
+    printf("The index does not follow the strings\n");
+    return 1;
+  }
+  return 0;
+}
+
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) { printf("argv are ignored\n"); }
+
+  int nb_fail = 0;
+  char* abc[] = {"a", "b", "c", NULL};
+
+  // Find, add and size with an index.
+  osl_strings* strings = osl_strings_encapsulate(osl_util_strdup("a"));
+  osl_strings_add(strings, "b");
+  osl_strings_build_index(strings);
+  osl_strings_add(strings, "c");
+  nb_fail += check_indexed(strings);
+  nb_fail += check_find(strings, abc, 3);
+
+  // Growth of the array and rehash of the index.
+  enum { nb_added = 1000 };
+  char* names[3 + nb_added + 1] = {"a", "b", "c"};
+  char buffer[16];
+  const size_t nb_buckets = strings->index->nb_buckets;
+  for (int i = 0; i < nb_added; i++) {
+    snprintf(buffer, sizeof(buffer), "s%d", i);
+    osl_strings_add(strings, buffer);
+    names[3 + i] = osl_util_strdup(buffer);
+  }
+  names[3 + nb_added] = NULL;
+  nb_fail += check_indexed(strings);
+  nb_fail += check_find(strings, names, 3 + nb_added);
+  if (strings->index->nb_buckets <= nb_buckets) {
+    printf("The index has not been rehashed\n");
+    ++nb_fail;
+  }
+
+  // Duplicates are found at their first position.
+  osl_strings_add(strings, "b");
+  nb_fail += check_indexed(strings);
+  if ((osl_strings_find(strings, "b") != 1) ||
+      (osl_strings_size(strings) != 3 + nb_added + 1)) {
+    printf("A duplicate is not found at its first position\n");
+    ++nb_fail;
+  }
+
+  // Linear fallback when the array is shrunk in place...
+  free(strings->string[3 + nb_added]);
+  strings->string[3 + nb_added] = NULL;
+  for (int i = nb_added - 1; i >= 0; i--) {
+    free(strings->string[3 + i]);
+    strings->string[3 + i] = NULL;
+  }
+  strings->string = realloc(strings->string, 4 * sizeof(char*));
+  osl_strings_touch(strings);
+  nb_fail += check_find(strings, abc, 3);
+
+  // ... or replaced, and rebuilt index on the next addition.
+  for (int i = 0; strings->string[i]; i++)
+    free(strings->string[i]);
+  free(strings->string);
+  strings->string = malloc(3 * sizeof(char*));
+  strings->string[0] = osl_util_strdup("x");
+  strings->string[1] = osl_util_strdup("y");
+  strings->string[2] = NULL;
+  osl_strings_touch(strings);
+  char* xy[] = {"x", "y", NULL};
+  char* xyz[] = {"x", "y", "z", NULL};
+  nb_fail += check_find(strings, xy, 2);
+  osl_strings_add(strings, "z");
+  nb_fail += check_indexed(strings);
+  nb_fail += check_find(strings, xyz, 3);
+
+  for (int i = 0; i < nb_added; i++)
+    free(names[3 + i]);
+  osl_strings_free(strings);
+
+  printf("%s ", argv[0]);
+  printf("fails = %d\n", nb_fail);
+  printf("\n");
+
+  return nb_fail;
+}
@@ -123,25 +123,464 @@ static int test_unions(osl_scop* scop) {
   return 1;
 }
 
+/// Check that the union iterator gives the statements of remove_unions
+/// without copying the accesses and extensions.
+static int test_union_iterator(osl_scop* scop) {
+  osl_scop* nounion_scop = osl_scop_remove_unions(scop);
+  osl_scop* nounion_scop_first = nounion_scop;
+  osl_statement_union_iterator iterator;
+  const osl_statement* view;
+  osl_statement* nounion_stmt;
+  int result = 1;
+
+  for ( ; scop != NULL && nounion_scop != NULL && result;
+       scop = scop->next, nounion_scop = nounion_scop->next) {
+    nounion_stmt = nounion_scop->statement;
+    osl_statement_union_iterator_init(&iterator, scop->statement);
+    while (result && (view = osl_statement_union_iterator_next(&iterator))) {
+      result = nounion_stmt != NULL &&
+               osl_relation_equal(view->domain, nounion_stmt->domain) &&
+               osl_relation_equal(view->scattering, nounion_stmt->scattering) &&
+               view->access == iterator.origin->access &&
+               view->extension == iterator.origin->extension &&
+               view->next == NULL;
+      if (result)
+        nounion_stmt = nounion_stmt->next;
+    }
+    result = result && nounion_stmt == NULL;
+  }
+  osl_scop_free(nounion_scop_first);
+  return result;
+}
+
+/// Check that the in-place scattering normalization gives the same relations
+/// as the extension of copies.
+static int test_normalize_scattering(osl_scop* scop) {
+  osl_scop* normalized = osl_scop_clone(scop);
+  osl_scop* normalized_first = normalized;
+  osl_statement* stmt;
+  osl_statement* normalized_stmt;
+  osl_relation* extended;
+  int max_scattering_dims;
+  int result = 1;
+
+  osl_scop_normalize_scattering_all(normalized);
+  for ( ; scop != NULL && result; scop = scop->next,
+       normalized = normalized->next) {
+    max_scattering_dims = 0;
+    for (stmt = scop->statement; stmt != NULL; stmt = stmt->next)
+      if (stmt->scattering != NULL &&
+          stmt->scattering->nb_output_dims > max_scattering_dims)
+        max_scattering_dims = stmt->scattering->nb_output_dims;
+
+    normalized_stmt = normalized->statement;
+    for (stmt = scop->statement; stmt != NULL && result; stmt = stmt->next) {
+      extended = NULL;
+      if (stmt->scattering != NULL)
+        extended = osl_relation_extend_output(stmt->scattering,
+                                              max_scattering_dims);
+      result = osl_relation_equal(extended, normalized_stmt->scattering);
+      osl_relation_free(extended);
+      normalized_stmt = normalized_stmt->next;
+    }
+  }
+  osl_scop_free(normalized_first);
+  return result;
+}
+
+/// Check that indexed statement accesses agree with the statement lists,
+/// including after appends and after a removal.
+static int test_statement_index(osl_scop* scop) {
+  osl_scop* clone = osl_scop_clone(scop);
+  osl_scop* clone_first = clone;
+  osl_statement* stmt;
+  int number;
+  int i;
+  int result = 1;
+
+  for ( ; clone != NULL && result; clone = clone->next) {
+    number = osl_statement_number(clone->statement);
+    // Append a copy of the list, then a copy of its first statement directly.
+    osl_scop_statement_add(clone, osl_statement_clone(clone->statement));
+    osl_statement_add(&clone->statement,
+                      osl_statement_nclone(clone->statement, 1));
+    number = 2 * number + (number > 0);
+
+    for (i = 0; i < 2 && result; i++) {
+      result = osl_scop_statement_number(clone) == number &&
+               osl_scop_statement_get(clone, -1) == NULL &&
+               osl_scop_statement_get(clone, number) == NULL;
+      stmt = clone->statement;
+      for (number = 0; stmt != NULL && result; stmt = stmt->next, number++)
+        result = osl_scop_statement_get(clone, number) == stmt;
+      osl_scop_statement_invalidate(clone);
+    }
+
+    // Remove the last statement directly, once the list is indexed.
+    if (result && number > 1 && osl_scop_statement_number(clone) == number) {
+      stmt = osl_scop_statement_get(clone, number - 2);
+      osl_statement_free(stmt->next);
+      stmt->next = NULL;
+      osl_statement_touch(clone->statement);
+      result = osl_scop_statement_number(clone) == number - 1 &&
+               osl_scop_statement_get(clone, number - 2) == stmt &&
+               osl_scop_statement_get(clone, number - 1) == NULL;
+    }
+  }
+  osl_scop_free(clone_first);
+  return result;
+}
+
+/// Check that patching a scop with its delta to a target, after a print/read
+/// round trip of the delta, rebuilds the target.
+static int test_diff_patch_text(osl_scop* scop, osl_scop* target) {
+  osl_scop_delta* delta = osl_scop_diff(scop, target);
+  osl_interface* registry;
+  osl_scop* patched;
+  char* string;
+  char* input;
+  int result;
+
+  string = osl_scop_delta_sprint(delta);
+  osl_scop_delta_free(delta);
+  input = string;
+  registry = osl_interface_get_default_registry();
+  delta = osl_scop_delta_psread(&input, registry, osl_util_get_precision());
+  osl_interface_free(registry);
+  osl_allocator_free(string);
+  patched = osl_scop_patch(scop, delta);
+  result = osl_scop_equal(patched, target);
+  osl_scop_free(patched);
+  osl_scop_delta_free(delta);
+  return result;
+}
+
+/// Check that patching a scop with its delta to a modified copy, before and
+/// after a print/read round trip of the delta, rebuilds the modified copy.
+static int test_diff_patch(osl_scop* scop) {
+  osl_scop* target = osl_scop_clone(scop);
+  osl_scop* modified;
+  osl_scop* patched;
+  osl_scop_delta* delta;
+  osl_relation* domain;
+  osl_relation* relation;
+  osl_relation_list* access;
+  int result;
+
+  // Edit rows, columns, accesses, extensions and the language of the copy.
+  osl_scop_normalize_scattering_all(target);
+  for (modified = target; modified != NULL; modified = modified->next) {
+    osl_allocator_free(modified->language);
+    modified->language = osl_util_strdup("diff");
+    osl_generic_remove(&modified->extension, OSL_URI_SCATNAMES);
+    if (modified->statement == NULL)
+      continue;
+    domain = modified->statement->domain;
+    if (domain != NULL && domain->nb_rows > 0) {
+      osl_relation_remove_row(domain, 0);
+      osl_relation_insert_blank_row(domain, domain->nb_rows);
+      osl_int_set_si(domain->precision,
+                     &domain->m[domain->nb_rows - 1][domain->nb_columns - 1],
+                     7);
+    }
+    access = modified->statement->access;
+    if (access != NULL && access->next != NULL) {
+      modified->statement->access = access->next;
+      access->next = NULL;
+      osl_relation_list_free(access);
+    }
+    // The new row is literal while the array identifier row is not.
+    access = modified->statement->access;
+    relation = access != NULL ? access->elt : NULL;
+    if (relation != NULL) {
+      osl_relation_insert_blank_row(relation, relation->nb_rows);
+      osl_int_set_si(
+          relation->precision,
+          &relation->m[relation->nb_rows - 1][relation->nb_columns - 1], 3);
+    }
+  }
+
+  delta = osl_scop_diff(scop, target);
+  patched = osl_scop_patch(scop, delta);
+  result = osl_scop_equal(patched, target);
+  osl_scop_free(patched);
+  osl_scop_delta_free(delta);
+  result = result && test_diff_patch_text(scop, target);
+
+  // The language may also be removed.
+  for (modified = target; modified != NULL; modified = modified->next) {
+    osl_allocator_free(modified->language);
+    modified->language = NULL;
+  }
+  result = result && test_diff_patch_text(scop, target);
+
+  // The target list may be longer than the source one.
+  osl_scop_free(target);
+  target = osl_scop_clone(scop);
+  osl_scop_add(&target, osl_scop_clone(scop));
+  result = result && test_diff_patch_text(scop, target);
+
+  delta = osl_scop_diff(scop, scop);
+  patched = osl_scop_patch(scop, delta);
+  result = result && osl_scop_equal(patched, scop);
+  osl_scop_free(patched);
+  osl_scop_delta_free(delta);
+
+  osl_scop_free(target);
+  return result;
+}
+
+/// Print a scop list into a freshly allocated string.
+static char* test_print(const osl_scop* scop) {
+  char* string = NULL;
+  size_t size = 0;
+  FILE* output = open_memstream(&string, &size);
+
+  osl_scop_print(output, scop);
+  fclose(output);
+  return string;
+}
+
+/// Check that a scop printed with a print cache gives the same text as a
+/// fresh copy of the scop (which has no cache).
+static int test_print_cache_same(osl_scop* cached) {
+  osl_scop* copy = osl_scop_clone(cached);
+  char* cached_text = test_print(cached);
+  char* copy_text = test_print(copy);
+  int result = strcmp(cached_text, copy_text) == 0;
+
+  free(cached_text);
+  free(copy_text);
+  osl_scop_free(copy);
+  return result;
+}
+
+/// Check that the print cache follows the modifications through the library
+/// and the touched ones, and that it is actually used for the others.
+static int test_print_cache(osl_scop* scop) {
+  osl_scop* cached = osl_scop_clone(scop);
+  osl_scop* modified;
+  osl_relation* relation;
+  int changed = 0;
+  int result;
+
+  osl_scop_enable_print_cache(cached);
+  result = test_print_cache_same(cached);
+
+  // A part freed then reallocated (likely at the same address) is detected.
+  for (modified = cached; modified != NULL; modified = modified->next) {
+    if (modified->statement == NULL || modified->statement->domain == NULL ||
+        modified->statement->domain->nb_rows == 0)
+      continue;
+    relation = osl_relation_clone(modified->statement->domain);
+    osl_int_set_si(relation->precision,
+                   &relation->m[0][relation->nb_columns - 1], 13);
+    osl_relation_free(modified->statement->domain);
+    modified->statement->domain = osl_relation_clone(relation);
+    osl_relation_free(relation);
+  }
+  result = result && test_print_cache_same(cached);
+
+  // A modification through the library is detected.
+  for (modified = cached; modified != NULL; modified = modified->next)
+    if (modified->statement != NULL &&
+        modified->statement->domain != NULL &&
+        modified->statement->domain->nb_rows > 0)
+      osl_relation_remove_row(modified->statement->domain, 0);
+  result = result && test_print_cache_same(cached);
+
+  // A direct modification is not, until the relation is touched.
+  for (modified = cached; modified != NULL; modified = modified->next) {
+    if (modified->statement == NULL)
+      continue;
+    relation = modified->statement->scattering;
+    if (relation != NULL && relation->nb_rows > 0) {
+      osl_int_set_si(relation->precision,
+                     &relation->m[0][relation->nb_columns - 1], 42);
+      changed = 1;
+    }
+  }
+  result = result && (!changed || !test_print_cache_same(cached));
+  for (modified = cached; modified != NULL; modified = modified->next)
+    if (modified->statement != NULL)
+      osl_relation_touch(modified->statement->scattering);
+  result = result && test_print_cache_same(cached);
+
+  osl_scop_free(cached);
+  return result;
+}
+
+/// Check that indexed extension lookups agree with list lookups.
+static int test_extension_index(osl_scop* scop) {
+  const char* const URIs[] = {OSL_URI_ARRAYS, OSL_URI_BODY,      OSL_URI_LOOP,
+                              OSL_URI_SCATNAMES, OSL_URI_SYMBOLS, "unknown"};
+  const size_t nb_URIs = sizeof(URIs) / sizeof(*URIs);
+  osl_statement* stmt;
+  size_t i;
+
+  for ( ; scop != NULL; scop = scop->next) {
+    for (i = 0; i < nb_URIs; i++) {
+      if (osl_scop_extension_lookup(scop, URIs[i]) !=
+          osl_generic_lookup(scop->extension, URIs[i]))
+        return 0;
+      for (stmt = scop->statement; stmt != NULL; stmt = stmt->next)
+        if (osl_statement_extension_lookup(stmt, URIs[i]) !=
+            osl_generic_lookup(stmt->extension, URIs[i]))
+          return 0;
+    }
+  }
+  return 1;
+}
+
+/// Add a new comment extension to a scop and return its data.
+static osl_comment* test_add_comment(osl_scop* scop) {
+  osl_comment* comment = osl_comment_malloc();
+  osl_generic_add(&scop->extension,
+                  osl_generic_shell(comment, osl_comment_interface()));
+  return comment;
+}
+
+/// Check that the extension lookups of a scop follow the additions and
+/// removals of extensions behind the head of its extension list.
+static int test_extension_index_update(const osl_scop* scop) {
+  osl_scop* clone = osl_scop_clone(scop);
+  osl_comment* comment;
+  int result = 1;
+
+  if (clone == NULL)
+    return 1;
+  osl_generic_remove(&clone->extension, OSL_URI_COMMENT);
+  if (clone->extension == NULL)
+    osl_generic_add(&clone->extension,
+                    osl_generic_shell(osl_clay_malloc(), osl_clay_interface()));
+
+  result = result && !osl_scop_extension_lookup(clone, OSL_URI_COMMENT);
+  comment = test_add_comment(clone);
+  result = result && osl_scop_extension_lookup(clone, OSL_URI_COMMENT) ==
+                         comment;
+  osl_generic_remove(&clone->extension, OSL_URI_COMMENT);
+  result = result && !osl_scop_extension_lookup(clone, OSL_URI_COMMENT);
+  comment = test_add_comment(clone);
+  result = result && osl_scop_extension_lookup(clone, OSL_URI_COMMENT) ==
+                         comment;
+
+  osl_scop_free(clone);
+  return result;
+}
+
+/// Check that the indexed array lookups agree with linear scans.
+static int test_arrays_index_same(const osl_arrays* arrays) {
+  int i, j;
+
+  for (i = 0; i < arrays->nb_names; i++) {
+    for (j = 0; arrays->id[j] != arrays->id[i]; j++)
+      ;
+    if (osl_arrays_get_index_from_id(arrays, arrays->id[i]) != (size_t)j)
+      return 0;
+    for (j = 0; strcmp(arrays->names[j], arrays->names[i]); j++)
+      ;
+    if (osl_arrays_get_index_from_name(arrays, arrays->names[i]) != (size_t)j)
+      return 0;
+  }
+  return (osl_arrays_get_index_from_name(arrays, "unknown") ==
+          (size_t)arrays->nb_names) &&
+         (osl_arrays_get_index_from_id(arrays, -42) ==
+          (size_t)arrays->nb_names);
+}
+
+/// Check that the indexed symbol lookups agree with linear scans.
+static int test_symbols_index_same(osl_symbols* symbols) {
+  osl_symbols* s;
+  osl_symbols* first;
+
+  for (s = symbols; s != NULL; s = s->next) {
+    for (first = symbols; !osl_generic_equal(first->identifier, s->identifier);
+         first = first->next)
+      ;
+    if (osl_symbols_lookup(symbols, s->identifier) != first)
+      return 0;
+  }
+  return 1;
+}
+
+/// Check the hash indexes of the arrays and symbols extensions.
+static int test_arrays_symbols_index(osl_scop* scop) {
+  osl_arrays* arrays;
+  osl_symbols* symbols;
+  osl_symbols* removed;
+  char name[OSL_MAX_STRING];
+  int result = 1;
+  int i;
+
+  for ( ; scop != NULL; scop = scop->next) {
+    arrays = osl_arrays_clone(osl_generic_lookup(scop->extension,
+                                                 OSL_URI_ARRAYS));
+    if (arrays != NULL) {
+      result = result && test_arrays_index_same(arrays);
+      for (i = 0; i < 100; i++) {
+        snprintf(name, OSL_MAX_STRING, "extra_%d", i % 60);
+        osl_arrays_add(arrays, 1000 + i % 70, name);
+      }
+      result = result && test_arrays_index_same(arrays);
+      osl_allocator_free(arrays->names[0]);
+      arrays->names[0] = osl_util_strdup("renamed");
+      osl_arrays_invalidate(arrays);
+      result = result && test_arrays_index_same(arrays);
+      osl_arrays_free(arrays);
+    }
+
+    symbols = osl_symbols_clone(osl_generic_lookup(scop->extension,
+                                                   OSL_URI_SYMBOLS));
+    if (symbols != NULL) {
+      result = result && test_symbols_index_same(symbols);
+      osl_symbols_add(&symbols, osl_symbols_clone(symbols));
+      result = result && test_symbols_index_same(symbols);
+      removed = osl_symbols_remove(&symbols, symbols);
+      result = result && (removed != NULL) && (removed->next == NULL) &&
+               test_symbols_index_same(symbols);
+      osl_symbols_add(&symbols, removed);
+      result = result && test_symbols_index_same(symbols) &&
+               (osl_symbols_lookup(symbols, NULL) == NULL);
+      osl_symbols_free(symbols);
+    }
+  }
+  return result;
+}
+
+/// Report the result of a check and return it.
+static int test_report(const char* check, int result) {
+  printf("- %s %s\n", check, result ? "succeeded" : "failed");
+  return result;
+}
+
 /**
  * test_file function
- * This function tests an onpenscop file. A test has six steps:
+ * This function tests an onpenscop file. A test has seven steps:
  * 1. read the file to raise the data up to OpenScop data structures,
  * 2. clone the data structures,
  * 3. compare the clone and the original one,
  * 4. dump the data structures to a new OpenScop file,
  * 5. read the generated file,
- * 6. compare the data structures.
- * If everything went well, the data structure of the two scops are the same.
+ * 6. compare the data structures,
+ * 7. check the other functions on the data structures, each on its own.
+ * If everything went well, the data structure of the two scops are the same
+ * and every check succeeded.
  * \param input_name The name of the input file.
  * \param verbose    Verbose option (1 to set, 0 not to set).
  * \return 1 if the test is successful, 0 otherwise.
  */
 static int test_file(char* input_name, int verbose) {
-  int cloning = 0;
-  int dumping = 0;
-  int equal   = 0;
-  int unions  = 0;
+  int cloning     = 0;
+  int dumping     = 0;
+  int equal       = 0;
+  int unions      = 0;
+  int iterating   = 0;
+  int normalizing = 0;
+  int indexing    = 0;
+  int caching     = 0;
+  int patching    = 0;
+  int lookups     = 0;
+  int hashing     = 0;
   FILE* input_file;
   FILE* output_file;
   osl_scop* input_scop;
@@ -198,11 +637,28 @@ static int test_file(char* input_name, int verbose) {
   else
     printf("- dumping failed\n");
 
-  // PART V. Remove unions.
-  unions = test_unions(input_scop);
+  // PART IV. Remove unions and normalize.
+  unions      = test_report("removing unions", test_unions(input_scop));
+  iterating   = test_report("union iterator",
+                            test_union_iterator(input_scop));
+  normalizing = test_report("scattering normalization",
+                            test_normalize_scattering(input_scop));
+
+  // PART V. Statement index, print cache, diff and patch.
+  indexing = test_report("statement index", test_statement_index(input_scop));
+  caching  = test_report("print cache", test_print_cache(input_scop));
+  patching = test_report("diff and patch", test_diff_patch(input_scop));
+
+  // PART VI. Indexed extension lookups.
+  lookups = test_report("indexed lookup",
+                        test_extension_index(input_scop) &&
+                        test_extension_index_update(input_scop));
+  hashing = test_report("arrays and symbols index",
+                        test_arrays_symbols_index(input_scop));
 
-  // PART IV. Report.
-  if ((equal = (cloning + dumping + unions > 2) ? 1 : 0))
+  // PART VII. Report.
+  if ((equal = cloning && dumping && unions && iterating && normalizing &&
+               indexing && caching && patching && lookups && hashing))
     printf("Success :-)\n");
   else
     printf("Failure :-(\n");
@@ -0,0 +1,311 @@
+/******************************************************************************
+ **                            OpenScop Library                              **
+ **--------------------------------------------------------------------------**
+ **                              osl_threads.c                               **
+ **--------------------------------------------------------------------------**
+ **                        First version: 18/10/2026                         **
+ ******************************************************************************/
+
+/******************************************************************************
+ * OpenScop: Structures and formats for polyhedral tools to talk together     *
+ ******************************************************************************
+ *    ,___,,_,__,,__,,__,,__,,_,__,,_,__,,__,,___,_,__,,_,__,                 *
+ *    /   / /  //  //  //  // /   / /  //  //   / /  // /  /|,_,              *
+ *   /   / /  //  //  //  // /   / /  //  //   / /  // /  / / /\              *
+ *  |~~~|~|~~~|~~~|~~~|~~~|~|~~~|~|~~~|~~~|~~~|~|~~~|~|~~~|/_/  \             *
+ *  | G |C| P | = | L | P |=| = |C| = | = | = |=| = |=| C |\  \ /\            *
+ *  | R |l| o | = | e | l |=| = |a| = | = | = |=| = |=| L | \# \ /\           *
+ *  | A |a| l | = | t | u |=| = |n| = | = | = |=| = |=| o | |\# \  \          *
+ *  | P |n| l | = | s | t |=| = |d| = | = | = | |   |=| o | | \# \  \         *
+ *  | H | | y |   | e | o | | = |l|   |   | = | |   | | G | |  \  \  \        *
+ *  | I | |   |   | e |   | |   | |   |   |   | |   | |   | |   \  \  \       *
+ *  | T | |   |   |   |   | |   | |   |   |   | |   | |   | |    \  \  \      *
+ *  | E | |   |   |   |   | |   | |   |   |   | |   | |   | |     \  \  \     *
+ *  | * |*| * | * | * | * |*| * |*| * | * | * |*| * |*| * | /      \* \  \    *
+ *  | O |p| e | n | S | c |o| p |-| L | i | b |r| a |r| y |/        \  \ /    *
+ *  '---'-'---'---'---'---'-'---'-'---'---'---'-'---'-'---'          '--'     *
+ *                                                                            *
+ * Copyright (C) 2008 University Paris-Sud 11 and INRIA                       *
+ *                                                                            *
+ * (3-clause BSD license)                                                     *
+ * Redistribution and use in source  and binary forms, with or without        *
+ * modification, are permitted provided that the following conditions         *
+ * are met:                                                                   *
+ *                                                                            *
+ * 1. Redistributions of source code must retain the above copyright notice,  *
+ *    this list of conditions and the following disclaimer.                   *
+ * 2. Redistributions in binary form must reproduce the above copyright       *
+ *    notice, this list of conditions and the following disclaimer in the     *
+ *    documentation and/or other materials provided with the distribution.    *
+ * 3. The name of the author may not be used to endorse or promote products   *
+ *    derived from this software without specific prior written permission.   *
+ *                                                                            *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR       *
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES  *
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.    *
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,           *
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT   *
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,  *
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY      *
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT        *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF   *
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.          *
+ *                                                                            *
+ * OpenScop Library, a library to manipulate OpenScop formats and data        *
+ * structures. Written by:                                                    *
+ * Cedric Bastoul     <Cedric.Bastoul@u-psud.fr> and                          *
+ * Louis-Noel Pouchet <Louis-Noel.pouchet@inria.fr>                           *
+ *                                                                            *
+ ******************************************************************************/
+
+/*
+ * This program checks that the read-only functions of the library may be
+ * called concurrently on a shared scop: several threads print, clone,
+ * compare and query the same scop and must obtain the results of a
+ * sequential run. It is intended to be run under ThreadSanitizer as well
+ * (e.g., CFLAGS="-fsanitize=thread -g"), which must not report any race.
+ * It also checks that the parallel printing, cloning and comparison of a
+ * scop give the results of the sequential ones, including when several
+ * threads call them at once.
+ * It scans the current directory for OpenScop files, or checks the file
+ * provided on the command line.
+ */
+
+#include <dirent.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <osl/osl.h>
+
+#define TEST_DIR        "."     // Directory to scan for OpenScop files
+#define TEST_SUFFIX     ".scop" // Suffix of OpenScop files
+#define TEST_THREADS    8       // Number of concurrent threads
+#define TEST_ITERATIONS 16      // Number of iterations per thread
+#define TEST_MANY_THREADS 100000000 // Number of threads beyond any limit
+
+static const char* const test_URIs[] = {
+    OSL_URI_ARRAYS,    OSL_URI_BODY,    OSL_URI_COORDINATES, OSL_URI_LOOP,
+    OSL_URI_SCATNAMES, OSL_URI_SYMBOLS, OSL_URI_EXTBODY,     "unknown"};
+
+/// Shared data of the threads checking one scop.
+struct test_shared {
+  osl_scop* scop;  // The scop shared by all threads.
+  char* printed;   // Its sequential printing.
+  size_t nb_names; // Its number of parameter, iterator and scattering names.
+  int integrity;   // Its integrity check result.
+};
+
+/// Print a scop into a freshly allocated string using nb_threads threads.
+static char* test_sprint(const osl_scop* scop, int nb_threads) {
+  FILE* file = tmpfile();
+  char* string;
+  long size;
+
+  if (file == NULL) {
+    fprintf(stderr, "Error: unable to create a temporary file\n");
+    exit(2);
+  }
+  osl_scop_print_parallel(file, scop, nb_threads);
+  size = ftell(file);
+  rewind(file);
+  string = malloc((size_t)size + 1);
+  if (fread(string, 1, (size_t)size, file) != (size_t)size) {
+    fprintf(stderr, "Error: unable to read a temporary file\n");
+    exit(2);
+  }
+  string[size] = '\0';
+  fclose(file);
+  return string;
+}
+
+/// Count the names of a scop.
+static size_t test_count_names(const osl_scop* scop) {
+  osl_names* names = osl_scop_names(scop);
+  size_t count = osl_strings_size(names->parameters) +
+                 osl_strings_size(names->iterators) +
+                 osl_strings_size(names->scatt_dims);
+
+  osl_names_free(names);
+  return count;
+}
+
+/// Check that the indexed lookups agree with the linear ones.
+static int test_lookups(osl_scop* scop) {
+  const size_t nb_URIs = sizeof(test_URIs) / sizeof(*test_URIs);
+  osl_statement* stmt;
+  size_t i;
+
+  for ( ; scop != NULL; scop = scop->next) {
+    for (i = 0; i < nb_URIs; i++) {
+      if (osl_scop_extension_lookup(scop, test_URIs[i]) !=
+          osl_generic_lookup(scop->extension, test_URIs[i]))
+        return 0;
+      for (stmt = scop->statement; stmt != NULL; stmt = stmt->next)
+        if (osl_statement_extension_lookup(stmt, test_URIs[i]) !=
+            osl_generic_lookup(stmt->extension, test_URIs[i]))
+          return 0;
+    }
+  }
+  return 1;
+}
+
+/// Check the parallel clone and comparison of a scop with nb_threads threads,
+/// including the detection of a difference in its last statement.
+static size_t test_clone_equal(const osl_scop* scop, int nb_threads) {
+  osl_scop* clone = osl_scop_clone_parallel(scop, nb_threads);
+  osl_statement* stmt;
+  size_t failures = 0;
+
+  failures += !osl_scop_equal(clone, scop);
+  failures += !osl_scop_equal_parallel(clone, scop, nb_threads);
+
+  stmt = clone != NULL ? clone->statement : NULL;
+  while (stmt != NULL && stmt->next != NULL)
+    stmt = stmt->next;
+  if (stmt != NULL && stmt->domain != NULL && stmt->domain->nb_rows > 0) {
+    osl_int_increment(stmt->domain->precision, &stmt->domain->m[0][0],
+                      stmt->domain->m[0][0]);
+    failures += osl_scop_equal_parallel(clone, scop, nb_threads);
+    failures += osl_scop_equal_parallel(scop, clone, nb_threads);
+  }
+
+  osl_scop_free(clone);
+  return failures;
+}
+
+/// Thread body: run the read-only functions and count the failures.
+static void* test_thread(void* data) {
+  struct test_shared* shared = data;
+  size_t* failures = calloc(1, sizeof(size_t));
+  int i;
+
+  for (i = 0; i < TEST_ITERATIONS; i++) {
+    char* printed = test_sprint(shared->scop, 1);
+    char* printed_parallel = test_sprint(shared->scop, TEST_THREADS);
+    osl_scop* clone = osl_scop_clone(shared->scop);
+    osl_scop* clone_parallel = osl_scop_clone_parallel(shared->scop, 0);
+    osl_scop* no_unions = osl_scop_remove_unions(shared->scop);
+
+    *failures += strcmp(printed, shared->printed) != 0;
+    *failures += strcmp(printed_parallel, shared->printed) != 0;
+    *failures += !osl_scop_equal(clone, shared->scop);
+    *failures += !osl_scop_equal_parallel(clone_parallel, shared->scop, 0);
+    *failures += !osl_scop_equal(shared->scop, shared->scop);
+    *failures += osl_scop_integrity_check(shared->scop) != shared->integrity;
+    *failures += test_count_names(shared->scop) != shared->nb_names;
+    *failures += !test_lookups(shared->scop);
+    *failures += osl_scop_number(no_unions) != osl_scop_number(shared->scop);
+
+    osl_scop_free(no_unions);
+    osl_scop_free(clone_parallel);
+    osl_scop_free(clone);
+    free(printed_parallel);
+    free(printed);
+  }
+
+  return failures;
+}
+
+/**
+ * test_file function
+ * This function reads an OpenScop file and checks that concurrent read-only
+ * uses of the resulting scop give the same results as a sequential use.
+ * \param input_name The name of the input file.
+ * \return 1 if the test is successful, 0 otherwise.
+ */
+static int test_file(const char* input_name) {
+  pthread_t threads[TEST_THREADS];
+  struct test_shared shared;
+  size_t failures = 0;
+  FILE* input_file;
+  int i;
+
+  printf("\nTesting file %s... \n", input_name);
+
+  input_file = fopen(input_name, "r");
+  if (input_file == NULL) {
+    fflush(stdout);
+    fprintf(stderr, "\nError: unable to open file %s\n", input_name);
+    exit(2);
+  }
+  shared.scop = osl_scop_read(input_file);
+  fclose(input_file);
+  shared.printed = test_sprint(shared.scop, 1);
+  shared.nb_names = test_count_names(shared.scop);
+  shared.integrity = osl_scop_integrity_check(shared.scop);
+
+  for (i = 0; i < TEST_THREADS; i++) {
+    if (pthread_create(&threads[i], NULL, test_thread, &shared)) {
+      fprintf(stderr, "\nError: unable to create a thread\n");
+      exit(2);
+    }
+  }
+  for (i = 0; i < TEST_THREADS; i++) {
+    void* result;
+    pthread_join(threads[i], &result);
+    failures += *(size_t*)result;
+    free(result);
+  }
+
+  // The shared scop must not have been modified.
+  char* printed = test_sprint(shared.scop, 1);
+  failures += strcmp(printed, shared.printed) != 0;
+  free(printed);
+
+  // The parallel printing must give the same text as the sequential one.
+  printed = test_sprint(shared.scop, TEST_THREADS);
+  failures += strcmp(printed, shared.printed) != 0;
+  free(printed);
+
+  // The same holds when asking for more threads than may be started.
+  printed = test_sprint(shared.scop, TEST_MANY_THREADS);
+  failures += strcmp(printed, shared.printed) != 0;
+  free(printed);
+
+  // The parallel clone and comparison must agree with the sequential ones.
+  failures += test_clone_equal(shared.scop, TEST_THREADS);
+  failures += test_clone_equal(shared.scop, TEST_MANY_THREADS);
+
+  if (failures)
+    printf("Failure :-( (%zu failed checks)\n", failures);
+  else
+    printf("Success :-)\n");
+
+  free(shared.printed);
+  osl_scop_free(shared.scop);
+  return failures == 0;
+}
+
+int main(int argc, char* argv[]) {
+  int total   = 0; // Total number of tests.
+  int success = 0; // Number of successes.
+  size_t suffix_length = strlen(TEST_SUFFIX);
+  DIR* dir;
+  struct dirent* dp;
+
+  if (argc > 2) {
+    fprintf(stderr, "usage: osl_threads [osl_file]\n");
+    exit(1);
+  }
+
+  if (argc == 2) {
+    success = test_file(argv[1]);
+    total++;
+  } else {
+    dir = opendir(TEST_DIR);
+    while ((dp = readdir(dir)) != NULL) {
+      size_t d_namlen = strlen(dp->d_name);
+      if ((d_namlen > suffix_length) &&
+          (!strcmp(dp->d_name + (d_namlen - suffix_length), TEST_SUFFIX))) {
+        success += test_file(dp->d_name);
+        total++;
+      }
+    }
+    closedir(dir);
+  }
+
+  printf("\n%d/%d file(s) successfully tested\n", success, total);
+  return (total - success) ? 1 : 0;
+}